@@ -41,6 +41,20 @@ enum {
 	disable = 0
 };
 
+enum dma_result {
+	nrf24_dma_started = 0,
+	nrf24_dma_empty   = 1,
+	nrf24_dma_error   = 2
+};
+
+/*
+ * One entry of a configuration table for "nrf24_apply_config"
+ */
+typedef struct {
+	uint8_t reg;
+	uint8_t val;
+} nrf24_reg_cfg_t;
+
 
 
 /*
@@ -61,6 +75,30 @@ void nrf24_defaults(void);
 void nrf24_init(void);
 
 
+/*
+ * Reload the RAM register shadow from the chip.
+ * Called by "nrf24_init", because MCU reset does not reset NRF24 module.
+ * Afterwards configuration functions write registers without reading them first
+ */
+void nrf24_shadow_sync(void);
+
+
+/*
+ * Forget the RAM register shadow without any SPI transaction.
+ * The next read-modify-write of each register reads the chip again.
+ * Use it when the module may have lost its registers on its own (supply brown-out)
+ */
+void nrf24_shadow_invalidate(void);
+
+
+/*
+ * Write a table of single byte registers.
+ * Entries whose value already matches the register shadow are skipped.
+ * Returns the number of registers actually written
+ */
+uint8_t nrf24_apply_config(const nrf24_reg_cfg_t *cfg, uint8_t count);
+
+
 //These functions are for controll CE and CSN pins which are selected in NRF24_conf.h
 void csn_high(void);
 void csn_low(void);
@@ -195,6 +233,13 @@ void nrf24_flush_rx(void);
 uint8_t nrf24_r_status(void);
 
 
+/*
+ * Return STATUS register value captured during the last SPI command.
+ * Every command byte shifts STATUS out, so this costs no extra SPI transaction
+ */
+uint8_t nrf24_last_status(void);
+
+
 /*
  * This function is for clear RX_DR bit in NRF24 STATUS register which sets
  * after receiving data in RX FIFO and it must be cleared by writing 1 which
@@ -334,6 +379,14 @@ void nrf24_transmit_no_ack(uint8_t *data, uint8_t size);
 void nrf24_transmit_rx_ack_pld(uint8_t pipe, uint8_t *data, uint8_t size);
 
 
+/*
+ * Same as "nrf24_transmit_rx_ack_pld" but the payload bytes are moved by SPI DMA.
+ * Returns nrf24_dma_started, then CSN stays low until "nrf24_dma_cplt" is called
+ * from HAL_SPI_TxCpltCallback. Returns nrf24_dma_error if the transfer could not start
+ */
+uint8_t nrf24_transmit_rx_ack_pld_dma(uint8_t pipe, uint8_t *data, uint8_t size);
+
+
 /*
  * Detect signal on selected channel above -64dbm
  */
@@ -347,9 +400,34 @@ uint8_t nrf24_data_available(void);
 
 
 /*
- * Receive data
+ * Receive data.
+ * Returns STATUS register value captured with R_RX_PAYLOAD command.
+ * If RX_P_NO field of it is RX_P_NO_EMPTY, RX FIFO was empty and "data" is left untouched.
+ * Otherwise one payload is read and RX_DR is cleared
+ */
+uint8_t nrf24_receive(uint8_t *data, uint8_t size);
+
+
+/*
+ * Start receiving one payload by SPI DMA.
+ * Command byte is sent in blocking mode so STATUS is captured (see "nrf24_last_status").
+ * Returns nrf24_dma_empty if RX FIFO was empty, nrf24_dma_error if DMA could not start,
+ * otherwise nrf24_dma_started: "data" must stay valid until HAL_SPI_RxCpltCallback,
+ * which has to call "nrf24_dma_cplt". RX_DR is not cleared here
+ */
+uint8_t nrf24_receive_dma(uint8_t *data, uint8_t size);
+
+
+/*
+ * Finish a DMA payload transfer (releases CSN). Call it from the SPI complete/error callbacks
+ */
+void nrf24_dma_cplt(void);
+
+
+/*
+ * Abort a DMA payload transfer which did not complete in time
  */
-void nrf24_receive(uint8_t *data, uint8_t size);
+void nrf24_dma_abort(void);
 
 
 #endif
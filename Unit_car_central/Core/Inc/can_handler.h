@@ -8,6 +8,9 @@
 #define INC_CAN_HANDLER_H_
 
 #include "main.h"
+#include "mailbox.h"
+
+#define CAN_DRIVE_STATUS_DEADLINE_MS 20 // 0x321 프레임의 최대 송신 대기 시간. 넘기면 오래된 상태로 보고 폐기
 
 /**
  * @brief CAN 수신 메시지 상세 설명
@@ -20,7 +23,7 @@
 
  /**
  * @brief CAN으로 수신된 패킷 데이터를 저장하기 위한 구조체
- * @note 콜백 함수에서 이 구조체에 데이터를 채워 메시지 큐로 전송한다.
+ * @note 콜백 함수에서 이 구조체에 데이터를 채워 메일박스(`g_canRxMailbox`)에 게시한다.
  */
 typedef struct {
     uint8_t distance_signal; ///< 거리 센서 신호 (RxData[0] 기반). 위험 시 1, 안전 시 0
@@ -32,6 +35,12 @@ extern CAN_FilterTypeDef sFilterConfig; // CAN 필터 설정 구조체
 extern CAN_RxHeaderTypeDef RxHeader;    // 수신된 CAN 메시지의 헤더 정보
 extern uint8_t RxData[8];               // 수신된 CAN 메시지의 데이터 페이로드
 
+/**
+ * @brief CAN 수신 ISR(생산자) → RFTask(소비자)로 최신 센서 데이터를 전달하는 메일박스
+ * @note 새 프레임은 읽히지 않은 이전 값을 덮어쓰므로 RFTask는 항상 가장 최근 값을 읽는다.
+ */
+extern Mailbox_t g_canRxMailbox;
+
 /**
  * @brief CAN 통신을 초기화하고 필터를 설정한다.
  */
@@ -40,10 +49,22 @@ void CANHandler_Init(void);
 /**
  * @brief CAN 수신 필터를 설정한다.
  * @param hcan_ptr CAN 핸들러 포인터
- * @note ID 0x6A5만 수신하도록 필터를 구성한다.
+ * @note ID 0x6A5(FIFO1)와 비상 프레임 0x010(FIFO0)만 수신하도록 필터를 구성한다.
  */
 void CAN_Filter_Config(CAN_HandleTypeDef *hcan_ptr);
 
+/**
+ * @brief CAN RX0 인터럽트에서 FIFO0(비상 프레임)만 처리한다.
+ * @param hcan CAN 핸들러 포인터
+ */
+void CAN_Rx0_IRQHandler(CAN_HandleTypeDef *hcan);
+
+/**
+ * @brief CAN FIFO0 메시지 수신 보류 콜백 함수 (비상 프레임)
+ * @param hcan CAN 핸들러 포인터
+ */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+
 /**
  * @brief CAN FIFO1 메시지 수신 보류 콜백 함수
  * @param hcan CAN 핸들러 포인터
@@ -0,0 +1,78 @@
+/**
+ * @file can_tx.h
+ * @brief bxCAN 송신 메일박스 관리를 위한 우선순위 큐 기반 CAN 송신 스케줄러를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL_CAN_AddTxMessage()는 하드웨어 송신 메일박스 3개가 모두 사용 중이면 실패하고,
+ * 반환값을 확인하지 않으면 프레임이 조용히 사라진다. 이 모듈은 CAN ID 순(낮은 ID = 높은 우선순위)으로
+ * 정렬된 소프트웨어 큐에 프레임을 보관하고, 송신 완료 인터럽트에서 빈 메일박스를 다시 채운다.
+ * CAN을 송신하는 차량부 ECU(car_central, car_sensor)가 동일한 파일을 사용한다.
+ */
+
+#ifndef INC_CAN_TX_H_
+#define INC_CAN_TX_H_
+
+#include "main.h"
+
+#define CAN_TX_QUEUE_SIZE   8  // 소프트웨어 송신 큐 깊이
+#define CAN_TX_MAX_IDS      8  // ID별 통계를 기록할 최대 ID 수
+
+/**
+ * @brief CanTx_Send()의 결과
+ */
+typedef enum {
+    CAN_TX_QUEUED = 0,   // 큐에 새로 추가됨 (또는 즉시 하드웨어 메일박스에 적재됨)
+    CAN_TX_REPLACED,     // 같은 ID의 미송신 프레임을 최신 데이터로 교체함
+    CAN_TX_DROPPED       // 큐가 가득 차고 새 프레임의 우선순위가 가장 낮아 버려짐
+} CanTxResult_t;
+
+/**
+ * @brief CAN ID별 송신 통계
+ * @note age는 처음 CanTx_Send() 호출부터 하드웨어 메일박스 적재까지의 대기 시간이다. (교체되어도 유지)
+ */
+typedef struct {
+    uint16_t std_id;        // 표준 ID (0: 미사용 슬롯)
+    uint32_t sent_count;    // 하드웨어 메일박스에 적재된 횟수
+    uint32_t replaced_count;// 송신 전에 최신 데이터로 교체된 횟수
+    uint32_t dropped_count; // 큐 포화로 버려진 횟수
+    uint32_t expired_count; // 마감 시간(deadline)을 넘겨 폐기된 횟수
+    uint32_t last_age_us;   // 마지막 송신 프레임의 대기 시간 (µs)
+    uint32_t max_age_us;    // 최대 대기 시간 (µs)
+} CanTxIdStats_t;
+
+/**
+ * @brief CAN 송신 스케줄러 전체 통계
+ */
+typedef struct {
+    uint32_t queued_count;   // CanTx_Send() 호출 횟수
+    uint32_t sent_count;     // 하드웨어 메일박스 적재 횟수
+    uint32_t dropped_count;  // 큐 포화로 버려진 프레임 수
+    uint32_t expired_count;  // 마감 시간 초과로 폐기된 프레임 수
+    uint32_t hal_error_count;// HAL_CAN_AddTxMessage 실패 횟수
+    uint32_t bus_error_count;// 중재 패배/송신 오류 후 성공 없이 끝난 송신 요청 수 (자동 재전송 중의 재시도는 세지 않음)
+    uint8_t  depth;          // 현재 큐 깊이
+    uint8_t  high_water;     // 큐 깊이 최대값 (high-water mark)
+    CanTxIdStats_t id_stats[CAN_TX_MAX_IDS];
+} CanTxStats_t;
+
+extern volatile CanTxStats_t g_canTxStats;
+
+/**
+ * @brief CAN 송신 스케줄러를 초기화하고 송신 메일박스 비움 인터럽트를 활성화한다.
+ * @param hcan CAN 핸들 포인터 (HAL_CAN_Start 이후 호출)
+ */
+void CanTx_Init(CAN_HandleTypeDef *hcan);
+
+/**
+ * @brief 표준 ID 데이터 프레임을 송신 큐에 넣는다.
+ * @param std_id 표준 ID (11비트). 값이 낮을수록 먼저 송신된다.
+ * @param data 데이터 (dlc 바이트)
+ * @param dlc 데이터 길이 (0~8)
+ * @param deadline_ms 데이터가 큐에서 대기할 수 있는 최대 시간 (ms). 넘기면 송신하지 않고 폐기한다. 0이면 무제한.
+ * 같은 ID로 교체되면 새 데이터 기준으로 다시 잰다.
+ * @retval CanTxResult_t
+ * @note 태스크/ISR 어디서든 호출할 수 있다. 같은 ID의 미송신 프레임이 있으면 데이터만 교체한다.
+ */
+CanTxResult_t CanTx_Send(uint16_t std_id, const uint8_t *data, uint8_t dlc, uint16_t deadline_ms);
+
+#endif /* INC_CAN_TX_H_ */
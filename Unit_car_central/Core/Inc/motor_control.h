@@ -10,6 +10,21 @@
 
 #include "main.h"
 #include "rf_handler.h" // VehicleCommand_t 구조체를 사용하기 위해 포함
+#include "motor_ramp.h" // 듀티 램프와 듀티 상수 (HAL 비의존)
+#include "speed_pid.h"  // 속도 제어 피드포워드 + PID (HAL 비의존)
+
+#define MOTOR_LOOP_PERIOD_MS  1      // MotorTask 제어 주기 (1kHz)
+#define MOTOR_CMD_TIMEOUT_MS  250    // 이 시간 동안 새 명령이 없으면 입력 없음(관성 감속)으로 처리
+#define MOTOR_EMERGENCY_HOLD_MS 100  // 비상 프레임(0x010)이 이 시간 동안 없으면 정지 요청을 해제 (송신 측 반복 주기 20ms)
+
+// --- DC 모터 제어 방식 ---
+#define MOTOR_MODE_OPEN_LOOP  0 // 가속 입력 → 듀티 직접 매핑 (기존 방식)
+#define MOTOR_MODE_SPEED      1 // 가속 입력 → 목표 RPM, 센서 ECU의 엔코더 RPM(CAN 0x6A5)으로 PID 폐루프 제어
+
+// SPEED_* 게인(speed_pid.h)은 호스트 플랜트 시뮬레이션으로만 고른 값이므로, 차량 실측 튜닝이 끝날 때까지 기본값은 개루프로 둔다.
+#ifndef MOTOR_CONTROL_MODE
+#define MOTOR_CONTROL_MODE MOTOR_MODE_OPEN_LOOP
+#endif
 
 /**
  * @brief 모터의 회전 방향을 나타내는 열거형
@@ -26,11 +41,25 @@ typedef enum {
 void MotorControl_Init(void);
 
 /**
- * @brief 수신된 주행 명령에 따라 모든 모터의 상태를 업데이트한다.
- * @param command CommHandler로부터 받은 주행 명령 구조체의 포인터
+ * @brief 최신 주행 명령을 MotorTask가 읽을 메일박스에 게시한다.
+ * @param command RFHandler로부터 받은 주행 명령 구조체의 포인터
+ * @note 최신값 메일박스(mailbox.h)를 사용하므로 호출 태스크의 우선순위와 무관하게 안전하다.
+ */
+void MotorControl_SetCommand(const VehicleCommand_t* command);
+
+/**
+ * @brief 고정 주기 모터 제어 루프 한 스텝을 수행한다.
+ * @param now_us 현재 시각 (µs)
  * @note 이 함수는 내부적으로 서보, DC모터, 방향 제어 함수를 모두 호출한다.
  */
-void MotorControl_Update(const VehicleCommand_t* command);
+void MotorControl_Tick(uint32_t now_us);
+
+/**
+ * @brief 센서 ECU가 보낸 최신 측정 RPM을 속도 제어 루프에 전달한다.
+ * @param rpm 엔코더 기반 모터 RPM (부호 없음)
+ * @note CAN 수신 ISR에서 호출한다.
+ */
+void MotorControl_SetMeasuredRpm(uint16_t rpm);
 
 /**
  * @brief 서보 모터의 각도를 제어한다.
@@ -42,9 +71,27 @@ void Control_Servo(float roll);
  * @brief DC 모터의 속도를 제어한다.
  * @param accel_ms 가속 버튼이 눌린 시간 (ms)
  * @param brake_ms 브레이크 버튼이 눌린 시간 (ms)
+ * @param dt_us 직전 호출 이후 경과 시간 (µs)
  * @note 가속, 브레이크, 관성 주행 로직을 포함한다.
  */
-void Control_DcMotor(uint16_t accel_ms, uint16_t brake_ms);
+void Control_DcMotor(uint16_t accel_ms, uint16_t brake_ms, uint32_t dt_us);
+
+/**
+ * @brief DC 모터의 속도를 목표 RPM 기반 폐루프로 제어한다. (MOTOR_MODE_SPEED)
+ * @param accel_ms 가속 버튼이 눌린 시간 (ms) → 목표 RPM으로 변환
+ * @param brake_ms 브레이크 버튼이 눌린 시간 (ms)
+ * @param dt_us 직전 호출 이후 경과 시간 (µs)
+ * @param now_us 현재 시각 (µs), RPM 측정값의 신선도 판단용
+ */
+void Control_DcMotorSpeed(uint16_t accel_ms, uint16_t brake_ms, uint32_t dt_us, uint32_t now_us);
+
+/**
+ * @brief 센서 ECU의 비상 정지 요청을 반영한다. (CAN 수신 ISR 전용)
+ * @param stop_front 전방 충돌 위험 → 전진 구동 차단
+ * @param stop_rear 후방 충돌 위험 → 후진 구동 차단
+ * @note 현재 방향이 차단 대상이면 MotorTask를 기다리지 않고 ISR 안에서 TIM1 CH4 듀티를 0으로 만든다.
+ */
+void MotorControl_EmergencyStop(uint8_t stop_front, uint8_t stop_rear);
 
 /**
  * @brief DC 모터의 회전 방향을 업데이트한다.
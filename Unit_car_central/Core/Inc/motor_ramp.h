@@ -0,0 +1,37 @@
+/**
+ * @file motor_ramp.h
+ * @brief 가속/브레이크/관성 입력에 따른 DC 모터 듀티 램프를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않는 순수 함수만 모아 두어 호스트에서 가상 시계로 그대로 검증할 수 있다.
+ * 감속량은 호출 횟수가 아닌 경과 시간(dt)에 비례하므로, 호출 주기(1kHz, 100Hz, 지터)와 무관하게 차량 거동이 같다.
+ */
+
+#ifndef INC_MOTOR_RAMP_H_
+#define INC_MOTOR_RAMP_H_
+
+#include <stdint.h>
+
+#define MOTOR_DT_MAX_US     20000   // 한 주기에 반영할 최대 경과 시간 (디버거 정지 등 비정상 dt 제한)
+
+#define MAX_DUTY            1000    // PWM 최대 듀티 값 (htim1의 ARR 값에 맞춰 설정한다)
+#define MIN_DUTY_ON_ACCEL   400     // 가속 시작 시 최소 듀티 (모터가 실제로 회전하기 시작하는 최소 PWM 값)
+#define ACCEL_SENSITIVITY_PERMILLE 800 // 가속 민감도(x1000). 값이 클수록 가속 버튼 유지 시간에 비해 속도가 빠르게 증가한다
+#define COAST_RATE_PER_S    600     // 관성 주행 시 초당 듀티 감소량 (기존 5ms 패킷당 3 감소와 동일)
+#define BRAKE_RATE_PER_S    100000  // 브레이크 시 초당 듀티 감소량 (기존 5ms 패킷당 500 감소와 동일)
+
+// 램프 계산용 듀티 분해능. 내부 듀티는 1/1000 단위(milli-duty)로 누적하여
+// 1ms 주기에서도 초당 수백 단위의 완만한 감소가 절삭되지 않도록 한다.
+#define DUTY_SCALE          1000
+
+/**
+ * @brief DC 모터 듀티 램프를 경과 시간만큼 진행한다.
+ * @param duty_m 현재 듀티 (milli-duty, 0 ~ MAX_DUTY*DUTY_SCALE)
+ * @param accel_ms 가속 버튼이 눌린 시간 (ms)
+ * @param brake_ms 브레이크 버튼이 눌린 시간 (ms)
+ * @param dt_us 경과 시간 (µs). MOTOR_DT_MAX_US보다 길면 MOTOR_DT_MAX_US로 제한한다
+ * @retval 갱신된 듀티 (milli-duty)
+ */
+int32_t DcMotor_RampStep(int32_t duty_m, uint16_t accel_ms, uint16_t brake_ms, uint32_t dt_us);
+
+#endif /* INC_MOTOR_RAMP_H_ */
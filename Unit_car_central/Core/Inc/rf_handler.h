@@ -10,6 +10,32 @@
 #include "main.h"
 #include <stdbool.h>
 
+// --- SPI 페이로드 전송 방식 ---
+// 1: 페이로드 바이트를 SPI1 DMA(RX: DMA1_Channel2, TX: DMA1_Channel3)로 전송하고, 완료까지 RFTask는 블로킹(CPU 양보)된다.
+// 0: 기존 블로킹 HAL_SPI_Transmit/Receive 사용
+#ifndef RF_SPI_USE_DMA
+#define RF_SPI_USE_DMA 1
+#endif
+
+#define RF_FLAG_SPI_DMA       0x0001U // RFTask 스레드 플래그: SPI DMA 전송 완료
+#define RF_FLAG_SPI_ERROR     0x0002U // RFTask 스레드 플래그: SPI DMA 전송 오류
+#define RF_SPI_DMA_TIMEOUT_MS 2       // 9바이트 전송(4.5Mbit/s 기준 약 16us)에 대한 여유 있는 상한
+
+/**
+ * @brief SPI DMA 페이로드 전송 통계
+ * @note last_cycles/max_cycles는 DMA 시작부터 완료 콜백까지의 DWT 사이클 수(72MHz)다.
+ * SPI 클럭 여유(prescaler 16 → 4.5Mbit/s, nRF24 최대 10Mbit/s)를 판단하는 데 사용한다.
+ */
+typedef struct {
+    uint32_t transfer_count; // 완료된 DMA 전송 횟수
+    uint32_t error_count;    // 시작 실패 또는 SPI 오류 횟수
+    uint32_t timeout_count;  // 완료 콜백이 오지 않아 중단한 횟수
+    uint32_t last_cycles;    // 마지막 전송 소요 사이클
+    uint32_t max_cycles;     // 최대 전송 소요 사이클
+} RFDmaStats_t;
+
+extern volatile RFDmaStats_t g_rfDmaStats;
+
 /**
  * @brief 조종기로부터 수신된 주행 명령 데이터를 담는 구조체
  */
@@ -33,6 +59,17 @@ void RFHandler_Init(void);
  */
 void RFHandler_IrqCallback(void);
 
+/**
+ * @brief SPI1 DMA 전송 완료 콜백 (ISR 컨텍스트)
+ * @note HAL_SPI_RxCpltCallback / HAL_SPI_TxCpltCallback에서 호출되며, CSN을 해제하고 RFTask를 깨운다.
+ */
+void RFHandler_SpiDmaCpltCallback(void);
+
+/**
+ * @brief SPI1 오류 콜백 (ISR 컨텍스트)
+ */
+void RFHandler_SpiDmaErrorCallback(void);
+
 /**
  * @brief 다음에 전송할 ACK 페이로드 데이터를 설정한다.
  * @note 이 함수를 통해 설정된 데이터는 다음 수신 성공 시 조종기 측으로 자동 전송된다.
@@ -0,0 +1,103 @@
+/**
+ * @file speed_pid.h
+ * @brief 목표 RPM 기반 DC 모터 속도 제어(피드포워드 + PID)를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않는 순수 함수만 모아 두어 호스트에서 DC 모터 플랜트 시뮬레이션으로 검증할 수 있다.
+ * 측정 RPM은 센서 ECU의 송신 정책(can_publish.h)에 따라 20~50ms 간격으로 불규칙하게 들어오므로,
+ * PID는 새 측정이 들어왔을 때만 실제 측정 간격(dt)으로 갱신하고 그 사이에는 듀티를 유지한다.
+ */
+
+#ifndef INC_SPEED_PID_H_
+#define INC_SPEED_PID_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "motor_ramp.h" // MAX_DUTY, MIN_DUTY_ON_ACCEL, DUTY_SCALE, DcMotor_RampStep
+
+// --- 속도 제어(PID) 파라미터 ---
+// 게인은 milli-duty 단위 정수다. (예: SPEED_KP_MILLI 2000 → RPM 오차 1당 듀티 2)
+// KP/KI/I_BAND는 호스트 플랜트 시뮬레이션(host_tests/test_speed_pid.c)으로 고른 값이며, 차량 실측으로 다시 확인한다.
+#define MOTOR_MAX_RPM         300    // 최대 듀티(MAX_DUTY)에서의 무부하 RPM (피드포워드 모델, 실측 보정 대상)
+#define SPEED_KP_MILLI        4000   // 비례 게인 (milli-duty / RPM)
+#define SPEED_KI_MILLI        24000  // 적분 게인 (milli-duty / (RPM·s))
+#define SPEED_KD_MILLI        0      // 미분 게인 (milli-duty / (RPM/s)), 측정값 미분. 엔코더 노이즈와 20~50ms 측정 간격으로 기본 0
+#define SPEED_I_LIMIT_MILLI   300000 // 적분항 절대값 상한 (듀티 300)
+#define SPEED_I_BAND_RPM      30     // |오차|가 이보다 크면 적분하지 않는다 (계단 변화 중 적분이 쌓여 오버슈트/언더슈트가 커지는 것 방지)
+#define SPEED_RPM_TIMEOUT_MS  100    // 이 시간 동안 RPM 수신이 없으면 피드포워드만으로 구동 (센서 회전 중 하트비트 50ms의 2배)
+#define SPEED_COAST_RPM_PER_S 300    // 입력 없을 때 목표 RPM 감소율 (개루프 COAST_RATE_PER_S와 동일한 감속감)
+
+/**
+ * @brief 고정소수점 PID 속도 제어기 상태
+ */
+typedef struct {
+    int32_t integral_m;  // 적분항 (milli-duty)
+    int32_t prev_rpm;    // 직전 측정 RPM (미분항 계산용)
+} SpeedPid_t;
+
+/**
+ * @brief 속도 제어 루프 상태 (목표 RPM, 측정값 신선도, PID)
+ */
+typedef struct {
+    SpeedPid_t pid;
+    int32_t  target_rpm_m;  // 목표 RPM (x1000)
+    int32_t  meas_rpm;      // 최신 측정 RPM
+    bool     has_meas;      // 측정값 수신 여부
+    uint32_t meas_time_us;  // 마지막 RPM 수신 시각 (루프 호출 기준, 1주기 이내 오차)
+    uint32_t last_meas_us;  // 직전 PID 갱신에 쓴 측정 시각
+} SpeedPidLoop_t;
+
+/**
+ * @brief 목표 RPM에 대한 피드포워드 듀티를 계산한다. (개루프 MIN_DUTY_ON_ACCEL 모델)
+ * @param target_rpm 목표 RPM
+ * @retval 피드포워드 듀티 (milli-duty)
+ */
+int32_t SpeedPid_FeedForward(int32_t target_rpm);
+
+/**
+ * @brief 가속 버튼 유지 시간을 목표 RPM으로 변환한다.
+ * @param accel_ms 가속 버튼이 눌린 시간 (ms)
+ * @retval 목표 RPM (x1000, 0 ~ MOTOR_MAX_RPM*1000)
+ * @note 개루프 목표 듀티(MIN_DUTY_ON_ACCEL + accel x 감도)를 피드포워드 모델로 역산하므로, 무부하에서는 개루프와 같은 속도가 된다.
+ */
+int32_t SpeedPid_TargetFromAccel(uint16_t accel_ms);
+
+/**
+ * @brief PID 속도 제어를 한 스텝 수행한다.
+ * @param pid 제어기 상태
+ * @param target_rpm 목표 RPM
+ * @param meas_rpm 측정 RPM
+ * @param dt_us 직전 측정 이후 경과 시간 (µs)
+ * @retval 출력 듀티 (milli-duty, 0 ~ MAX_DUTY*DUTY_SCALE)
+ * @note 출력이 포화된 방향으로는 적분하지 않는 조건부 적분으로 와인드업을 막고,
+ * 오차가 SPEED_I_BAND_RPM보다 큰 과도 구간에서는 적분하지 않는다.
+ */
+int32_t SpeedPid_Step(SpeedPid_t *pid, int32_t target_rpm, int32_t meas_rpm, uint32_t dt_us);
+
+/**
+ * @brief PID 상태(적분항)를 초기화한다.
+ */
+void SpeedPid_Reset(SpeedPid_t *pid, int32_t meas_rpm);
+
+/**
+ * @brief 속도 제어 루프 상태를 초기화한다.
+ */
+void SpeedPid_LoopInit(SpeedPidLoop_t *loop);
+
+/**
+ * @brief 속도 제어 루프를 한 주기 진행한다.
+ * @param loop 루프 상태
+ * @param duty_m 현재 듀티 (milli-duty)
+ * @param accel_ms 가속 버튼이 눌린 시간 (ms) → 목표 RPM으로 변환
+ * @param brake_ms 브레이크 버튼이 눌린 시간 (ms)
+ * @param blocked 현재 방향이 비상 정지로 차단되어 있는지
+ * @param new_meas 이번 주기에 새 RPM 측정값이 들어왔는지
+ * @param meas_rpm 새 측정 RPM (new_meas일 때만 사용)
+ * @param dt_us 직전 호출 이후 경과 시간 (µs)
+ * @param now_us 현재 시각 (µs), RPM 측정값의 신선도 판단용
+ * @retval 갱신된 듀티 (milli-duty)
+ */
+int32_t SpeedPid_LoopStep(SpeedPidLoop_t *loop, int32_t duty_m, uint16_t accel_ms, uint16_t brake_ms, bool blocked,
+                          bool new_meas, uint16_t meas_rpm, uint32_t dt_us, uint32_t now_us);
+
+#endif /* INC_SPEED_PID_H_ */
@@ -11,6 +11,55 @@
 
 extern SPI_HandleTypeDef hspiX;
 
+/*
+ * STATUS register value shifted out by the chip during the last command byte.
+ * Every SPI command returns it for free, so no separate NOP read is needed.
+ */
+static uint8_t nrf24_status = 0;
+
+/*
+ * RAM shadow of the nRF24 register file (CONFIG .. FEATURE).
+ * Read-modify-write helpers take the current value from here, so configuration
+ * calls become write-only. Bit n of nrf24_shadow_valid is set when nrf24_shadow[n]
+ * matches register n. Registers changed by the chip itself are never cached.
+ */
+#define NRF24_SHADOW_SIZE (FEATURE + 1)
+
+static uint8_t nrf24_shadow[NRF24_SHADOW_SIZE];
+static uint32_t nrf24_shadow_valid = 0;
+
+static uint8_t nrf24_shadow_cacheable(uint8_t reg){
+	if(reg >= NRF24_SHADOW_SIZE){
+		return 0;
+	}
+
+	switch(reg){
+	case STATUS:
+	case OBSERVE_TX:
+	case RPD:
+	case FIFO_STATUS:
+	case RX_ADDR_P0:
+	case RX_ADDR_P1:
+	case TX_ADDR:
+		return 0;
+	}
+
+	return 1;
+}
+
+static uint8_t nrf24_shadow_r(uint8_t reg){
+	if(!nrf24_shadow_cacheable(reg)){
+		return nrf24_r_reg(reg, 1);
+	}
+
+	if(!(nrf24_shadow_valid & (1UL << reg))){
+		nrf24_shadow[reg] = nrf24_r_reg(reg, 1);
+		nrf24_shadow_valid |= (1UL << reg);
+	}
+
+	return nrf24_shadow[reg];
+}
+
 
 void csn_high(void){
 	HAL_GPIO_WritePin(csn_gpio_port, csn_gpio_pin, 1);
@@ -34,28 +83,36 @@ void nrf24_w_reg(uint8_t reg, uint8_t *data, uint8_t size){
 
 	csn_low();
 
-	HAL_SPI_Transmit(&hspiX, &cmd, 1, spi_w_timeout);
+	nrf24_w_spec_cmd(cmd);
 	HAL_SPI_Transmit(&hspiX, data, size, spi_w_timeout);
 
 	csn_high();
+
+	if(size == 1 && nrf24_shadow_cacheable(reg)){
+		nrf24_shadow[reg] = *data;
+		nrf24_shadow_valid |= (1UL << reg);
+	}
 }
 
 uint8_t nrf24_r_reg(uint8_t reg, uint8_t size){
-	uint8_t cmd = R_REGISTER | reg;
-	uint8_t data = 0;
+	uint8_t tx[2] = { R_REGISTER | reg, NOP_CMD };
+	uint8_t rx[2] = { 0 };
+
+	(void)size; //single byte registers only, multi byte registers are write-only here
 
 	csn_low();
 
-	HAL_SPI_Transmit(&hspiX, &cmd, 1, spi_w_timeout);
-	HAL_SPI_Receive(&hspiX, &data, size, spi_r_timeout);
+	HAL_SPI_TransmitReceive(&hspiX, tx, rx, 2, spi_rw_timeout);
 
 	csn_high();
 
-	return data;
+	nrf24_status = rx[0];
+
+	return rx[1];
 }
 
 void nrf24_w_spec_cmd(uint8_t cmd){
-	HAL_SPI_Transmit(&hspiX, &cmd, 1, spi_w_timeout);
+	HAL_SPI_TransmitReceive(&hspiX, &cmd, &nrf24_status, 1, spi_rw_timeout);
 }
 
 void nrf24_w_spec_reg(uint8_t *data, uint8_t size){
@@ -69,7 +126,7 @@ void nrf24_r_spec_reg(uint8_t *data, uint8_t size){
 void nrf24_pwr_up(void){
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(CONFIG, 1);
+	data = nrf24_shadow_r(CONFIG);
 
 	data |= (1 << PWR_UP);
 
@@ -79,7 +136,7 @@ void nrf24_pwr_up(void){
 void nrf24_pwr_dwn(void){
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(CONFIG, 1);
+	data = nrf24_shadow_r(CONFIG);
 
 	data &= ~(1 << PWR_UP);
 
@@ -89,7 +146,7 @@ void nrf24_pwr_dwn(void){
 void nrf24_tx_pwr(uint8_t pwr){
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(RF_SETUP, 1);
+	data = nrf24_shadow_r(RF_SETUP);
 
 	data &= 184;
 
@@ -101,7 +158,7 @@ void nrf24_tx_pwr(uint8_t pwr){
 void nrf24_data_rate(uint8_t bps){
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(RF_SETUP, 1);
+	data = nrf24_shadow_r(RF_SETUP);
 
 	data &= ~(1 << RF_DR_LOW) & ~(1 << RF_DR_HIGH);
 
@@ -159,7 +216,7 @@ void nrf24_open_rx_pipe(uint8_t pipe, uint8_t *addr){
 
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(EN_RXADDR, 1);
+	data = nrf24_shadow_r(EN_RXADDR);
 
 	switch(pipe){
 	case 0:
@@ -198,7 +255,7 @@ void nrf24_open_rx_pipe(uint8_t pipe, uint8_t *addr){
 }
 
 void nrf24_cls_rx_pipe(uint8_t pipe){
-	uint8_t data = nrf24_r_reg(EN_RXADDR, 1);
+	uint8_t data = nrf24_shadow_r(EN_RXADDR);
 
 	data &= ~(1 << pipe);
 
@@ -206,7 +263,7 @@ void nrf24_cls_rx_pipe(uint8_t pipe){
 }
 
 void nrf24_set_crc(uint8_t en_crc, uint8_t crc0){
-	uint8_t data = nrf24_r_reg(CONFIG, 1);
+	uint8_t data = nrf24_shadow_r(CONFIG);
 
 	data &= ~(1 << EN_CRC) & ~(1 << CRCO);
 
@@ -233,44 +290,33 @@ void nrf24_flush_rx(void){
 }
 
 uint8_t nrf24_r_status(void){
-	uint8_t data = 0;
-	uint8_t cmd = NOP_CMD;
-
 	csn_low();
-	HAL_SPI_TransmitReceive(&hspiX, &cmd, &data, 1, spi_rw_timeout);
+	nrf24_w_spec_cmd(NOP_CMD);
 	csn_high();
 
-	return data;
+	return nrf24_status;
 }
 
-void nrf24_clear_rx_dr(void){
-	uint8_t data = 0;
-
-	data = nrf24_r_status();
+uint8_t nrf24_last_status(void){
+	return nrf24_status;
+}
 
-	data |= (1 << RX_DR);
+void nrf24_clear_rx_dr(void){
+	uint8_t data = (1 << RX_DR);
 
 	nrf24_w_reg(STATUS, &data, 1);
 }
 
 void nrf24_clear_tx_ds(void){
-	uint8_t data = 0;
-
-	data = nrf24_r_status();
+	uint8_t data = (1 << TX_DS);
 
-	data |= (1 << TX_DS);
-
-    nrf24_w_reg(STATUS, &data, 1);
+	nrf24_w_reg(STATUS, &data, 1);
 }
 
 void nrf24_clear_max_rt(void){
-	uint8_t data = 0;
+	uint8_t data = (1 << MAX_RT);
 
-	data = nrf24_r_status();
-
-	data |= (1 << MAX_RT);
-
-    nrf24_w_reg(STATUS, &data, 1);
+	nrf24_w_reg(STATUS, &data, 1);
 }
 
 uint8_t nrf24_read_bit(uint8_t reg, uint8_t bit){
@@ -285,7 +331,7 @@ uint8_t nrf24_read_bit(uint8_t reg, uint8_t bit){
 void nrf24_set_bit(uint8_t reg, uint8_t bit, uint8_t val){
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(reg, 1);
+	data = nrf24_shadow_r(reg);
 
 	if(val){
 		data |= (1 << bit);
@@ -310,7 +356,7 @@ uint8_t nrf24_r_pld_wid(void){
 void nrf24_listen(void){
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(CONFIG, 1);
+	data = nrf24_shadow_r(CONFIG);
 
 	data |= (1 << PRIM_RX);
 
@@ -322,7 +368,7 @@ void nrf24_listen(void){
 void nrf24_stop_listen(void){
 	uint8_t data = 0;
 
-	data = nrf24_r_reg(CONFIG, 1);
+	data = nrf24_shadow_r(CONFIG);
 
 	data &= ~(1 << PRIM_RX);
 
@@ -330,7 +376,7 @@ void nrf24_stop_listen(void){
 }
 
 void nrf24_dpl(uint8_t en){
-	uint8_t feature = nrf24_r_reg(FEATURE, 1);
+	uint8_t feature = nrf24_shadow_r(FEATURE);
 
 	if(en == enable){
 		feature |= (1 << EN_DPL);
@@ -343,7 +389,7 @@ void nrf24_dpl(uint8_t en){
 
 void nrf24_set_rx_dpl(uint8_t pipe, uint8_t en){
 
-	uint8_t dynpd = nrf24_r_reg(DYNPD, 1);
+	uint8_t dynpd = nrf24_shadow_r(DYNPD);
 
 	if(pipe > 5){
 		pipe = 5;
@@ -364,7 +410,7 @@ void nrf24_auto_ack(uint8_t pipe, uint8_t ack){
 		pipe = 5;
 	}
 
-	uint8_t enaa = nrf24_r_reg(EN_AA, 1);
+	uint8_t enaa = nrf24_shadow_r(EN_AA);
 
 	if(ack){
 		enaa |= (1 << pipe);
@@ -376,7 +422,7 @@ void nrf24_auto_ack(uint8_t pipe, uint8_t ack){
 }
 
 void nrf24_auto_ack_all(uint8_t ack){
-	uint8_t enaa = nrf24_r_reg(EN_AA, 1);
+	uint8_t enaa = 0;
 
 	if(ack){
 		enaa = 63;
@@ -388,7 +434,7 @@ void nrf24_auto_ack_all(uint8_t ack){
 }
 
 void nrf24_en_ack_pld(uint8_t en){
-	uint8_t feature = nrf24_r_reg(FEATURE, 1);
+	uint8_t feature = nrf24_shadow_r(FEATURE);
 
 	if(en){
 		feature |= (1 << EN_ACK_PAY);
@@ -400,7 +446,7 @@ void nrf24_en_ack_pld(uint8_t en){
 }
 
 void nrf24_en_dyn_ack(uint8_t en){
-	uint8_t feature = nrf24_r_reg(FEATURE, 1);
+	uint8_t feature = nrf24_shadow_r(FEATURE);
 
 	if(en){
 		feature |= (1 << EN_DYN_ACK);
@@ -412,7 +458,7 @@ void nrf24_en_dyn_ack(uint8_t en){
 }
 
 void nrf24_auto_retr_delay(uint8_t delay){
-	uint8_t data = nrf24_r_reg(SETUP_RETR, 1);
+	uint8_t data = nrf24_shadow_r(SETUP_RETR);
 
 	data &= 15;
 
@@ -422,7 +468,7 @@ void nrf24_auto_retr_delay(uint8_t delay){
 }
 
 void nrf24_auto_retr_limit(uint8_t limit){
-	uint8_t data = nrf24_r_reg(SETUP_RETR, 1);
+	uint8_t data = nrf24_shadow_r(SETUP_RETR);
 
 	data &= 240;
 
@@ -455,7 +501,7 @@ uint8_t nrf24_transmit(uint8_t *data, uint8_t size){
 	uint8_t cmd = W_TX_PAYLOAD;
 
 	csn_low();
-	HAL_SPI_Transmit(&hspiX, &cmd, 1, spi_w_timeout);
+	nrf24_w_spec_cmd(cmd);
 	HAL_SPI_Transmit(&hspiX, data, size, spi_w_timeout);
 	csn_high();
 
@@ -479,7 +525,7 @@ void nrf24_transmit_no_ack(uint8_t *data, uint8_t size){
 	uint8_t cmd = W_TX_PAYLOAD_NOACK;
 
 	csn_low();
-	HAL_SPI_Transmit(&hspiX, &cmd, 1, spi_w_timeout);
+	nrf24_w_spec_cmd(cmd);
 	HAL_SPI_Transmit(&hspiX, data, size, spi_w_timeout);
 	csn_high();
 
@@ -497,12 +543,31 @@ void nrf24_transmit_rx_ack_pld(uint8_t pipe, uint8_t *data, uint8_t size){
 	uint8_t cmd = (W_ACK_PAYLOAD | pipe);
 
 	csn_low();
-	HAL_SPI_Transmit(&hspiX, &cmd, 1, spi_w_timeout);
+	nrf24_w_spec_cmd(cmd);
 	HAL_SPI_Transmit(&hspiX, data, size, spi_w_timeout);
 	csn_high();
 
 }
 
+uint8_t nrf24_transmit_rx_ack_pld_dma(uint8_t pipe, uint8_t *data, uint8_t size){
+
+	if(pipe > 5){
+		pipe = 5;
+	}
+
+	uint8_t cmd = (W_ACK_PAYLOAD | pipe);
+
+	csn_low();
+	nrf24_w_spec_cmd(cmd);
+
+	if(HAL_SPI_Transmit_DMA(&hspiX, data, size) != HAL_OK){
+		csn_high();
+		return nrf24_dma_error;
+	}
+
+	return nrf24_dma_started;
+}
+
 uint8_t nrf24_carrier_detect(void){
 	return nrf24_r_reg(RPD, 1);
 }
@@ -518,15 +583,84 @@ uint8_t nrf24_data_available(void){
 	return 0;
 }
 
-void nrf24_receive(uint8_t *data, uint8_t size){
-	uint8_t cmd = R_RX_PAYLOAD;
+uint8_t nrf24_receive(uint8_t *data, uint8_t size){
+	uint8_t status = 0;
 
 	csn_low();
-	HAL_SPI_Transmit(&hspiX, &cmd, 1, spi_w_timeout);
-	HAL_SPI_Receive(&hspiX, data, size, spi_r_timeout);
+	nrf24_w_spec_cmd(R_RX_PAYLOAD);
+	status = nrf24_status;
+
+	if(((status >> RX_P_NO) & RX_P_NO_MASK) == RX_P_NO_EMPTY){
+		csn_high();
+		return status;
+	}
+
+	nrf24_r_spec_reg(data, size);
 	csn_high();
 
 	nrf24_clear_rx_dr();
+
+	return status;
+}
+
+uint8_t nrf24_receive_dma(uint8_t *data, uint8_t size){
+
+	csn_low();
+	nrf24_w_spec_cmd(R_RX_PAYLOAD);
+
+	if(((nrf24_status >> RX_P_NO) & RX_P_NO_MASK) == RX_P_NO_EMPTY){
+		csn_high();
+		return nrf24_dma_empty;
+	}
+
+	if(HAL_SPI_Receive_DMA(&hspiX, data, size) != HAL_OK){
+		csn_high();
+		return nrf24_dma_error;
+	}
+
+	return nrf24_dma_started;
+}
+
+void nrf24_dma_cplt(void){
+	csn_high();
+}
+
+void nrf24_dma_abort(void){
+	HAL_SPI_Abort(&hspiX);
+	csn_high();
+}
+
+void nrf24_shadow_sync(void){
+	//registers updated by read-modify-write helpers, the others are cached on first write
+	static const uint8_t rmw_regs[] = { CONFIG, EN_AA, EN_RXADDR, SETUP_RETR, RF_SETUP, DYNPD, FEATURE };
+
+	nrf24_shadow_invalidate();
+
+	for(uint8_t i = 0; i < sizeof(rmw_regs); i++){
+		nrf24_shadow_r(rmw_regs[i]);
+	}
+}
+
+void nrf24_shadow_invalidate(void){
+	nrf24_shadow_valid = 0;
+}
+
+uint8_t nrf24_apply_config(const nrf24_reg_cfg_t *cfg, uint8_t count){
+	uint8_t writes = 0;
+
+	for(uint8_t i = 0; i < count; i++){
+		uint8_t reg = cfg[i].reg;
+		uint8_t val = cfg[i].val;
+
+		if(nrf24_shadow_cacheable(reg) && (nrf24_shadow_valid & (1UL << reg)) && nrf24_shadow[reg] == val){
+			continue;
+		}
+
+		nrf24_w_reg(reg, &val, 1);
+		writes++;
+	}
+
+	return writes;
 }
 
 void nrf24_defaults(void){
@@ -563,6 +697,8 @@ void nrf24_defaults(void){
 
 void nrf24_init(void){
 
+	nrf24_shadow_sync();
+
 	nrf24_pwr_up();
 
 	nrf24_flush_tx();
@@ -3,11 +3,14 @@
  * @brief CAN 통신 수신 및 송신 로직을 구현한다.
  * @author YeonsuJ
  * @date 2025-07-23
- * @note FreeRTOS 메시지 큐를 사용하여 CAN 수신 데이터를 비동기적으로 처리한다.
+ * @note 최신값 메일박스를 사용하여 CAN 수신 데이터를 비동기적으로 처리한다.
  */
 #include "can_handler.h"
 #include "can.h"
 #include "cmsis_os.h"
+#include "motor_control.h"
+#include "can_tx.h"
+#include "can_db.h"
 #include <stdbool.h>
 
 /**
@@ -19,19 +22,21 @@
  * - **수신 헤더 (RxHeader)**:
  * - `RxHeader.StdId`: 송신 측 ID (0x6A5가 맞는지 확인)
  * - `RxHeader.DLC`: 데이터 길이 (최소 4바이트 이상이어야 함)
- * - **수신 데이터 (RxData)**:
- * - `RxData[0]`: 거리 조건 결과 (1,2,3: 위험 -> 1로 변환 / 그 외: 안전 -> 0으로 변환)
- * - `RxData[1]`: 예비, 현재 미사용 (조도센서 데이터는 central에서 수신하지 않음)
- * - `RxData[2]`: 모터 RPM 하위 바이트(LSB)
- * - `RxData[3]`: 모터 RPM 상위 바이트(MSB)
- * - `RxData[4]~RxData[7]`: 예비, 현재 미사용
+ * - **수신 데이터 (RxData)**: can_db/vehicle.dbc의 SENSOR_STATUS 프레임 (can_db.h 코덱으로 디코딩)
+ * - `obstacle_front`/`obstacle_rear`: 전/후방 장애물 비트 (하나라도 1이면 위험 -> 1 / 그 외: 안전 -> 0)
+ * - `light_dark`: 조도 상태 (central에서는 사용하지 않음)
+ * - `motor_rpm`: 모터 RPM (부호 있는 16비트, 리틀 엔디언). 부호는 회전 방향이며, 이 ECU는 크기만 사용한다.
+ * - **비상 프레임**: StdId 0x010 (EMERGENCY) → 필터 뱅크 1 → FIFO0
+ * - FIFO1(센서 상태)과 하드웨어 버퍼와 인터럽트 라인(USB_LP_CAN1_RX0)이 분리되어 있어, 상태 프레임이 밀려 있어도 영향받지 않는다.
+ * - 수신 ISR에서 바로 `MotorControl_EmergencyStop()`을 호출해 TIM1 듀티를 0으로 제한한다. (RF/태스크 경로를 거치지 않음)
  */
 
 /**
- * @brief CAN 수신 데이터를 처리할 태스크로 전달하기 위한 FreeRTOS 메시지 큐 핸들.
- * @note 이 큐는 `freertos.c`에서 생성되며, 수신 콜백 함수에서 데이터를 `put`한다.
+ * @brief CAN 수신 데이터를 RFTask로 전달하기 위한 최신값 메일박스와 저장 공간
+ * @note 수신 콜백 함수에서 데이터를 `Mailbox_Put`한다.
  */
-extern osMessageQueueId_t CANRxQueueHandle;
+static uint8_t can_rx_mailbox_storage[MAILBOX_STORAGE_SIZE(sizeof(CAN_RxPacket_t))];
+Mailbox_t g_canRxMailbox = MAILBOX_INITIALIZER(can_rx_mailbox_storage, sizeof(CAN_RxPacket_t));
 
 CAN_FilterTypeDef sFilterConfig;    // CAN 필터 설정 구조체
 CAN_RxHeaderTypeDef RxHeader;       // 수신 메시지 헤더 저장용 변수
@@ -44,63 +49,125 @@ void CANHandler_Init(void)
 {
 	extern CAN_HandleTypeDef hcan;
 	HAL_CAN_Start(&hcan);
+	CanTx_Init(&hcan);
 	CAN_Filter_Config(&hcan);
 }
 
 /**
  * @brief CAN 메시지 수신 필터를 설정하고 인터럽트를 활성화한다.
  * @param hcan_ptr CAN 핸들러 포인터
- * @note 특정 CAN ID(0x6A5)를 가진 메시지만 수신하도록 필터를 구성한다.
- * 메시지가 FIFO1으로 수신되도록 설정하고, 관련 인터럽트를 활성화한다.
+ * @note 센서 상태(0x6A5)는 FIFO1, 비상 프레임(0x010)은 FIFO0으로 수신되도록 필터를 구성하고,
+ * 관련 인터럽트를 활성화한다.
  */
 void CAN_Filter_Config(CAN_HandleTypeDef *hcan_ptr)
 {
    // Configure the filter
+   sFilterConfig.FilterBank = 0;
    sFilterConfig.FilterActivation = CAN_FILTER_ENABLE;
    sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO1;
    sFilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
-   sFilterConfig.FilterIdHigh = 0x6A5<<5;
+   sFilterConfig.FilterIdHigh = CANDB_SENSOR_STATUS_ID<<5;
    sFilterConfig.FilterIdLow = 0;
    sFilterConfig.FilterMaskIdHigh = 0x7FF<<5; // 모든 비트가 일치해야 함
    sFilterConfig.FilterMaskIdLow = 0;
    sFilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
 
+   if (HAL_CAN_ConfigFilter(&hcan, &sFilterConfig) != HAL_OK)
+           Error_Handler(); // 실패 시 에러 처리
+
+   // 비상 프레임(0x010)은 뱅크 1을 통해 FIFO0으로 받는다.
+   sFilterConfig.FilterBank = 1;
+   sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+   sFilterConfig.FilterIdHigh = CANDB_EMERGENCY_ID<<5;
+
    if (HAL_CAN_ConfigFilter(&hcan, &sFilterConfig) != HAL_OK)
            Error_Handler(); // 실패 시 에러 처리
 
    // 수신 인터럽트 활성화
-   if (HAL_CAN_ActivateNotification(&hcan, CAN_IT_RX_FIFO1_MSG_PENDING) != HAL_OK)
+   if (HAL_CAN_ActivateNotification(&hcan, CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING) != HAL_OK)
            Error_Handler(); // 실패 시 에러 처리
 }
 
+/**
+ * @brief CAN RX0 인터럽트에서 FIFO0(비상 프레임)에 쌓인 메시지를 모두 처리한다.
+ * @param hcan CAN 핸들러 포인터
+ * @note USB_LP_CAN1_RX0_IRQn은 우선순위 4로, configMAX_SYSCALL_INTERRUPT_PRIORITY(5)보다 높아
+ * CAN RX1, TIM2, SPI/DMA 등 우선순위 5 핸들러와 RTOS 임계 구역(BASEPRI)을 선점한다.
+ * 따라서 이 경로에서는 RTOS API를 부르지 않는다. (MotorControl_EmergencyStop은 PRIMASK만 사용)
+ * HAL_CAN_IRQHandler는 활성화된 모든 CAN 이벤트를 처리하므로 대신 FIFO0 수신 콜백만 직접 호출한다.
+ */
+void CAN_Rx0_IRQHandler(CAN_HandleTypeDef *hcan)
+{
+  while (HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO0) > 0U)
+  {
+      HAL_CAN_RxFifo0MsgPendingCallback(hcan);
+  }
+}
+
+/**
+ * @brief CAN FIFO0(비상 프레임)에 메시지 수신이 보류 중일 때 호출되는 인터럽트 콜백 함수
+ * @param hcan CAN 핸들러 포인터
+ * @note ISR 컨텍스트에서 실행되며, 디코딩 후 즉시 모터 듀티를 제한한다. RTOS API를 부르지 않는다.
+ * FIFO1 콜백과 공유 버퍼(RxHeader, RxData)를 쓰지 않도록 지역 변수로 받는다.
+ * 우선순위 5의 다른 CAN 핸들러(HAL_CAN_IRQHandler)도 FIFO0 보류를 보고 이 콜백을 부를 수 있으므로,
+ * 읽기와 FIFO 해제가 RX0 인터럽트에 끊기지 않도록 인터럽트를 잠시 막는다.
+ */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+  CAN_RxHeaderTypeDef header;
+  uint8_t data[8];
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  HAL_StatusTypeDef status = HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &header, data);
+  __set_PRIMASK(primask);
+
+  if (status != HAL_OK)
+  {
+      return;
+  }
+
+  if (header.StdId == CANDB_EMERGENCY_ID && header.DLC >= CANDB_EMERGENCY_DLC)
+  {
+      CanDb_Emergency_t msg;
+
+      CanDb_Emergency_Unpack(data, &msg);
+      MotorControl_EmergencyStop(msg.stop_front, msg.stop_rear);
+  }
+}
+
 /**
  * @brief CAN FIFO1에 메시지 수신이 보류 중일 때 호출되는 인터럽트 콜백 함수
  * @param hcan CAN 핸들러 포인터
  * @note 이 함수는 ISR 컨텍스트에서 실행된다.
  * 수신된 메시지의 ID와 데이터 길이(DLC)를 확인한 후, 데이터를 파싱하여
- * `CAN_RxPacket_t` 구조체에 담아 FreeRTOS 메시지 큐로 전송한다.
+ * `CAN_RxPacket_t` 구조체에 담아 최신값 메일박스에 게시한다.
  */
 void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
 {
   HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO1, &RxHeader, RxData);
 
-  // ID가 0x6A5이고 데이터 길이가 4바이트 이상인지 확인
-  if (RxHeader.StdId == 0x6A5 && RxHeader.DLC >= 4)
+  // ID가 0x6A5이고 데이터 길이가 프레임 정의(DLC 4) 이상인지 확인
+  if (RxHeader.StdId == CANDB_SENSOR_STATUS_ID && RxHeader.DLC >= CANDB_SENSOR_STATUS_DLC)
   {
-	  // 1. 큐로 보낼 데이터를 담을 구조체 변수 선언
+	  // 1. 메일박스로 보낼 데이터를 담을 구조체 변수 선언
 	  CAN_RxPacket_t rx_packet;
+	  CanDb_SensorStatus_t msg;
+
+	  // 2. 생성된 코덱으로 신호를 디코딩하여 구조체에 복사
+	  CanDb_SensorStatus_Unpack(RxData, &msg);
 
-	  // 2. 수신한 데이터를 파싱하여 구조체에 복사
-	  // RxData[0] 값이 1, 2, 3 중 하나일 때만 위험(1)으로, 그 외에는 안전(0)으로 변환
-	  rx_packet.distance_signal = (RxData[0] >= 1 && RxData[0] <= 3) ? 1 : 0;
+	  // 전방 또는 후방 장애물이 하나라도 감지되면 위험(1), 아니면 안전(0)
+	  rx_packet.distance_signal = msg.obstacle_front | msg.obstacle_rear;
+	  // 방향은 주행 명령으로 이미 알고 있으므로, 속도 제어와 조종기 표시는 RPM 크기만 사용한다.
+	  rx_packet.motor_rpm = (uint16_t)((msg.motor_rpm < 0) ? -(int32_t)msg.motor_rpm : msg.motor_rpm);
 
-	  // 2바이트(MSB, LSB)를 조합하여 16비트 RPM 값으로 복원
-	  // 예: RxData[3]=0x01, RxData[2]=0x2C -> (0x01 << 8) | 0x2C -> 0x012C (300)
-	  rx_packet.motor_rpm = (uint16_t)(RxData[3] << 8) | RxData[2];
+	  // 속도 제어 루프(MotorTask)에 측정 RPM을 즉시 전달
+	  MotorControl_SetMeasuredRpm(rx_packet.motor_rpm);
 
-      // 3. 구조체 변수의 주소를 큐로 전송한다.
-      // 이 함수 호출 하나로 데이터 전송과 CAN 처리 태스크를 깨우는 작업이 모두 완료된다.
-      osMessageQueuePut(CANRxQueueHandle, &rx_packet, 0U, 0U);
+      // 3. 구조체를 메일박스에 게시한다.
+      // RFTask가 아직 읽지 않은 이전 값이 있으면 덮어써서, RFTask는 항상 최신 값을 읽는다.
+      Mailbox_Put(&g_canRxMailbox, &rx_packet);
   }
 }
 
@@ -111,23 +178,19 @@ void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
  * @param rf_status RF 수신 상태 (1: 정상, 0: 끊김)
  * @note CAN ID 0x321을 사용하여 3바이트의 데이터를 전송한다.
  * 슬레이브(센서) 측에서 이 ID를 수신하도록 필터 설정이 필요하다.
+ * 하드웨어 메일박스가 모두 사용 중이면 CAN 송신 스케줄러(can_tx) 큐에서 대기하며,
+ * 아직 송신되지 않은 이전 상태는 최신 상태로 교체된다.
  */
 void CAN_Send_DriveStatus(uint8_t direction, uint8_t brake_status, uint8_t rf_status)
 {
-    CAN_TxHeaderTypeDef TxHeader;
-    uint8_t TxData[3];
-    uint32_t TxMailbox;
-
-    TxHeader.StdId = 0x321;  // 송신 ID
-    TxHeader.IDE = CAN_ID_STD;
-    TxHeader.RTR = CAN_RTR_DATA;
-    TxHeader.DLC = 3;       // 데이터 길이
-    TxHeader.TransmitGlobalTime = DISABLE;
-
-    TxData[0] = direction;
-    TxData[1] = brake_status;
-    TxData[2] = rf_status;
-
-    HAL_CAN_AddTxMessage(&hcan, &TxHeader, TxData, &TxMailbox);
+    uint8_t TxData[CANDB_DRIVE_STATUS_DLC];
+    CanDb_DriveStatus_t msg = {
+        .direction = direction,
+        .brake = brake_status,
+        .rf_ok = rf_status,
+    };
+
+    CanDb_DriveStatus_Pack(&msg, TxData);
+    CanTx_Send(CANDB_DRIVE_STATUS_ID, TxData, CANDB_DRIVE_STATUS_DLC, CAN_DRIVE_STATUS_DEADLINE_MS);
 }
 
@@ -29,6 +29,7 @@
 #include "motor_control.h"
 #include "can_handler.h"
 #include "rf_handler.h"
+#include "timebase.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -39,6 +40,7 @@
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 #define RF_SEMAPHORE_TIMEOUT 250 // 250ms 동안 RF 신호가 없으면 실패로 간주
+#define CAN_FLAG_TX_STATUS   0x0001U // CANTask 스레드 플래그: 새 주행 상태가 메일박스에 게시됨
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -48,7 +50,11 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
-
+/**
+ * @brief RFTask(생산자) → CANTask(소비자)로 최신 주행 상태를 전달하는 메일박스
+ */
+static uint8_t can_tx_mailbox_storage[MAILBOX_STORAGE_SIZE(sizeof(VehicleCommand_t))];
+static Mailbox_t canTxMailbox = MAILBOX_INITIALIZER(can_tx_mailbox_storage, sizeof(VehicleCommand_t));
 /* USER CODE END Variables */
 /* Definitions for RFTask */
 osThreadId_t RFTaskHandle;
@@ -64,15 +70,12 @@ const osThreadAttr_t CANTask_attributes = {
   .stack_size = 256 * 4,
   .priority = (osPriority_t) osPriorityNormal,
 };
-/* Definitions for CANTxQueue */
-osMessageQueueId_t CANTxQueueHandle;
-const osMessageQueueAttr_t CANTxQueue_attributes = {
-  .name = "CANTxQueue"
-};
-/* Definitions for CANRxQueue */
-osMessageQueueId_t CANRxQueueHandle;
-const osMessageQueueAttr_t CANRxQueue_attributes = {
-  .name = "CANRxQueue"
+/* Definitions for MotorTask */
+osThreadId_t MotorTaskHandle;
+const osThreadAttr_t MotorTask_attributes = {
+  .name = "MotorTask",
+  .stack_size = 256 * 4,
+  .priority = (osPriority_t) osPriorityRealtime,
 };
 /* Definitions for RFSem */
 osSemaphoreId_t RFSemHandle;
@@ -87,6 +90,7 @@ const osSemaphoreAttr_t RFSem_attributes = {
 
 void StartRFTask(void *argument);
 void StartCANTask(void *argument);
+void StartMotorTask(void *argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
@@ -116,13 +120,6 @@ void MX_FREERTOS_Init(void) {
   /* start timers, add new ones, ... */
   /* USER CODE END RTOS_TIMERS */
 
-  /* Create the queue(s) */
-  /* creation of CANTxQueue */
-  CANTxQueueHandle = osMessageQueueNew (2, sizeof(VehicleCommand_t), &CANTxQueue_attributes);
-
-  /* creation of CANRxQueue */
-  CANRxQueueHandle = osMessageQueueNew (1, sizeof(CAN_RxPacket_t), &CANRxQueue_attributes);
-
   /* USER CODE BEGIN RTOS_QUEUES */
   /* add queues, ... */
   /* USER CODE END RTOS_QUEUES */
@@ -134,6 +131,9 @@ void MX_FREERTOS_Init(void) {
   /* creation of CANTask */
   CANTaskHandle = osThreadNew(StartCANTask, NULL, &CANTask_attributes);
 
+  /* creation of MotorTask */
+  MotorTaskHandle = osThreadNew(StartMotorTask, NULL, &MotorTask_attributes);
+
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
   /* USER CODE END RTOS_THREADS */
@@ -152,9 +152,10 @@ void MX_FREERTOS_Init(void) {
 * 1. RF 수신 인터럽트(세마포어)를 타임아웃과 함께 대기한다.
 * 2. 수신 성공 시, CANTask로부터 받은 최신 CAN 데이터(거리, RPM)가 있는지 확인하고, 있다면 ACK 페이로드에 반영할 준비를 한다.
 * 3. RF 수신 버퍼의 모든 주행 명령을 `RFHandler_GetNewCommand`를 통해 처리한다.
-* 4. 각 명령에 대해 모터를 제어(`MotorControl_Update`)하고, 해당 명령을 CANTask로 전달(`osMessageQueuePut`)한다.
+* 4. 각 명령을 MotorTask용 메일박스에 게시(`MotorControl_SetCommand`)하고, 해당 명령을 CANTask용 메일박스에 게시(`Mailbox_Put`)한다.
 * 5. 다음 전송을 위해 준비된 ACK 페이로드를 설정(`RFHandler_SetAckPayload`)한다.
 * 6. 만약 RF 수신이 타임아웃되면, RF 통신이 끊어진 것으로 간주하고 RF 실패 상태를 CANTask로 전송한다.
+*    (모터는 MotorTask가 명령 타임아웃을 감지하여 관성 감속시킨다.)
 */
 /* USER CODE END Header_StartRFTask */
 void StartRFTask(void *argument)
@@ -162,7 +163,7 @@ void StartRFTask(void *argument)
   /* USER CODE BEGIN StartRFTask */
 	VehicleCommand_t cmd = {0};
 
-	//큐에서 받을 데이터를 담을 구조체 변수
+	//메일박스에서 받을 데이터를 담을 구조체 변수
 	CAN_RxPacket_t received_can_packet;
 
 	// RF ACK 페이로드로 보낼 3바이트 데이터 버퍼 선언 및 초기화
@@ -174,11 +175,11 @@ void StartRFTask(void *argument)
 	      // RF 수신 인터럽트를 타임아웃과 함께 대기
 		if (osSemaphoreAcquire(RFSemHandle, RF_SEMAPHORE_TIMEOUT) == osOK)
 		{
-	      // CAN 수신 큐에서 최신 거리 값을 논블로킹으로 확인
+	      // CAN 수신 메일박스에서 최신 거리 값을 논블로킹으로 확인
 		  // 성공적으로 새 데이터를 받으면 ack_payload를 업데이트
-		  if (osMessageQueueGet(CANRxQueueHandle, &received_can_packet, NULL, 0U) == osOK)
+		  if (Mailbox_Get(&g_canRxMailbox, &received_can_packet))
 		  {
-			  // 큐에서 받은 구조체 데이터로 ack_payload 배열 채우기
+			  // 메일박스에서 받은 구조체 데이터로 ack_payload 배열 채우기
 
 			  // ack_payload[0]에는 햅틱을 위한 distance_signal 저장
 			  ack_payload[0] = received_can_packet.distance_signal;
@@ -195,11 +196,12 @@ void StartRFTask(void *argument)
 			  // 수신 성공 시, 구조체에 RF 상태(true)를 기록
 			  cmd.rf_status = true;
 
-	      // 모터 제어 업데이트
-			  MotorControl_Update(&cmd);
+	      // 최신 명령을 MotorTask에 게시 (실제 모터 출력은 1kHz 모터 루프가 담당)
+			  MotorControl_SetCommand(&cmd);
 
-	      // CAN 전송을 위해 수신한 cmd 구조체 전체를 CANTxQueue에 넣음
-			  osMessageQueuePut(CANTxQueueHandle, &cmd, 0U, 0U);
+	      // CAN 전송을 위해 수신한 cmd 구조체 전체를 메일박스에 게시하고 CANTask를 깨움
+			  Mailbox_Put(&canTxMailbox, &cmd);
+			  osThreadFlagsSet(CANTaskHandle, CAN_FLAG_TX_STATUS);
 
 	      // 컨트롤러에 보낼 ACK 페이로드 설정 (배열과 크기 전달)
 			  // GetNewCommand 함수 내부에서 ACK를 보내므로, 이 함수를 호출한 직후에 ACK 페이로드를 설정해야 다음 ACK에 반영됨 (while loop 내부)
@@ -213,7 +215,8 @@ void StartRFTask(void *argument)
 			// RF 실패 상태를 CANTask로 알리기 위해 상태 메시지 전송
 			memset(&cmd, 0, sizeof(VehicleCommand_t)); // 안전을 위해 주행 명령 초기화
 			cmd.rf_status = false; // 구조체에 RF 상태(false) 기록
-			osMessageQueuePut(CANTxQueueHandle, &cmd, 0U, 0U); // CANTask로 전송
+			Mailbox_Put(&canTxMailbox, &cmd); // CANTask로 전송
+			osThreadFlagsSet(CANTaskHandle, CAN_FLAG_TX_STATUS);
 		}
 	  }
   /* USER CODE END StartRFTask */
@@ -223,9 +226,9 @@ void StartRFTask(void *argument)
 /**
 * @brief RFTask로부터 받은 주행 상태를 CAN 버스로 전송하는 태스크
 * @param argument: None
-* @note 이 태스크는 `CANTxQueue`에 데이터가 들어올 때까지 무한정 대기한다.
-* `RFTask`가 큐에 `VehicleCommand_t` 구조체를 넣으면, 이 태스크는 깨어나서
-* 구조체에서 방향, 브레이크, RF 상태 정보를 추출하여 `CAN_Send_DriveStatus` 함수를 통해 전송한다.
+* @note 이 태스크는 `CAN_FLAG_TX_STATUS` 스레드 플래그가 올 때까지 무한정 대기한다.
+* `RFTask`가 메일박스에 `VehicleCommand_t` 구조체를 게시하고 플래그를 보내면, 이 태스크는 깨어나서
+* 가장 최신 구조체 하나만 꺼내 방향, 브레이크, RF 상태 정보를 추출하고 `CAN_Send_DriveStatus` 함수를 통해 전송한다.
 */
 /* USER CODE END Header_StartCANTask */
 void StartCANTask(void *argument)
@@ -236,8 +239,12 @@ void StartCANTask(void *argument)
   /* Infinite loop */
   for(;;)
   {
-      // 큐에서 VehicleCommand_t 구조체 수신
-	  osMessageQueueGet(CANTxQueueHandle, &received_cmd, NULL, osWaitForever);
+      // 새 주행 상태 게시 알림을 대기한 뒤 메일박스에서 최신 VehicleCommand_t 구조체 수신
+	  osThreadFlagsWait(CAN_FLAG_TX_STATUS, osFlagsWaitAny, osWaitForever);
+	  if (!Mailbox_Get(&canTxMailbox, &received_cmd))
+	  {
+		  continue; // 이전 알림에서 이미 최신 값을 처리함
+	  }
 
       // 수신한 구조체에서 필요한 데이터 추출
       uint8_t dir = received_cmd.direction;
@@ -250,6 +257,31 @@ void StartCANTask(void *argument)
   /* USER CODE END StartCANTask */
 }
 
+/* USER CODE BEGIN Header_StartMotorTask */
+/**
+* @brief 고정 주기(1kHz)로 모터 출력을 갱신하는 최우선순위 태스크
+* @param argument: None
+* @note RF 패킷 도착과 무관하게 `MOTOR_LOOP_PERIOD_MS`마다 `MotorControl_Tick`을 호출한다.
+* 관성 주행/브레이크 램프는 실제 경과 시간(µs)으로 계산되므로 무선 링크 속도가 바뀌거나
+* 끊겨도 차량 거동이 동일하다. `osDelayUntil`로 주기 누적 오차 없이 깨어난다.
+*/
+/* USER CODE END Header_StartMotorTask */
+void StartMotorTask(void *argument)
+{
+  /* USER CODE BEGIN StartMotorTask */
+  uint32_t wake_tick = osKernelGetTickCount();
+
+  /* Infinite loop */
+  for(;;)
+  {
+      MotorControl_Tick(Timebase_GetMicros());
+
+      wake_tick += MOTOR_LOOP_PERIOD_MS;
+      osDelayUntil(wake_tick);
+  }
+  /* USER CODE END StartMotorTask */
+}
+
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
 
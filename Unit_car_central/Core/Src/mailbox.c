@@ -0,0 +1,74 @@
+/**
+ * @file mailbox.c
+ * @brief 단일 생산자/단일 소비자(SPSC)용 최신값 메일박스(트리플 버퍼)를 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 슬롯 3개를 생산자(back), 소비자(front), 교환용(middle)으로 나누어 쓴다.
+ * 생산자는 back에 쓴 뒤 back과 middle을 교환하고, 소비자는 새 값이 있을 때 front와 middle을 교환한다.
+ * 어느 쪽도 상대가 사용 중인 슬롯에 접근하지 않으므로 복사 도중 선점되어도 값이 찢어지지 않는다.
+ */
+
+#include "mailbox.h"
+#include <string.h>
+
+#define MAILBOX_IDX_MASK 0x03U
+#define MAILBOX_FRESH    0x04U
+
+/**
+ * @brief state를 원자적으로 교환하고 이전 값을 반환한다. (LDREXB/STREXB)
+ */
+static uint8_t Mailbox_Exchange(volatile uint8_t *state, uint8_t value)
+{
+    uint8_t old;
+
+    do {
+        old = __LDREXB(state);
+    } while (__STREXB(value, state) != 0U);
+
+    return old;
+}
+
+void Mailbox_Init(Mailbox_t *mb, void *storage, uint16_t size)
+{
+    mb->storage = (uint8_t *)storage;
+    mb->size = size;
+    mb->front = 0;
+    mb->state = 1; // middle = 1, 새 값 없음
+    mb->back = 2;
+    mb->put_count = 0;
+    mb->overwrite_count = 0;
+    mb->get_count = 0;
+    mb->empty_count = 0;
+    memset(storage, 0, MAILBOX_STORAGE_SIZE(size));
+}
+
+void Mailbox_Put(Mailbox_t *mb, const void *data)
+{
+    memcpy(&mb->storage[mb->back * mb->size], data, mb->size);
+    __DMB(); // 슬롯 내용이 state 교환보다 먼저 보이도록 보장
+
+    uint8_t old = Mailbox_Exchange(&mb->state, mb->back | MAILBOX_FRESH);
+    if (old & MAILBOX_FRESH)
+    {
+        mb->overwrite_count++; // 소비자가 읽기 전에 이전 값을 덮어씀
+    }
+    mb->back = old & MAILBOX_IDX_MASK;
+    mb->put_count++;
+}
+
+bool Mailbox_Get(Mailbox_t *mb, void *data)
+{
+    if ((mb->state & MAILBOX_FRESH) == 0U)
+    {
+        mb->empty_count++;
+        return false;
+    }
+
+    uint8_t old = Mailbox_Exchange(&mb->state, mb->front);
+    mb->front = old & MAILBOX_IDX_MASK;
+    __DMB(); // 교환 이후에 슬롯 내용을 읽도록 보장
+
+    memcpy(data, &mb->storage[mb->front * mb->size], mb->size);
+    mb->get_count++;
+    return true;
+}
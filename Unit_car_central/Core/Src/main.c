@@ -20,6 +20,7 @@
 #include "main.h"
 #include "cmsis_os.h"
 #include "can.h"
+#include "dma.h"
 #include "spi.h"
 #include "tim.h"
 #include "gpio.h"
@@ -33,6 +34,7 @@
 #include "motor_control.h"
 #include "can_handler.h"
 #include "rf_handler.h"
+#include "timebase.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -97,12 +99,16 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_TIM2_Init();
   MX_SPI1_Init();
   MX_TIM1_Init();
   MX_CAN_Init();
   /* USER CODE BEGIN 2 */
 
+  // 0. µs 타임베이스(DWT) 초기화
+  Timebase_Init();
+
   // 1. CAN 핸들러 초기화 (CAN 시작, 필터 설정, 인터럽트 활성화)
   CANHandler_Init();
 
@@ -189,6 +195,34 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
         RFHandler_IrqCallback(); // RF 핸들러의 콜백 함수 호출
     }
 }
+
+/**
+ * @brief SPI DMA 수신/송신 완료 및 오류 콜백
+ * @note NRF24 페이로드 DMA 전송 결과를 `RFHandler`에 위임한다.
+ */
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        RFHandler_SpiDmaCpltCallback(); // CSN 해제 및 RFTask 깨움
+    }
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        RFHandler_SpiDmaCpltCallback();
+    }
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        RFHandler_SpiDmaErrorCallback();
+    }
+}
 /* USER CODE END 4 */
 
 /**
@@ -6,6 +6,8 @@
  * @note 타이머(TIM1, TIM2)와 GPIOA 핀을 사용하여 모터를 제어한다.
  */
 #include "motor_control.h"
+#include "timebase.h"
+#include "mailbox.h"
 
 // === 타이머 및 GPIO 외부 참조 ===
 /**
@@ -28,12 +30,62 @@ extern TIM_HandleTypeDef htim2;
 #define MOTOR_BACKWARD()    do { HAL_GPIO_WritePin(GPIOA, GPIO_PIN_0, GPIO_PIN_SET); HAL_GPIO_WritePin(GPIOA, GPIO_PIN_1, GPIO_PIN_RESET); } while (0)
 
 
-// === DC 모터 제어를 위한 새로운 매크로 ===
-#define MAX_DUTY            1000    ///< PWM 최대 듀티 값 (htim1의 ARR 값에 맞춰 설정한다)
-#define MIN_DUTY_ON_ACCEL   400     ///< 가속 시작 시 최소 듀티 (모터가 실제로 회전하기 시작하는 최소 PWM 값).
-#define ACCEL_SENSITIVITY   0.8f    ///< 가속 민감도. 값이 클수록 가속 버튼 유지 시간에 비해 속도가 빠르게 증가한다.
-#define COAST_DECREMENT     3       ///< 관성 주행 시 듀티 감소량. 이 값만큼 듀티가 서서히 감소한다.
-#define BRAKE_STEP          500     ///< 브레이크 시 듀티 감소량. 이 값만큼 듀티가 급격히 감소한다.
+// === 메일박스 ===
+/**
+ * @brief RFTask(생산자)가 쓰고 MotorTask(소비자)가 읽는 최신 명령 메일박스
+ */
+static uint8_t cmd_mailbox_storage[MAILBOX_STORAGE_SIZE(sizeof(VehicleCommand_t))];
+static Mailbox_t cmd_mailbox = MAILBOX_INITIALIZER(cmd_mailbox_storage, sizeof(VehicleCommand_t));
+
+/**
+ * @brief CAN 수신 ISR(생산자)이 쓰고 MotorTask(소비자)가 읽는 측정 RPM 메일박스
+ */
+static uint8_t rpm_mailbox_storage[MAILBOX_STORAGE_SIZE(sizeof(uint16_t))];
+static Mailbox_t rpm_mailbox = MAILBOX_INITIALIZER(rpm_mailbox_storage, sizeof(uint16_t));
+
+/**
+ * @brief 현재 DC 모터 듀티 (milli-duty). 개루프/속도 제어 모드가 공유한다.
+ */
+static int32_t dc_duty_m = 0;
+
+// === 비상 정지 ===
+#define EMERGENCY_FRONT 0x01U ///< 전진 차단
+#define EMERGENCY_REAR  0x02U ///< 후진 차단
+
+/**
+ * @brief 현재 모터 방향. Update_MotorDirection()이 쓰고, CAN 수신 ISR이 차단 여부 판단에 읽는다.
+ */
+static volatile MotorDirection_t motor_direction = DIRECTION_FORWARD;
+static volatile uint8_t emergency_mask = 0;      ///< 활성 비상 정지 비트 (EMERGENCY_FRONT | EMERGENCY_REAR)
+static volatile uint32_t emergency_time_us = 0;  ///< 마지막 비상 프레임 수신 시각 (µs)
+
+/**
+ * @brief 현재 방향의 구동이 비상 정지로 차단되어 있는지 확인한다.
+ */
+static inline bool MotorControl_IsBlocked(void)
+{
+    uint8_t bit = (motor_direction == DIRECTION_FORWARD) ? EMERGENCY_FRONT : EMERGENCY_REAR;
+    return (emergency_mask & bit) != 0;
+}
+
+/**
+ * @brief 계산된 듀티를 TIM1 CH4에 반영한다.
+ * @note 비상 정지 ISR과 경합하지 않도록, 차단 여부 확인과 CCR 쓰기를 인터럽트 금지 구간에서 함께 수행한다.
+ * 그렇지 않으면 확인 직후 ISR이 듀티를 0으로 만들어도 태스크가 이전 듀티로 덮어쓸 수 있다.
+ */
+static void DcMotor_Apply(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (MotorControl_IsBlocked())
+    {
+        dc_duty_m = 0;
+    }
+    __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_4, (uint32_t)(dc_duty_m / DUTY_SCALE));
+
+    __set_PRIMASK(primask);
+}
 
 /**
  * @brief Servo, DC 모터 제어에 필요한 모든 주변장치를 초기화한다.
@@ -50,14 +102,101 @@ void MotorControl_Init(void)
 }
 
 /**
- * @brief 수신된 주행 명령에 따라 모든 모터의 상태를 업데이트한다.
+ * @brief 최신 주행 명령을 메일박스에 게시한다.
  * @param command RF 통신으로 수신된 주행 명령 데이터 구조체의 포인터
+ * @note RFTask에서 호출하며, 실제 모터 출력은 MotorTask의 `MotorControl_Tick()`이 담당한다.
+ */
+void MotorControl_SetCommand(const VehicleCommand_t* command)
+{
+    Mailbox_Put(&cmd_mailbox, command);
+}
+
+/**
+ * @brief 고정 주기(MOTOR_LOOP_PERIOD_MS)로 호출되어 모든 모터의 상태를 업데이트한다.
+ * @param now_us 현재 시각 (µs, Timebase_GetMicros)
+ * @note 새 명령이 들어왔을 때만 서보/방향을 갱신하고, DC 모터 램프는 매 주기 실제 경과 시간(dt)으로 계산한다.
+ * 마지막 명령이 MOTOR_CMD_TIMEOUT_MS 이상 오래되면(RF 끊김) 입력 없음으로 간주하여 관성 감속한다.
+ */
+void MotorControl_Tick(uint32_t now_us)
+{
+    static VehicleCommand_t cmd = {0};
+    static bool has_cmd = false;
+    static uint32_t cmd_time_us = 0;  // 마지막 명령 수신 시각 (µs)
+    static uint32_t last_tick_us = 0;
+    static bool first = true;
+
+    uint32_t dt_us = first ? 0 : (now_us - last_tick_us);
+    last_tick_us = now_us;
+    first = false;
+    if (dt_us > MOTOR_DT_MAX_US)
+    {
+        dt_us = MOTOR_DT_MAX_US; // 디버거 정지 등으로 인한 비정상 dt 제한
+    }
+
+    // 반복 프레임이 끊기면(센서 ECU 정지, 위험 해소 후 해제 프레임 유실) 비상 정지를 해제한다.
+    if (emergency_mask != 0)
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if ((now_us - emergency_time_us) > (MOTOR_EMERGENCY_HOLD_MS * 1000U))
+        {
+            emergency_mask = 0;
+        }
+        __set_PRIMASK(primask);
+    }
+
+    if (Mailbox_Get(&cmd_mailbox, &cmd))
+    {
+        has_cmd = true;
+        cmd_time_us = now_us;
+        Update_MotorDirection((MotorDirection_t)cmd.direction);
+        Control_Servo(cmd.roll);
+    }
+
+    if (!has_cmd || (now_us - cmd_time_us) > (MOTOR_CMD_TIMEOUT_MS * 1000U))
+    {
+#if MOTOR_CONTROL_MODE == MOTOR_MODE_SPEED
+        Control_DcMotorSpeed(0, 0, dt_us, now_us);
+#else
+        Control_DcMotor(0, 0, dt_us);
+#endif
+    }
+    else
+    {
+#if MOTOR_CONTROL_MODE == MOTOR_MODE_SPEED
+        Control_DcMotorSpeed(cmd.accel_ms, cmd.brake_ms, dt_us, now_us);
+#else
+        Control_DcMotor(cmd.accel_ms, cmd.brake_ms, dt_us);
+#endif
+    }
+}
+
+/**
+ * @brief 센서 ECU의 비상 정지 요청을 반영한다.
+ * @param stop_front 전방 충돌 위험 → 전진 구동 차단
+ * @param stop_rear 후방 충돌 위험 → 후진 구동 차단
+ * @note CAN 수신 ISR에서 호출된다. 현재 방향이 차단 대상이면 즉시 TIM1 CH4 듀티를 0으로 만든다.
+ * 이후 MotorTask는 DcMotor_Apply()에서 같은 조건을 확인하므로 해제 전까지 듀티가 다시 올라가지 않는다.
  */
-void MotorControl_Update(const VehicleCommand_t* command)
+void MotorControl_EmergencyStop(uint8_t stop_front, uint8_t stop_rear)
 {
-	Update_MotorDirection((MotorDirection_t)command->direction);
-    Control_Servo(command->roll);
-    Control_DcMotor(command->accel_ms, command->brake_ms);
+    emergency_mask = (stop_front ? EMERGENCY_FRONT : 0U) | (stop_rear ? EMERGENCY_REAR : 0U);
+    emergency_time_us = Timebase_GetMicros();
+
+    if (MotorControl_IsBlocked())
+    {
+        __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_4, 0);
+    }
+}
+
+/**
+ * @brief 센서 ECU가 보낸 최신 측정 RPM을 저장한다.
+ * @param rpm 엔코더 기반 모터 RPM
+ * @note CAN 수신 ISR에서 호출된다.
+ */
+void MotorControl_SetMeasuredRpm(uint16_t rpm)
+{
+    Mailbox_Put(&rpm_mailbox, &rpm);
 }
 
 /**
@@ -81,62 +220,50 @@ void Control_Servo(float roll)
  * @brief DC 모터의 속도를 제어한다.
  * @param accel_ms 가속 버튼이 눌린 시간 (밀리초)
  * @param brake_ms 브레이크 버튼이 눌린 시간 (밀리초)
- * @note 이 함수는 `static` 변수 `current_duty`를 사용하여 현재 모터의 속도(듀티)를 기억하고,
- * 입력 값에 따라 점진적으로 속도를 조절한다.
- * - 브레이크 입력 시: 듀티를 `BRAKE_STEP` 만큼 급격히 감소시킨다.
- * - 가속 입력 시: 눌린 시간을 기반으로 목표 듀티를 계산하여 즉시 반영한다.
- * - 입력 없을 시: 듀티를 `COAST_DECREMENT` 만큼 서서히 감소시켜 관성 주행을 구현한다.
+ * @param dt_us 직전 호출 이후 경과 시간 (µs)
+ * @note 이 함수는 모듈 변수 `dc_duty_m`을 사용하여 현재 모터의 속도(듀티)를 기억하고,
+ * `DcMotor_RampStep()`(motor_ramp.c)으로 계산한 값을 TIM1 CH4에 반영한다. (비상 정지 중이면 0)
  */
-void Control_DcMotor(uint16_t accel_ms, uint16_t brake_ms)
+void Control_DcMotor(uint16_t accel_ms, uint16_t brake_ms, uint32_t dt_us)
 {
-    static int16_t current_duty = 0;
+    dc_duty_m = DcMotor_RampStep(dc_duty_m, accel_ms, brake_ms, dt_us);
 
-    if (brake_ms > 0)
-    {
-        // 브레이크 버튼이 눌리면 빠르게 감속한다.
-        current_duty -= BRAKE_STEP;
-    }
-    else if (accel_ms > 0)
-    {
-        // 가속 버튼이 눌리면, 눌린 시간을 기반으로 목표 듀티를 계산한다.
-        // 오래 누를수록 target_duty 값이 커진다.
-        int16_t target_duty = (int16_t)(MIN_DUTY_ON_ACCEL + (accel_ms * ACCEL_SENSITIVITY));
+    DcMotor_Apply();
+}
 
-        // 현재 듀티를 목표 듀티로 설정한다.
-        // (만약 더 부드러운 가속을 원한다면, current_duty를 target_duty까지 점진적으로 증가시키는 로직을 추가할 수 있다.)
-        current_duty = target_duty;
-    }
-    else // 아무 버튼도 눌리지 않았을 때
-    {
-        // 서서히 속도를 줄여 관성 주행(Coasting)을 구현한다.
-        current_duty -= COAST_DECREMENT;
-    }
+/**
+ * @brief DC 모터의 속도를 목표 RPM 기반 폐루프로 제어한다.
+ * @param accel_ms 가속 버튼이 눌린 시간 (ms)
+ * @param brake_ms 브레이크 버튼이 눌린 시간 (ms)
+ * @param dt_us 직전 호출 이후 경과 시간 (µs)
+ * @param now_us 현재 시각 (µs)
+ * @note RPM 메일박스에서 새 측정값을 꺼내 `SpeedPid_LoopStep()`(speed_pid.c)으로 듀티를 계산하고 TIM1 CH4에 반영한다.
+ * 현재 방향이 비상 정지로 차단되어 있으면 듀티 0을 유지한다.
+ */
+void Control_DcMotorSpeed(uint16_t accel_ms, uint16_t brake_ms, uint32_t dt_us, uint32_t now_us)
+{
+    static SpeedPidLoop_t loop = {0};
+    uint16_t meas_rpm = 0;
 
-    // 듀티 값이 유효한 범위를 벗어나지 않도록 제한한다.
-    if (current_duty > MAX_DUTY)
-    {
-        current_duty = MAX_DUTY;
-    }
-    if (current_duty < 0)
-    {
-        current_duty = 0;
-    }
+    bool new_meas = Mailbox_Get(&rpm_mailbox, &meas_rpm);
+
+    dc_duty_m = SpeedPid_LoopStep(&loop, dc_duty_m, accel_ms, brake_ms, MotorControl_IsBlocked(),
+                                  new_meas, meas_rpm, dt_us, now_us);
 
-    __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_4, current_duty);
+    DcMotor_Apply();
 }
 
 /**
  * @brief DC 모터의 회전 방향을 업데이트한다.
  * @param direction 설정할 새로운 모터 방향
- * @note `static` 변수 `prev_direction`을 사용하여 이전 방향 상태를 저장한다.
+ * @note 모듈 변수 `motor_direction`에 이전 방향 상태를 저장한다. (비상 정지 ISR도 이 값을 읽는다)
  * 새로운 방향이 이전 방향과 다를 경우에만 GPIO 제어 매크로를 호출하여
  * 불필요한 GPIO 쓰기 동작을 방지한다.
  */
 void Update_MotorDirection(MotorDirection_t direction)
 {
-    static MotorDirection_t prev_direction = DIRECTION_FORWARD;
-    if (direction != prev_direction) {
-        prev_direction = direction;
+    if (direction != motor_direction) {
+        motor_direction = direction;
         if (direction == DIRECTION_FORWARD) {
             MOTOR_FORWARD();
         } else {
@@ -0,0 +1,50 @@
+/**
+ * @file motor_ramp.c
+ * @brief DC 모터 듀티 램프를 경과 시간 기반 정수 연산으로 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ */
+
+#include "motor_ramp.h"
+
+/**
+ * @brief DC 모터 듀티 램프를 경과 시간만큼 진행한다.
+ * @note 시각을 인자로 받으므로 호스트에서 가상 시계로 그대로 검증할 수 있다.
+ * - 브레이크 입력 시: 초당 `BRAKE_RATE_PER_S` 비율로 급격히 감소시킨다.
+ * - 가속 입력 시: 눌린 시간을 기반으로 목표 듀티를 계산하여 즉시 반영한다.
+ * - 입력 없을 시: 초당 `COAST_RATE_PER_S` 비율로 서서히 감소시켜 관성 주행을 구현한다.
+ */
+int32_t DcMotor_RampStep(int32_t duty_m, uint16_t accel_ms, uint16_t brake_ms, uint32_t dt_us)
+{
+    if (dt_us > MOTOR_DT_MAX_US)
+    {
+        dt_us = MOTOR_DT_MAX_US;
+    }
+
+    // 비율(단위/s) x dt(µs) / 1e6 x DUTY_SCALE = 비율 x dt / 1000 (milli-duty)
+    if (brake_ms > 0)
+    {
+        duty_m -= (int32_t)((BRAKE_RATE_PER_S * dt_us) / 1000U);
+    }
+    else if (accel_ms > 0)
+    {
+        // 오래 누를수록 목표 듀티가 커진다.
+        duty_m = (MIN_DUTY_ON_ACCEL + ((int32_t)accel_ms * ACCEL_SENSITIVITY_PERMILLE) / 1000) * DUTY_SCALE;
+    }
+    else // 아무 버튼도 눌리지 않았을 때
+    {
+        duty_m -= (int32_t)((COAST_RATE_PER_S * dt_us) / 1000U);
+    }
+
+    // 듀티 값이 유효한 범위를 벗어나지 않도록 제한한다.
+    if (duty_m > MAX_DUTY * DUTY_SCALE)
+    {
+        duty_m = MAX_DUTY * DUTY_SCALE;
+    }
+    if (duty_m < 0)
+    {
+        duty_m = 0;
+    }
+
+    return duty_m;
+}
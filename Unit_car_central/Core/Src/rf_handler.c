@@ -10,6 +10,7 @@
 #include "NRF24_reg_addresses.h"
 #include <string.h>
 #include "cmsis_os.h"
+#include "timebase.h"
 
 /**
  * @brief NRF24 수신(Rx) 패킷 구조 정의
@@ -32,6 +33,28 @@
  * @note 이 세마포어는 `freertos.c`에서 생성되고, IRQ 콜백에서 release된다.
  */
 extern osSemaphoreId_t RFSemHandle;
+extern osThreadId_t RFTaskHandle;
+
+volatile RFDmaStats_t g_rfDmaStats = {0};
+
+#if RF_SPI_USE_DMA
+static volatile uint32_t dma_start_cycles = 0; // DMA 전송 시작 시점의 DWT 사이클 카운트
+#endif
+
+/**
+ * @brief 수신(Rx) 모드 레지스터 설정 테이블
+ * @note nrf24_apply_config()로 한 번에 적용한다. 레지스터 섀도우와 값이 같은 항목은 쓰지 않는다.
+ * PRIM_RX 비트는 마지막에 nrf24_listen()이 설정한다.
+ */
+static const nrf24_reg_cfg_t rx_config[] = {
+    { CONFIG,   (1 << EN_CRC) | (1 << PWR_UP) },    // 1바이트 CRC 활성화
+    { EN_AA,    0x3F },                             // 모든 파이프에 대해 자동 ACK 활성화
+    { FEATURE,  (1 << EN_ACK_PAY) },                // ACK 페이로드 기능 활성화, 동적 페이로드 길이 비활성화
+    { RF_SETUP, (1 << RF_DR_HIGH) | (_0dbm << RF_PWR) }, // 데이터 속도 2Mbps, 송신 출력 0dBm (조종기와 동일하게)
+    { RF_CH,    90 },                               // RF 채널 90번 설정
+    { SETUP_AW, 5 - 2 },                            // 주소 폭 5바이트 설정
+    { RX_PW_P1, RX_PAYLOAD_SIZE },                  // 파이프 1번의 페이로드 크기 설정
+};
 
 /**
  * @brief 조종기로 보낼 ACK 응답 데이터를 저장하는 내부 버퍼
@@ -42,6 +65,7 @@ static uint8_t ack_response[ACK_PAYLOAD_SIZE] = {0};
  * @brief NRF24 모듈을 수신(Rx) 모드로 초기화한다.
  * @note 주소, 채널, 데이터 속도 등 통신 파라미터를 설정하고,
  * ACK 페이로드 기능을 활성화한 후 수신 대기 모드로 전환한다.
+ * 단일 바이트 레지스터는 `rx_config` 테이블로 일괄 적용하므로 읽기-수정-쓰기 SPI 트랜잭션이 없다.
  */
 void RFHandler_Init(void)
 {
@@ -51,17 +75,9 @@ void RFHandler_Init(void)
     HAL_Delay(5);
     ce_low();
 
-    nrf24_init();
-    nrf24_auto_ack_all(auto_ack);    // 모든 파이프에 대해 자동 ACK 활성화
-    nrf24_en_ack_pld(enable);        // ACK 페이로드 기능 활성화
-    nrf24_dpl(disable);              // 동적 페이로드 길이 비활성화
-    nrf24_set_crc(enable, _1byte);   // 1바이트 CRC 활성화
-    nrf24_tx_pwr(_0dbm);             // 송신 출력 0dBm 설정
-    nrf24_data_rate(_2mbps);         // 데이터 속도 2Mbps 설정 (조종기와 동일하게)
-    nrf24_set_channel(90);           // RF 채널 90번 설정
-    nrf24_set_addr_width(5);         // 주소 폭 5바이트 설정
+    nrf24_init();                    // 레지스터 섀도우 동기화, 전원 ON, FIFO/플래그 초기화
+    nrf24_apply_config(rx_config, sizeof(rx_config) / sizeof(rx_config[0])); // 통신 파라미터 일괄 적용
     nrf24_open_rx_pipe(1, rx_addr);  // 수신 파이프 1번 열기
-    nrf24_pipe_pld_size(1, RX_PAYLOAD_SIZE); // 파이프 1번의 페이로드 크기 설정
 
     nrf24_listen(); // 수신 대기 시작
 }
@@ -79,6 +95,107 @@ void RFHandler_IrqCallback(void)
     }
 }
 
+/**
+ * @brief SPI1 DMA 전송 완료 콜백 (ISR 컨텍스트)
+ * @note CSN을 해제하고 전송 시간을 기록한 뒤, 스레드 플래그로 RFTask를 깨운다.
+ */
+void RFHandler_SpiDmaCpltCallback(void)
+{
+#if RF_SPI_USE_DMA
+    uint32_t cycles = Timebase_GetCycles() - dma_start_cycles;
+
+    nrf24_dma_cplt();
+
+    g_rfDmaStats.transfer_count++;
+    g_rfDmaStats.last_cycles = cycles;
+    if (cycles > g_rfDmaStats.max_cycles)
+    {
+        g_rfDmaStats.max_cycles = cycles;
+    }
+    osThreadFlagsSet(RFTaskHandle, RF_FLAG_SPI_DMA);
+#endif
+}
+
+/**
+ * @brief SPI1 오류 콜백 (ISR 컨텍스트)
+ * @note CSN을 해제하고 RFTask에 오류를 알린다.
+ */
+void RFHandler_SpiDmaErrorCallback(void)
+{
+#if RF_SPI_USE_DMA
+    nrf24_dma_cplt();
+    g_rfDmaStats.error_count++;
+    osThreadFlagsSet(RFTaskHandle, RF_FLAG_SPI_ERROR);
+#endif
+}
+
+#if RF_SPI_USE_DMA
+/**
+ * @brief 시작한 SPI DMA 전송이 끝날 때까지 RFTask를 블로킹한다.
+ * @retval true 전송 완료
+ * @retval false 오류 또는 타임아웃 (타임아웃 시 전송을 중단한다)
+ */
+static bool RFHandler_WaitSpiDma(void)
+{
+    uint32_t flags = osThreadFlagsWait(RF_FLAG_SPI_DMA | RF_FLAG_SPI_ERROR, osFlagsWaitAny, RF_SPI_DMA_TIMEOUT_MS);
+
+    if ((flags & osFlagsError) != 0U)
+    {
+        nrf24_dma_abort();
+        g_rfDmaStats.timeout_count++;
+        return false;
+    }
+
+    return (flags & RF_FLAG_SPI_ERROR) == 0U;
+}
+
+/**
+ * @brief RX 페이로드 1개를 DMA로 읽고 ACK 페이로드를 DMA로 적재한다.
+ * @param rx_buffer 수신 데이터를 저장할 버퍼 (DMA 대상이므로 정적 버퍼여야 한다)
+ * @retval true 페이로드 수신 성공
+ * @retval false RX FIFO가 비어 있거나 전송에 실패함
+ * @note 실패 시 RX FIFO와 RX_DR을 정리하여 다음 IRQ가 정상적으로 발생하도록 한다.
+ */
+static bool RFHandler_ReceiveDma(uint8_t* rx_buffer)
+{
+    osThreadFlagsClear(RF_FLAG_SPI_DMA | RF_FLAG_SPI_ERROR);
+    dma_start_cycles = Timebase_GetCycles();
+
+    uint8_t result = nrf24_receive_dma(rx_buffer, RX_PAYLOAD_SIZE);
+    if (result == nrf24_dma_empty)
+    {
+        return false; // 새 데이터 없음
+    }
+
+    if (result != nrf24_dma_started || !RFHandler_WaitSpiDma())
+    {
+        if (result == nrf24_dma_error)
+        {
+            g_rfDmaStats.error_count++;
+        }
+        nrf24_flush_rx();
+        nrf24_clear_rx_dr();
+        return false;
+    }
+
+    nrf24_clear_rx_dr();
+
+    // 미리 준비된 ACK 페이로드 송신
+    osThreadFlagsClear(RF_FLAG_SPI_DMA | RF_FLAG_SPI_ERROR);
+    dma_start_cycles = Timebase_GetCycles();
+    if (nrf24_transmit_rx_ack_pld_dma(1, ack_response, ACK_PAYLOAD_SIZE) == nrf24_dma_started)
+    {
+        (void)RFHandler_WaitSpiDma(); // 실패해도 수신한 명령은 유효하다
+    }
+    else
+    {
+        g_rfDmaStats.error_count++;
+    }
+
+    return true;
+}
+#endif
+
 /**
  * @brief 다음에 전송할 ACK 페이로드에 포함될 데이터를 설정한다.
  * @param payload 전송할 데이터가 담긴 버퍼의 포인터
@@ -101,26 +218,29 @@ void RFHandler_SetAckPayload(uint8_t* payload, uint8_t length)
  * @param command 파싱된 명령 데이터를 저장할 `VehicleCommand_t` 구조체의 포인터
  * @retval true 새로운 명령이 수신되어 파싱까지 성공했음을 의미한다.
  * @retval false 수신된 데이터가 없거나, 수신된 데이터의 ID가 유효하지 않음을 의미한다.
- * @note NRF24 상태 레지스터의 RX_DR (수신 완료) 비트를 확인하여 새 데이터 유무를 판단한다.
- * 데이터를 성공적으로 읽은 후에는 ACK 페이로드를 전송하고 RX_DR 플래그를 클리어한다.
+ * @note 별도의 상태 레지스터 읽기 없이, 페이로드 읽기 명령과 함께 수신된 STATUS의 RX_P_NO 필드로
+ * RX FIFO에 데이터가 있는지 판단한다. 따라서 FIFO에 여러 패킷이 쌓여 있어도 호출할 때마다 하나씩 모두 꺼낼 수 있다.
+ * 데이터를 성공적으로 읽은 후에는 ACK 페이로드를 전송한다. (RX_DR 플래그는 수신 시 함께 클리어된다)
  */
 bool RFHandler_GetNewCommand(VehicleCommand_t* command)
 {
-    // 수신 데이터 준비 여부 확인
-    uint8_t status = nrf24_r_status();
-    if ((status & (1U << RX_DR)) == 0U) {
-        return false; // 새 데이터 없음
+#if RF_SPI_USE_DMA
+    // 데이터 수신 및 ACK 페이로드 적재 (DMA 전송 중에는 RFTask가 블로킹되어 CPU를 양보한다)
+    static uint8_t rx_buffer[RX_PAYLOAD_SIZE];
+    if (!RFHandler_ReceiveDma(rx_buffer)) {
+        return false;
     }
-
-    // 데이터 수신
+#else
+    // 데이터 수신 (R_RX_PAYLOAD 명령과 함께 수신된 STATUS로 RX FIFO 비어 있음 여부를 판단)
     uint8_t rx_buffer[RX_PAYLOAD_SIZE] = {0};
-    nrf24_receive(rx_buffer, RX_PAYLOAD_SIZE);
+    uint8_t status = nrf24_receive(rx_buffer, RX_PAYLOAD_SIZE);
+    if (((status >> RX_P_NO) & RX_P_NO_MASK) == RX_P_NO_EMPTY) {
+        return false; // 새 데이터 없음
+    }
 
-    // 미리 준비된 ACK 페이로드 송신
+    // 미리 준비된 ACK 페이로드 송신 (RX_DR은 nrf24_receive에서 클리어됨)
     nrf24_transmit_rx_ack_pld(1, ack_response, ACK_PAYLOAD_SIZE);
-
-    // RX_DR 클리어
-    nrf24_clear_rx_dr();
+#endif
 
     // 파싱
     if (rx_buffer[0] == 1)  // ID == 1 : 주행 명령
@@ -0,0 +1,174 @@
+/**
+ * @file speed_pid.c
+ * @brief 목표 RPM 기반 DC 모터 속도 제어(피드포워드 + PID)를 정수 연산으로 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ */
+
+#include "speed_pid.h"
+
+/**
+ * @brief 목표 RPM에 대한 피드포워드 듀티를 계산한다.
+ * @param target_rpm 목표 RPM
+ * @retval 피드포워드 듀티 (milli-duty)
+ * @note 개루프 모델(MIN_DUTY_ON_ACCEL에서 회전 시작, MAX_DUTY에서 MOTOR_MAX_RPM)을 직선으로 근사한다.
+ * PID는 이 모델과 실제(부하, 배터리 전압 강하) 사이의 차이만 보정하면 된다.
+ */
+int32_t SpeedPid_FeedForward(int32_t target_rpm)
+{
+    if (target_rpm <= 0)
+    {
+        return 0;
+    }
+    return MIN_DUTY_ON_ACCEL * DUTY_SCALE
+         + (target_rpm * (MAX_DUTY - MIN_DUTY_ON_ACCEL) * DUTY_SCALE) / MOTOR_MAX_RPM;
+}
+
+int32_t SpeedPid_TargetFromAccel(uint16_t accel_ms)
+{
+    int32_t excess = ((int32_t)accel_ms * ACCEL_SENSITIVITY_PERMILLE) / 1000;
+    if (excess > MAX_DUTY - MIN_DUTY_ON_ACCEL) excess = MAX_DUTY - MIN_DUTY_ON_ACCEL;
+
+    return (excess * MOTOR_MAX_RPM * 1000) / (MAX_DUTY - MIN_DUTY_ON_ACCEL);
+}
+
+/**
+ * @brief PID 상태(적분항)를 초기화한다.
+ * @param pid 제어기 상태
+ * @param meas_rpm 현재 측정 RPM (미분항의 첫 스텝 튐 방지)
+ */
+void SpeedPid_Reset(SpeedPid_t *pid, int32_t meas_rpm)
+{
+    pid->integral_m = 0;
+    pid->prev_rpm = meas_rpm;
+}
+
+/**
+ * @brief PID 속도 제어를 한 스텝 수행한다.
+ * @param pid 제어기 상태
+ * @param target_rpm 목표 RPM
+ * @param meas_rpm 측정 RPM
+ * @param dt_us 직전 측정 이후 경과 시간 (µs)
+ * @retval 출력 듀티 (milli-duty)
+ * @note 출력 = 피드포워드 + P + I + D. 모든 연산은 정수(milli-duty)이며, 적분은 64비트 중간값으로 계산한다.
+ * 출력이 상한(하한)에 걸린 상태에서 오차가 같은 방향이면 적분을 갱신하지 않고(조건부 적분),
+ * 적분항 자체도 ±SPEED_I_LIMIT_MILLI로 제한한다.
+ * 목표가 계단으로 바뀐 직후처럼 오차가 SPEED_I_BAND_RPM보다 크면 P와 피드포워드만으로 따라가고 적분은 멈춘다.
+ * 측정이 20~50ms 늦게 들어오므로, 이 구간에 쌓인 적분은 목표 도달 후 오버슈트로 남는다.
+ */
+int32_t SpeedPid_Step(SpeedPid_t *pid, int32_t target_rpm, int32_t meas_rpm, uint32_t dt_us)
+{
+    int32_t err = target_rpm - meas_rpm;
+    int32_t ff_m = SpeedPid_FeedForward(target_rpm);
+    int32_t p_m = err * SPEED_KP_MILLI;
+    int32_t d_m = 0;
+
+    if (dt_us > 0)
+    {
+        // 측정값 미분(derivative on measurement): 목표값 계단 변화 시 미분 킥이 생기지 않는다.
+        d_m = (int32_t)(((int64_t)SPEED_KD_MILLI * (pid->prev_rpm - meas_rpm) * 1000000) / dt_us);
+    }
+    pid->prev_rpm = meas_rpm;
+
+    int32_t i_new = pid->integral_m + (int32_t)(((int64_t)SPEED_KI_MILLI * err * dt_us) / 1000000);
+    if (i_new > SPEED_I_LIMIT_MILLI) i_new = SPEED_I_LIMIT_MILLI;
+    if (i_new < -SPEED_I_LIMIT_MILLI) i_new = -SPEED_I_LIMIT_MILLI;
+
+    int32_t out = ff_m + p_m + i_new + d_m;
+
+    // 안티 와인드업: 포화 방향으로 더 밀어내는 적분과 과도 구간의 적분은 버린다.
+    bool saturated = (out > MAX_DUTY * DUTY_SCALE && err > 0) || (out < 0 && err < 0);
+    bool in_band = (err <= SPEED_I_BAND_RPM) && (err >= -SPEED_I_BAND_RPM);
+    if (!saturated && in_band)
+    {
+        pid->integral_m = i_new;
+    }
+    out = ff_m + p_m + pid->integral_m + d_m;
+
+    if (out > MAX_DUTY * DUTY_SCALE) out = MAX_DUTY * DUTY_SCALE;
+    if (out < 0) out = 0;
+
+    return out;
+}
+
+void SpeedPid_LoopInit(SpeedPidLoop_t *loop)
+{
+    *loop = (SpeedPidLoop_t){0};
+}
+
+/**
+ * @brief 속도 제어 루프를 한 주기 진행한다.
+ * @note
+ * - 비상 정지 차단 시: 목표와 적분을 비워, 해제 직후 누적된 적분으로 급가속하지 않게 한다.
+ * - 브레이크 입력 시: PID를 초기화하고 개루프와 동일하게 듀티를 급격히 감소시킨다.
+ * - 입력 없을 시: 목표 RPM을 초당 `SPEED_COAST_RPM_PER_S`로 낮춘다.
+ * - PID는 새 RPM 측정값이 들어왔을 때만 직전 측정과의 간격(최대 SPEED_RPM_TIMEOUT_MS)으로 갱신하고, 그 사이에는 듀티를 유지한다.
+ * - RPM이 SPEED_RPM_TIMEOUT_MS 이상 수신되지 않으면 피드포워드만으로 구동한다.
+ */
+int32_t SpeedPid_LoopStep(SpeedPidLoop_t *loop, int32_t duty_m, uint16_t accel_ms, uint16_t brake_ms, bool blocked,
+                          bool new_meas, uint16_t meas_rpm, uint32_t dt_us, uint32_t now_us)
+{
+    if (new_meas)
+    {
+        loop->meas_rpm = meas_rpm;
+        loop->has_meas = true;
+        loop->meas_time_us = now_us;
+    }
+    int32_t rpm = loop->meas_rpm;
+
+    bool fresh = loop->has_meas && ((now_us - loop->meas_time_us) <= (SPEED_RPM_TIMEOUT_MS * 1000U));
+
+    if (blocked)
+    {
+        loop->target_rpm_m = 0;
+        SpeedPid_Reset(&loop->pid, rpm);
+        duty_m = 0;
+    }
+    else if (brake_ms > 0)
+    {
+        loop->target_rpm_m = 0;
+        SpeedPid_Reset(&loop->pid, rpm);
+        duty_m = DcMotor_RampStep(duty_m, 0, brake_ms, dt_us);
+    }
+    else
+    {
+        if (accel_ms > 0)
+        {
+            loop->target_rpm_m = SpeedPid_TargetFromAccel(accel_ms);
+        }
+        else
+        {
+            loop->target_rpm_m -= (int32_t)((SPEED_COAST_RPM_PER_S * dt_us) / 1000U);
+            if (loop->target_rpm_m < 0) loop->target_rpm_m = 0;
+        }
+
+        int32_t target_rpm = loop->target_rpm_m / 1000;
+
+        if (target_rpm == 0)
+        {
+            SpeedPid_Reset(&loop->pid, rpm);
+            duty_m = 0;
+        }
+        else if (!fresh)
+        {
+            SpeedPid_Reset(&loop->pid, rpm);
+            duty_m = SpeedPid_FeedForward(target_rpm);
+        }
+        else if (new_meas)
+        {
+            uint32_t meas_dt_us = loop->meas_time_us - loop->last_meas_us;
+            if (meas_dt_us > SPEED_RPM_TIMEOUT_MS * 1000U)
+            {
+                meas_dt_us = SPEED_RPM_TIMEOUT_MS * 1000U;
+            }
+            duty_m = SpeedPid_Step(&loop->pid, target_rpm, rpm, meas_dt_us);
+        }
+    }
+
+    if (new_meas)
+    {
+        loop->last_meas_us = loop->meas_time_us;
+    }
+
+    return duty_m;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file timebase.c
+ * @brief DWT 사이클 카운터 기반의 µs/사이클 단위 단조 증가 타임베이스를 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL_GetTick()은 1ms 분해능이라 5ms 주기의 dt를 ±20%까지 양자화하고,
+ * 선점 직후에는 0이 될 수도 있다. 이 모듈은 32비트 DWT->CYCCNT의 랩어라운드를
+ * 누적하여 64비트 µs 카운터를 제공한다. 모든 연산은 32비트 나눗셈과 64비트 덧셈만 사용한다.
+ */
+
+#include "timebase.h"
+
+// --- static 변수 ---
+static uint32_t cycles_per_us = 72;   // SystemCoreClock / 1MHz (Timebase_Init에서 갱신)
+static uint32_t last_cycles = 0;      // 마지막 갱신 시점의 CYCCNT
+static uint32_t cycle_remainder = 0;  // µs로 환산되지 못한 잔여 사이클
+static uint64_t micros_acc = 0;       // 누적 µs
+
+void Timebase_Init(void)
+{
+    // DWT 기능 활성화
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    // Cycle Counter 리셋 후 활성화
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cycles_per_us = SystemCoreClock / 1000000U;
+    last_cycles = 0;
+    cycle_remainder = 0;
+    micros_acc = 0;
+}
+
+uint64_t Timebase_GetMicros64(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq(); // ISR과 태스크가 동시에 누적값을 갱신하지 않도록 보호
+
+    uint32_t now = DWT->CYCCNT;
+    uint32_t delta = (now - last_cycles) + cycle_remainder;
+    last_cycles = now;
+
+    micros_acc += delta / cycles_per_us;
+    cycle_remainder = delta % cycles_per_us;
+
+    uint64_t result = micros_acc;
+
+    __set_PRIMASK(primask);
+
+    return result;
+}
+
+uint32_t Timebase_GetMicros(void)
+{
+    return (uint32_t)Timebase_GetMicros64();
+}
+
+uint32_t Timebase_CyclesToMicros(uint32_t cycles)
+{
+    return cycles / cycles_per_us;
+}
+
+void Timebase_DelayMicros(uint32_t us)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t wait_cycles = us * cycles_per_us;
+
+    while ((DWT->CYCCNT - start) < wait_cycles)
+    {
+    }
+}
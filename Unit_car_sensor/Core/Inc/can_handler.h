@@ -9,29 +9,77 @@
 #define INC_CAN_TX_HANDLER_H_
 
 #include "main.h"
+#include "can_db.h"
+#include "can_publish.h"
 #include <stdbool.h>
 
+// 0x6A5 프레임의 최대 송신 대기 시간. 넘기면 폐기.
+// 변화 기반 송신이라 대기 중 값이 바뀌면 같은 ID로 교체(마감 재시작)되므로, 대기 중인 프레임은 여전히 최신 상태다.
+// 회전 중 하트비트 주기만큼 기다렸다면 다음 하트비트가 곧 더 새로운 값을 싣는다.
+#define CAN_SENSOR_DEADLINE_MS CAN_PUB_ACTIVE_HEARTBEAT_MS
+#define CAN_ODOM_PERIOD_MS     100 // 0x6A6 오도메트리 프레임 전송 주기 (최대 송신 대기 시간도 동일)
+#define CAN_RANGE_PERIOD_MS    100 // 0x6A7 필터 거리 프레임 전송 주기 (최대 송신 대기 시간도 동일)
+#define CAN_EMERGENCY_REPEAT_MS 20 // 0x010 비상 프레임의 정지 유지 중 반복 주기 (최대 송신 대기 시간도 동일)
+#define CAN_DRIVE_STATUS_TIMEOUT_MS 250 // 0x321 주행 상태가 이 시간 동안 없으면 방향 명령을 모르는 것으로 본다 (중앙 ECU 명령 타임아웃과 동일)
+
 /**
  * @brief SensorTask가 CANTask로 데이터를 전달하기 위한 구조체이다.
  */
 typedef struct {
-    uint32_t distance_front;  // 전방 초음파 센서 거리 값
-    uint32_t distance_rear;   // 후방 초음파 센서 거리 값
+    uint16_t distance_front_mm; // 전방 초음파 센서 거리 값 (mm, Hampel 필터 출력)
+    uint16_t distance_rear_mm;  // 후방 초음파 센서 거리 값 (mm, Hampel 필터 출력)
+    uint16_t front_spread_mm;   // 전방 거리 윈도우의 중앙값 절대 편차 (mm)
+    uint16_t rear_spread_mm;    // 후방 거리 윈도우의 중앙값 절대 편차 (mm)
+    uint8_t  front_confidence;  // 전방 거리 필터 신뢰도 (%)
+    uint8_t  rear_confidence;   // 후방 거리 필터 신뢰도 (%)
+    uint16_t front_age_ms;      // 전방 거리 값의 경과 시간 (ms)
+    uint16_t rear_age_ms;       // 후방 거리 값의 경과 시간 (ms)
+    bool     front_valid;       // 전방 거리 값 유효 여부 (타임아웃/오래된 값이면 false)
+    bool     rear_valid;        // 후방 거리 값 유효 여부
     uint8_t  light_condition; // 조도 센서 상태 값
-    float    rpm;             // 모터 RPM 값
+    int32_t  rpm_x10;         // 모터 RPM 값 (0.1 RPM 단위, 부호: 회전 방향)
+    uint32_t travel_mm;       // 부팅 후 누적 주행 거리 (mm)
 } SensorData_t;
 
 // --- 외부 전역 변수 ---
 extern uint8_t TxData[8]; // 전송될 CAN 데이터 버퍼
+extern CanPublish_t g_canPublish; // 0x6A5 송신 정책 상태/통계 (CANTask 전용, 디버거로 확인)
 
 /**
  * @brief CAN 통신을 초기화한다.
  */
 void CAN_tx_Init(void);
 
+/**
+ * @brief 마지막으로 수신한 주행 상태 프레임(0x321)을 가져온다.
+ * @param msg 주행 상태 신호를 받을 구조체
+ * @param now_ms 현재 시각 (ms)
+ * @retval CAN_DRIVE_STATUS_TIMEOUT_MS 안에 수신한 값이면 true
+ */
+bool CAN_GetDriveStatus(CanDb_DriveStatus_t *msg, uint32_t now_ms);
+
 /**
  * @brief CAN 메시지를 전송한다.
  */
 void CAN_Send(void);
 
+/**
+ * @brief 오도메트리 프레임(0x6A6)을 전송한다.
+ */
+void CAN_SendOdometry(const CanDb_Odometry_t *msg);
+
+/**
+ * @brief 필터 거리 프레임(0x6A7)을 전송한다.
+ */
+void CAN_SendRange(const CanDb_Range_t *msg);
+
+/**
+ * @brief 비상 정지 상태를 갱신하고, 필요하면 비상 프레임(0x010)을 전송한다.
+ * @param stop_front 전방 충돌 위험
+ * @param stop_rear 후방 충돌 위험
+ * @param ttc_ms 전/후방 중 짧은 TTC (ms)
+ * @param now_ms 현재 시각 (ms)
+ */
+void CAN_UpdateEmergency(bool stop_front, bool stop_rear, uint16_t ttc_ms, uint32_t now_ms);
+
 #endif /* INC_CAN_TX_HANDLER_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file can_publish.h
+ * @brief SENSOR_STATUS(0x6A5) 프레임의 변화 기반 송신 정책을 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않으므로 호스트에서 버스 시뮬레이션으로 부하를 측정할 수 있다.
+ * 매 10ms 전송하면 센서 ECU 하나가 초당 100프레임을 차지한다. 이 정책은 다음 경우에만 송신한다.
+ * - 즉시(URGENT): 장애물/유효/조도 비트가 바뀌었을 때. 최소 간격 제한 없이 바로 보낸다.
+ * - 변화(CHANGE): RPM이 데드밴드 이상 바뀌었을 때. min_interval_ms로 빈도를 제한한다.
+ * - 하트비트(HEARTBEAT): 위 조건이 없어도 heartbeat_ms마다(회전 중에는 active_heartbeat_ms마다) 보낸다.
+ *   수신 측 타임아웃(Status 250ms, Central 속도 제어 100ms)보다 짧아야 한다.
+ */
+
+#ifndef INC_CAN_PUBLISH_H_
+#define INC_CAN_PUBLISH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "can_db.h"
+
+#define CAN_PUB_HEARTBEAT_MS         200 // 정지 상태 하트비트 (Status ECU 노드 타임아웃 250ms보다 짧게)
+#define CAN_PUB_ACTIVE_HEARTBEAT_MS  50  // 회전 중 하트비트 (Central 속도 제어 RPM 타임아웃 100ms보다 짧게)
+#define CAN_PUB_MIN_INTERVAL_MS      20  // RPM 변화 송신의 최소 간격
+#define CAN_PUB_RPM_DEADBAND         2   // 이 값 이상 RPM이 바뀌어야 변화로 본다 (rpm)
+
+/**
+ * @brief 송신 사유
+ */
+typedef enum {
+    CAN_PUB_NONE = 0,   // 송신하지 않음
+    CAN_PUB_URGENT,     // 이산 신호(장애물/유효/조도) 변화
+    CAN_PUB_CHANGE,     // RPM 데드밴드 초과
+    CAN_PUB_HEARTBEAT,  // 주기 하트비트
+    CAN_PUB_REASON_COUNT
+} CanPublishReason_t;
+
+/**
+ * @brief 송신 정책 설정 (실행 중 변경 가능)
+ */
+typedef struct {
+    uint16_t heartbeat_ms;
+    uint16_t active_heartbeat_ms;
+    uint16_t min_interval_ms;
+    uint16_t rpm_deadband;
+} CanPublishConfig_t;
+
+/**
+ * @brief 송신 정책 상태와 통계
+ */
+typedef struct {
+    CanPublishConfig_t cfg;
+    CanDb_SensorStatus_t last_sent;            // 마지막으로 송신한 신호 값
+    uint32_t last_tx_ms;                       // 마지막 송신 시각 (ms)
+    bool     sent_once;                        // 첫 프레임은 무조건 송신
+    uint32_t evaluated_count;                  // 정책 평가 횟수 (= 10ms 주기 샘플 수)
+    uint32_t sent_count[CAN_PUB_REASON_COUNT]; // 사유별 송신 수 (CAN_PUB_NONE = 억제된 샘플 수)
+    uint32_t tx_bits;                          // 송신한 프레임의 최악 비트 수 합 (버스 부하 계산용)
+} CanPublish_t;
+
+/**
+ * @brief 기본 설정(CAN_PUB_* 매크로)으로 정책 상태를 초기화한다.
+ */
+void CanPublish_Init(CanPublish_t *pub);
+
+/**
+ * @brief 새 샘플을 송신할지 결정한다. 송신으로 결정하면 마지막 송신 값/시각을 갱신한다.
+ * @param msg 이번 주기의 신호 값
+ * @param now_ms 현재 시각 (ms)
+ * @retval 송신 사유. CAN_PUB_NONE이면 송신하지 않는다.
+ */
+CanPublishReason_t CanPublish_Evaluate(CanPublish_t *pub, const CanDb_SensorStatus_t *msg, uint32_t now_ms);
+
+/**
+ * @brief 표준 ID 데이터 프레임 한 개의 최악 비트 수를 반환한다. (비트 스터핑, IFS 포함)
+ * @param dlc 데이터 길이 (0~8)
+ */
+uint32_t CanPublish_FrameBits(uint8_t dlc);
+
+#endif /* INC_CAN_PUBLISH_H_ */
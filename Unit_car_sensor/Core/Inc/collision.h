@@ -0,0 +1,95 @@
+/**
+ * @file collision.h
+ * @brief 초음파 거리 이력과 바퀴 속도로 접근 속도와 충돌 예상 시간(TTC)을 계산하는 함수를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않는 순수 함수만 모아 두어 호스트에서 그대로 컴파일해 검증할 수 있다.
+ * 접근 속도는 두 추정값 중 큰 값(보수적)을 쓴다.
+ * - 거리 변화율: 연속한 두 측정의 거리 차 / 시간 차. 다가오는 물체도 감지하지만 60ms 측정 주기만큼 늦다.
+ * - 바퀴 속도: 엔코더 선속도의 센서 방향 성분. 정지 물체에 대해 10ms마다 갱신된다.
+ * 마지막 측정 이후 경과 시간(age)만큼 접근한 거리를 빼서 현재 거리를 외삽한다.
+ * 새 추적(무효 이후 첫 측정, 장면 변화로 기준을 바꾼 직후)은 기준과 일관된 측정이 한 번 더 와야 정지를 판단한다.
+ * 에코 타임아웃 직후 튀는 짧은 에코 하나가 곧바로 비상 정지를 걸지 않게 한다. (확인까지 최대 1측정 주기 지연)
+ * 엔코더 RPM 부호와 전진 방향의 관계는 모터 배선에 따라 다르므로 고정값으로 두지 않고,
+ * 중앙 ECU의 주행 방향 명령(DRIVE_STATUS)과 실제 회전 방향을 비교해 실행 중에 학습한다. (Collision_SignUpdate)
+ * 학습 전에는 바퀴 속도 항을 0으로 두고 거리 변화율만 쓴다.
+ */
+
+#ifndef INC_COLLISION_H_
+#define INC_COLLISION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define COLL_TTC_STOP_MS       500  // TTC가 이보다 짧으면 비상 정지
+#define COLL_STOP_DIST_MM      100  // 접근 중에 이 거리 이내면 TTC와 무관하게 비상 정지 (기존 장애물 판단 거리)
+#define COLL_CLOSING_MIN_MM_S  20   // 이 속도 미만의 접근은 측정 노이즈로 보고 무시한다
+#define COLL_RANGE_RATE_MAX_MM_S 3000// 이보다 빠른 거리 변화는 튀는 에코로 본다 (차량 최고 속도 + 다가오는 물체 여유)
+#define COLL_TTC_NONE          0xFFFFU // 접근하지 않음 (TTC 없음)
+#define COLL_SIGN_MIN_RPM_X10  200  // 바퀴 방향 학습에 쓰는 최소 |RPM| (0.1 RPM 단위). 이보다 느리면 부호가 노이즈에 묻힌다
+#define COLL_SIGN_CONFIRM_COUNT 20  // 같은 부호가 연속 이 횟수(10ms 주기 → 200ms) 나와야 확정한다
+#define COLL_SIGN_SETTLE_MS    300  // 방향 명령이 바뀐 뒤 이 시간 동안은 관성 회전으로 보고 학습하지 않는다
+
+/**
+ * @brief 센서 하나의 접근 추적 상태
+ */
+typedef struct {
+    uint16_t last_mm;       // 직전 측정 거리 (mm)
+    uint32_t last_meas_ms;  // 직전 측정(채택된 값) 시각 (ms)
+    uint32_t seen_meas_ms;  // 마지막으로 처리한 측정 시각 (버린 값 포함)
+    bool     has_last;      // 직전 측정 유무
+    bool     rejected;      // 직전 측정을 튀는 값으로 버렸는지
+    bool     confirmed;     // 기준 측정 뒤에 변화율이 그럴듯한 측정이 이어졌는지 (확인 전에는 정지하지 않는다)
+    int32_t  range_rate;    // 거리 변화율로 구한 접근 속도 (mm/s, 양수: 가까워짐)
+    int32_t  closing_mm_s;  // 최종 접근 속도 (mm/s)
+    uint16_t ttc_ms;        // 충돌 예상 시간 (ms, 접근하지 않으면 COLL_TTC_NONE)
+    bool     stop;          // 비상 정지 필요 여부
+} CollisionTrack_t;
+
+/**
+ * @brief 엔코더 RPM 부호 → 전진 방향 학습 상태
+ */
+typedef struct {
+    int8_t   sign;            // 확정된 부호 (+1/-1, 0: 미확정)
+    int8_t   run_sign;        // 연속 판정 중인 부호 후보
+    uint8_t  run;             // run_sign이 연속으로 나온 횟수
+    bool     has_dir;         // 직전 방향 명령 유무
+    bool     last_forward;    // 직전 방향 명령 (true: 전진)
+    uint32_t dir_change_ms;   // 방향 명령이 마지막으로 바뀐 시각 (ms)
+    uint32_t mismatch_count;  // 확정 후 명령과 반대로 도는 것이 관측된 샘플 수 (진단용)
+} CollisionWheelSign_t;
+
+/**
+ * @brief 추적 상태를 초기화한다.
+ */
+void Collision_Init(CollisionTrack_t *trk);
+
+/**
+ * @brief 새 측정과 바퀴 속도로 접근 속도, TTC, 정지 여부를 갱신한다.
+ * @param distance_mm 마지막 에코의 거리 (mm)
+ * @param age_ms 마지막 에코 이후 경과 시간 (ms)
+ * @param valid 거리 값 유효 여부 (무효면 이력을 버리고 정지 판단을 하지 않는다)
+ * @param wheel_mm_s 바퀴 선속도의 센서 방향 성분 (mm/s, 양수: 센서 쪽으로 전진)
+ * @param now_ms 현재 시각 (ms)
+ * @retval 비상 정지 필요 여부
+ */
+bool Collision_Update(CollisionTrack_t *trk, uint16_t distance_mm, uint16_t age_ms, bool valid,
+                      int32_t wheel_mm_s, uint32_t now_ms);
+
+/**
+ * @brief 바퀴 방향 학습 상태를 초기화한다. (부호 미확정)
+ */
+void Collision_SignInit(CollisionWheelSign_t *ws);
+
+/**
+ * @brief 주행 방향 명령과 엔코더 RPM으로 RPM 부호 → 전진 방향을 학습한다.
+ * @param cmd_valid 방향 명령이 최신이고 구동 중인지 (수신 타임아웃, RF 끊김, 브레이크면 false)
+ * @param cmd_forward 명령 방향 (true: 전진)
+ * @param rpm_x10 엔코더 RPM (0.1 RPM 단위, 부호 포함)
+ * @param now_ms 현재 시각 (ms)
+ * @retval 확정된 부호 (+1/-1, 미확정이면 0). 바퀴 선속도에 곱하면 전진이 양수가 된다
+ */
+int8_t Collision_SignUpdate(CollisionWheelSign_t *ws, bool cmd_valid, bool cmd_forward, int32_t rpm_x10,
+                            uint32_t now_ms);
+
+#endif /* INC_COLLISION_H_ */
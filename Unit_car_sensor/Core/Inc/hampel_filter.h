@@ -0,0 +1,58 @@
+/**
+ * @file hampel_filter.h
+ * @brief 초음파 거리(mm)용 슬라이딩 윈도우 중앙값/Hampel 필터를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않는 순수 함수만 모아 두어 호스트에서 그대로 컴파일해 검증할 수 있다.
+ * 최근 HAMPEL_WINDOW개 샘플을 입력 순서(ring)와 정렬 순서(sorted) 두 배열로 유지한다.
+ * - 갱신: 가장 오래된 값을 이진 탐색으로 찾아 그 자리에서 새 값을 순위가 바뀐 만큼만 밀어 넣는다.
+ *   거리가 천천히 변하면 이동은 0~1칸이다. (최악 HAMPEL_WINDOW - 1칸)
+ * - 중앙값: sorted의 가운데 원소 (O(1))
+ * - MAD(중앙값 절대 편차): 중앙값 좌/우의 편차가 각각 정렬되어 있으므로 두 정렬 배열의 k번째 값으로 구한다. (O(log N))
+ * - 신뢰도: 임계값 안에 드는 샘플 수를 이진 탐색 두 번으로 센다. (O(log N))
+ * 새 샘플이 중앙값에서 k × 1.4826 × MAD(정규분포 표준편차 환산)보다 멀면 이상값으로 보고 중앙값으로 대체한다.
+ * 이상값이 아니면 원래 값을 그대로 내보내므로 정상 구간에서는 중앙값 필터의 지연이 없다.
+ */
+
+#ifndef INC_HAMPEL_FILTER_H_
+#define INC_HAMPEL_FILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HAMPEL_WINDOW          5    // 윈도우 크기 (홀수). 연속 (N-1)/2개까지의 이상값을 걸러낸다
+#define HAMPEL_K_X10           30   // 이상값 판단 배수 k (0.1 단위, 3.0σ)
+#define HAMPEL_MAD_TO_SIGMA_X1000 1483 // MAD → 표준편차 환산 계수 (1.4826)
+#define HAMPEL_MIN_THRESHOLD_MM 20  // 임계값 하한 (mm). MAD가 0이어도 센서 분해능 수준의 변화는 이상값으로 보지 않는다
+#define HAMPEL_MIN_SAMPLES     3    // 이 개수 이상 모여야 이상값 판단을 한다
+
+/**
+ * @brief 센서 하나의 필터 상태
+ */
+typedef struct {
+    uint16_t ring[HAMPEL_WINDOW];   // 입력 순서 샘플 (가장 오래된 값이 head)
+    uint16_t sorted[HAMPEL_WINDOW]; // 오름차순 정렬 샘플
+    uint8_t  head;                  // 다음에 덮어쓸 ring 인덱스
+    uint8_t  count;                 // 윈도우에 든 샘플 수
+    uint16_t median_mm;             // 윈도우 중앙값 (mm)
+    uint16_t mad_mm;                // 중앙값 절대 편차 (mm, 퍼짐 정도)
+    uint16_t output_mm;             // 필터 출력 (mm)
+    uint8_t  confidence;            // 신뢰도 (%, 윈도우 크기 대비 임계값 안의 샘플 비율)
+    bool     outlier;               // 마지막 샘플이 이상값으로 대체되었는지
+    uint32_t sample_count;          // 입력 샘플 수
+    uint32_t outlier_count;         // 이상값으로 대체한 샘플 수
+} HampelFilter_t;
+
+/**
+ * @brief 필터 상태를 비운다.
+ */
+void HampelFilter_Init(HampelFilter_t *f);
+
+/**
+ * @brief 새 샘플을 넣고 필터 출력을 반환한다.
+ * @param mm 새 거리 샘플 (mm)
+ * @retval 필터 출력 (mm). 이상값이면 윈도우 중앙값, 아니면 입력값
+ */
+uint16_t HampelFilter_Push(HampelFilter_t *f, uint16_t mm);
+
+#endif /* INC_HAMPEL_FILTER_H_ */
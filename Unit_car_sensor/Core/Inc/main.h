@@ -61,10 +61,10 @@ void Error_Handler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
-#define Rear_Trig_Pin GPIO_PIN_12
-#define Rear_Trig_GPIO_Port GPIOB
-#define Front_Trig_Pin GPIO_PIN_13
-#define Front_Trig_GPIO_Port GPIOB
+#define Front_Trig_Pin GPIO_PIN_2
+#define Front_Trig_GPIO_Port GPIOA
+#define Rear_Trig_Pin GPIO_PIN_3
+#define Rear_Trig_GPIO_Port GPIOA
 #define Encoder_A_Pin GPIO_PIN_8
 #define Encoder_A_GPIO_Port GPIOA
 #define Encoder_B_Pin GPIO_PIN_9
@@ -8,21 +8,36 @@
 #ifndef INC_MOTOR_ENCODER_H_
 #define INC_MOTOR_ENCODER_H_
 
+#include <stdint.h>
+
+/**
+ * @brief 엔코더 타이머(TIM1)와 엣지 캡처 인터럽트를 시작한다.
+ */
+void MotorEncoder_Init(void);
+
+/**
+ * @brief 엔코더 엣지 캡처 인터럽트에서 호출된다.
+ */
+void MotorEncoder_CaptureCallback(void);
 
 /**
  * @brief 현재 모터의 RPM 값을 반환한다.
- * @retval float 현재 RPM 값
+ * @retval 0.1 RPM 단위, 부호 있는 값 (부호: 회전 방향)
+ */
+int32_t MotorEncoder_GetRpmX10(void);
+
+/**
+ * @brief 부팅 후 누적 위치(틱)를 반환한다.
  */
-float MotorControl_GetRPM(void);
+int64_t MotorEncoder_GetPositionTicks(void);
 
 /**
- * @brief DWT(Data Watchpoint and Trace) 유닛을 초기화한다.
- * @note 정밀한 시간 측정을 위해 사용된다.
+ * @brief 부팅 후 누적 주행 거리(mm)를 반환한다.
  */
-void DWT_Init(void);
+uint32_t MotorEncoder_GetTravelMm(void);
 
 /**
- * @brief 주기적으로 호출되어 모터의 RPM을 계산하고 갱신한다.
+ * @brief 주기적으로 호출되어 모터의 RPM과 오도메트리를 계산하고 갱신한다.
  */
 void Update_Motor_RPM(void);
 
@@ -0,0 +1,52 @@
+/**
+ * @file odometry.h
+ * @brief 16비트 엔코더 카운터를 64비트 위치로 확장하고 주행 거리를 적산하는 함수를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않는 순수 함수만 모아 두어 호스트에서 그대로 컴파일해 검증할 수 있다.
+ * TIM1 CNT는 16비트라 약 96바퀴(65536틱)마다 랩어라운드한다. 직전 값과의 차이를 int16_t로 해석하면
+ * 오버플로/언더플로 방향과 무관하게 정확한 변화량이 되므로, 호출 간격 동안 ±32767틱 이내로만 움직이면
+ * (10ms 주기 기준 약 28만 RPM) 위치가 손실되지 않는다.
+ */
+
+#ifndef INC_ODOMETRY_H_
+#define INC_ODOMETRY_H_
+
+#include <stdint.h>
+
+#define ODOM_WHEEL_CIRC_UM 204204 // 바퀴 둘레 (µm). 지름 65mm 바퀴 기준, 실측 보정 대상
+
+/**
+ * @brief 오도메트리 상태
+ */
+typedef struct {
+    uint16_t last_raw;       // 직전 엔코더 카운터 값
+    int64_t  position_ticks; // 부팅 후 누적 위치 (틱, 부호: 회전 방향)
+    uint64_t travel_ticks;   // 부팅 후 누적 이동량 (틱, 방향 무관 절대값 합)
+} Odometry_t;
+
+/**
+ * @brief 현재 카운터 값을 기준으로 상태를 초기화한다.
+ */
+void Odometry_Init(Odometry_t *od, uint16_t raw);
+
+/**
+ * @brief 새 카운터 값으로 위치와 이동량을 적산한다.
+ * @param raw 현재 16비트 엔코더 카운터 값
+ * @retval 이번 호출의 변화량 (틱)
+ */
+int16_t Odometry_Update(Odometry_t *od, uint16_t raw);
+
+/**
+ * @brief 틱을 바퀴 이동 거리(mm)로 변환한다. (반올림)
+ */
+int64_t Odometry_TicksToMm(int64_t ticks);
+
+/**
+ * @brief RPM을 바퀴 선속도(mm/s)로 변환한다.
+ * @param rpm_x10 0.1 RPM 단위 RPM
+ * @retval mm/s (부호: 회전 방향, 반올림)
+ */
+int32_t Odometry_RpmX10ToMmPerS(int32_t rpm_x10);
+
+#endif /* INC_ODOMETRY_H_ */
@@ -0,0 +1,62 @@
+/**
+ * @file rpm_calc.h
+ * @brief 엔코더 엣지 타임스탬프로 RPM을 추정하는 M/T 방식 정수 연산 함수를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않는 순수 함수만 모아 두어 호스트에서 그대로 컴파일해 검증할 수 있다.
+ *
+ * - M 방식(고속): 한 주기 안에 엣지가 여러 개면, 주기 경계가 아니라 첫/마지막 엣지 사이의
+ *   카운트 변화량과 시간을 사용한다. 카운트 양자화 오차가 없어진다.
+ * - T 방식(저속): 주기 안에 엣지가 없으면 여러 주기에 걸친 엣지 간격으로 계산한다.
+ *   다음 엣지가 늦어지면 "경과 시간 동안 한 엣지 주기 미만" 상한으로 값을 줄여 정지를 빠르게 반영한다.
+ */
+
+#ifndef INC_RPM_CALC_H_
+#define INC_RPM_CALC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RPM_TICKS_PER_REV_X10  6816 // 한 바퀴당 틱 수 (0.1틱 단위) = PPR 8 × 기어비 21.3 × 4체배
+#define RPM_TICKS_PER_EDGE     4    // 캡처 엣지(A상 상승) 한 주기당 4체배 카운트 수
+#define RPM_ZERO_TIMEOUT_MS    300  // 이 시간 동안 엣지가 없으면 정지로 판단 (최저 측정 속도 약 1.2 RPM)
+
+/**
+ * @brief M/T 추정기 상태
+ */
+typedef struct {
+    uint32_t clk_hz;      // 타임스탬프 클럭 (Hz)
+    uint32_t ref_seq;     // 기준 엣지의 시퀀스 번호
+    uint32_t ref_cycles;  // 기준 엣지 타임스탬프
+    int16_t  ref_count;   // 기준 엣지의 엔코더 카운트
+    bool     has_ref;     // 기준 엣지 유무 (정지 후 첫 엣지는 기준만 잡는다)
+    int32_t  rpm_x10;     // 마지막 추정값 (0.1 RPM 단위, 부호: 회전 방향)
+} RpmCalc_t;
+
+/**
+ * @brief 추정기를 초기화한다.
+ * @param clk_hz 엣지 타임스탬프 클럭 (Hz)
+ */
+void RpmCalc_Init(RpmCalc_t *st, uint32_t clk_hz);
+
+/**
+ * @brief 카운트 변화량과 시간으로 RPM을 계산한다.
+ * @param ticks 4체배 카운트 변화량 (부호 포함)
+ * @param cycles 경과 클럭 수 (0이면 0 반환)
+ * @param clk_hz 클럭 (Hz)
+ * @retval RPM (0.1 RPM 단위, 반올림)
+ */
+int32_t RpmCalc_TicksToRpmX10(int32_t ticks, uint32_t cycles, uint32_t clk_hz);
+
+/**
+ * @brief 최신 엣지 정보로 RPM 추정값을 갱신한다. 주기적으로(예: 10ms) 호출한다.
+ * @param edge_seq 엣지 시퀀스 번호 (엣지마다 1 증가)
+ * @param edge_count 마지막 엣지에서 캡처한 엔코더 카운트
+ * @param edge_cycles 마지막 엣지의 타임스탬프
+ * @param now_cycles 현재 타임스탬프
+ * @retval RPM (0.1 RPM 단위, 부호: 회전 방향)
+ */
+int32_t RpmCalc_Update(RpmCalc_t *st, uint32_t edge_seq, int16_t edge_count,
+                       uint32_t edge_cycles, uint32_t now_cycles);
+
+#endif /* INC_RPM_CALC_H_ */
@@ -10,16 +10,55 @@
 #define INC_ULTRASONIC_H_
 
 #include "main.h"
+#include "hampel_filter.h"
+#include <stdbool.h>
 
-// --- 외부 전역 변수 ---
-extern volatile uint32_t distance_front; // 측정된 전방 거리 값 (cm)
-extern volatile uint32_t distance_rear;  // 측정된 후방 거리 값 (cm)
+#define US_TRIG_WIDTH_US        10   // 트리거 펄스 폭 (µs). HC-SR04 최소 10µs
+#define US_TRIG_STAGGER_US      1000 // 전방 → 후방 트리거 하강 엣지 간격 기본값 (µs)
+#define US_TRIG_STAGGER_MIN_US  100  // 0(동시)이 아닐 때 최소 간격. 업데이트 인터럽트 처리 여유 확보
+#define US_TRIG_STAGGER_MAX_US  20000 // 후방 타임아웃 비교값이 TIM4 16비트 범위를 넘지 않도록 제한
+
+#define US_ECHO_TIMEOUT_US      30000 // 트리거 후 에코 종료까지 최대 대기 (µs). 약 5m 왕복, HC-SR04 무반사 펄스(38ms)보다 짧다
+#define US_MEAS_PERIOD_MS       60    // 측정 주기 (ms). HC-SR04 권장 최소 사이클
+#define US_MAX_AGE_MS           150   // 마지막 에코가 이보다 오래되면 유효하지 않은 값으로 본다
+#define US_MIN_CONFIDENCE       60    // 장애물 판단에 필요한 최소 필터 신뢰도 (%, 윈도우 5개 중 3개 이상 일치)
+
+#define US_ECHO_RING_SIZE       4    // 센서별 에코 링 버퍼 크기 (2의 거듭제곱)
+#define US_DEFAULT_TEMP_C_X10   200  // 온도 센서가 없을 때 사용하는 기온 (0.1°C 단위, 20.0°C)
+
+/**
+ * @brief 초음파 센서 인덱스
+ */
+typedef enum {
+    US_FRONT = 0, // 전방 (TIM4_CH1)
+    US_REAR,      // 후방 (TIM4_CH2)
+    US_SENSOR_COUNT
+} UsSensor_t;
+
+/**
+ * @brief 에코 처리 통계 (디버거 확인용)
+ */
+typedef struct {
+    uint32_t echo_count[US_SENSOR_COUNT];    // 변환된 에코 수
+    uint32_t overrun_count[US_SENSOR_COUNT]; // 읽기 전에 덮어써져 버려진 에코 수
+    uint32_t timeout_count[US_SENSOR_COUNT]; // 에코 타임아웃 수
+    uint32_t outlier_count[US_SENSOR_COUNT]; // Hampel 필터가 중앙값으로 대체한 에코 수
+    uint16_t last_width_us[US_SENSOR_COUNT]; // 마지막 에코 펄스 폭 (µs)
+} UltrasonicStats_t;
 
 /**
- * @brief 마이크로초(us) 단위의 지연을 생성한다.
- * @param us 지연시킬 시간 (마이크로초)
+ * @brief 센서별 측정 결과
  */
-void delay_us(uint16_t us);
+typedef struct {
+    uint16_t distance_mm; // 마지막 에코의 Hampel 필터 출력 거리 (mm)
+    uint16_t raw_mm;      // 마지막 에코의 필터 전 거리 (mm)
+    uint16_t spread_mm;   // 필터 윈도우의 중앙값 절대 편차 (mm)
+    uint8_t  confidence;  // 필터 신뢰도 (%, 0: 측정 없음)
+    uint16_t age_ms;      // 마지막 에코 이후 경과 시간 (ms, 에코가 없었으면 0xFFFF)
+    bool     valid;       // 마지막 측정이 에코로 끝났고 age_ms <= US_MAX_AGE_MS
+} UsReading_t;
+
+extern volatile UltrasonicStats_t g_ultrasonicStats;
 
 /**
  * @brief 초음파 센서 사용에 필요한 하드웨어를 초기화한다.
@@ -28,7 +67,34 @@ void Ultrasonic_Init(void);
 
 /**
  * @brief 초음파 센서의 거리 측정을 시작시킨다.
+ * @retval true: 트리거 시작, false: 이전 트리거 펄스가 아직 출력 중
+ */
+bool Ultrasonic_Trigger(void);
+
+/**
+ * @brief 전방 → 후방 트리거 펄스 간격(µs)을 설정한다. 0이면 동시에 트리거한다.
+ */
+void Ultrasonic_SetStagger(uint16_t stagger_us);
+
+/**
+ * @brief TIM2 업데이트 인터럽트에서 호출되어 트리거 시퀀스를 마무리한다.
+ */
+void Ultrasonic_TriggerPeriodElapsed(void);
+
+/**
+ * @brief 에코 변환과 측정 스케줄링(US_MEAS_PERIOD_MS 주기 트리거)을 수행한다. SensorTask에서 주기적으로 호출한다.
+ * @param now_ms 현재 시각 (ms)
+ */
+void Ultrasonic_Update(uint32_t now_ms);
+
+/**
+ * @brief 센서의 최신 측정 결과(필터 거리, 원시 거리, 퍼짐/신뢰도, 유효성, 경과 시간)를 반환한다.
+ */
+void Ultrasonic_GetReading(UsSensor_t sensor, uint32_t now_ms, UsReading_t *out);
+
+/**
+ * @brief 음속 보상에 사용할 기온(0.1°C 단위)을 설정한다.
  */
-void Ultrasonic_Trigger(void);
+void Ultrasonic_SetTemperature(int16_t temp_c_x10);
 
 #endif /* INC_ULTRASONIC_H_ */
@@ -0,0 +1,34 @@
+/**
+ * @file ultrasonic_calc.h
+ * @brief 초음파 에코 펄스 폭(µs)을 거리(mm)로 변환하는 정수 연산 함수를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL/RTOS에 의존하지 않는 순수 함수만 모아 두어 호스트에서 그대로 컴파일해 검증할 수 있다.
+ * Cortex-M3에는 FPU가 없으므로 float 대신 0.1 단위 고정소수점 정수를 사용한다.
+ */
+
+#ifndef INC_ULTRASONIC_CALC_H_
+#define INC_ULTRASONIC_CALC_H_
+
+#include <stdint.h>
+
+// 음속 c(m/s) = 331.3 + 0.606 * T(°C)
+#define US_SOUND_SPEED_0C_X10      3313 // 0°C 음속 (0.1 m/s 단위)
+#define US_SOUND_SPEED_SLOPE_X1000 606  // 온도 1°C당 음속 증가량 (0.001 m/s 단위)
+
+/**
+ * @brief 온도에 따른 음속을 계산한다.
+ * @param temp_c_x10 기온 (0.1°C 단위, 예: 200 = 20.0°C)
+ * @retval 음속 (0.1 m/s 단위, 반올림)
+ */
+uint16_t UltrasonicCalc_SoundSpeedX10(int16_t temp_c_x10);
+
+/**
+ * @brief 에코 펄스 폭을 거리로 변환한다.
+ * @param width_us 에코 High 구간 길이 (µs, 왕복 시간)
+ * @param temp_c_x10 기온 (0.1°C 단위)
+ * @retval 거리 (mm, 반올림). 65535µs 입력에서도 32비트 중간값 안에서 계산된다.
+ */
+uint16_t UltrasonicCalc_EchoToMm(uint16_t width_us, int16_t temp_c_x10);
+
+#endif /* INC_ULTRASONIC_CALC_H_ */
@@ -1,38 +1,166 @@
 /**
  * @file can_handler.c
- * @brief CAN 통신 메시지 전송 처리 소스 파일
+ * @brief CAN 통신 메시지 송수신 처리 소스 파일
  * @author YeonsuJ
  * @date 2025-07-26
  */
 
 #include "can_handler.h"
 #include "can.h"
+#include "can_tx.h"
+#include "can_db.h"
+#include "cmsis_os.h"
 #include <stdbool.h> 
 
 // --- 전역 변수 ---
-CAN_TxHeaderTypeDef TxHeader; // CAN 전송 메시지 헤더 구조체
-uint32_t TxMailbox;           // CAN 전송 메일박스 번호 저장 변수
 uint8_t TxData[8];            // CAN 전송 데이터 버퍼
+CanPublish_t g_canPublish;    // 0x6A5 송신 정책 상태/통계
+
+// --- 비상 프레임 상태 (SensorTask 전용) ---
+static CanDb_Emergency_t emergency_msg;  // 마지막으로 송신한 비상 프레임
+static uint32_t emergency_tx_ms = 0;     // 마지막 비상 프레임 송신 시각 (ms)
+
+// --- 주행 상태 수신 (ISR에서 쓰고 SensorTask에서 읽음) ---
+static volatile CanDb_DriveStatus_t drive_status; // 마지막으로 수신한 주행 상태 프레임
+static volatile uint32_t drive_status_rx_ms = 0;  // 마지막 주행 상태 수신 시각 (ms)
+static volatile bool drive_status_received = false; // 주행 상태를 한 번이라도 수신했는지
 
 /**
- * @brief CAN 통신과 Tx 메시지 헤더를 초기화한다.
+ * @brief 주행 상태 프레임(0x321)만 FIFO0으로 받도록 필터를 설정하고 수신 인터럽트를 활성화한다.
+ * @note 충돌 판단에서 엔코더 RPM 부호와 전진 방향의 관계를 학습하는 데 쓴다. (collision.h)
+ */
+static void CAN_Filter_Config(void)
+{
+	CAN_FilterTypeDef filter = {0};
+
+	filter.FilterBank = 0;
+	filter.FilterActivation = CAN_FILTER_ENABLE;
+	filter.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+	filter.FilterMode = CAN_FILTERMODE_IDMASK;
+	filter.FilterIdHigh = CANDB_DRIVE_STATUS_ID << 5;
+	filter.FilterMaskIdHigh = 0x7FF << 5; // 모든 비트가 일치해야 함
+	filter.FilterScale = CAN_FILTERSCALE_32BIT;
+
+	if (HAL_CAN_ConfigFilter(&hcan, &filter) != HAL_OK)
+		Error_Handler(); // 실패 시 에러 처리
+
+	if (HAL_CAN_ActivateNotification(&hcan, CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK)
+		Error_Handler(); // 실패 시 에러 처리
+}
+
+/**
+ * @brief CAN 통신과 CAN 송신 스케줄러를 초기화한다.
  */
 void CAN_tx_Init(void)
 {
+	CAN_Filter_Config(); // 주행 상태(0x321) 수신
 	HAL_CAN_Start(&hcan);
+	CanTx_Init(&hcan); // 송신 메일박스 비움 인터럽트 활성화
+	CanPublish_Init(&g_canPublish);
+}
 
-	TxHeader.DLC = 4;             // 데이터 길이 코드 (Data Length Code) = 4 Bytes
-	TxHeader.IDE = CAN_ID_STD;    // ID 타입 = 표준 ID (Standard ID)
-	TxHeader.RTR = CAN_RTR_DATA;  // 프레임 타입 = 데이터 프레임 (Data Frame)
-	TxHeader.StdId = 0x6A5;       // 표준 ID 값
+/**
+ * @brief CAN FIFO0에 메시지 수신이 보류 중일 때 호출되는 인터럽트 콜백 함수
+ * @param hcan CAN 핸들러 포인터
+ * @note ISR 컨텍스트에서 실행되며, 주행 상태 프레임을 디코딩해 수신 시각과 함께 저장한다.
+ */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+	CAN_RxHeaderTypeDef header;
+	uint8_t data[8];
+
+	if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &header, data) != HAL_OK)
+	{
+		return;
+	}
+
+	if (header.StdId == CANDB_DRIVE_STATUS_ID && header.DLC >= CANDB_DRIVE_STATUS_DLC)
+	{
+		CanDb_DriveStatus_t msg;
+
+		CanDb_DriveStatus_Unpack(data, &msg);
+		drive_status = msg;
+		drive_status_rx_ms = osKernelGetTickCount();
+		drive_status_received = true;
+	}
+}
+
+/**
+ * @brief 마지막으로 수신한 주행 상태 프레임을 가져온다.
+ * @note 수신 ISR과 찢어진 값을 읽지 않도록 짧게 인터럽트를 막고 복사한다.
+ */
+bool CAN_GetDriveStatus(CanDb_DriveStatus_t *msg, uint32_t now_ms)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	*msg = drive_status;
+	uint32_t rx_ms = drive_status_rx_ms;
+	bool received = drive_status_received;
+	__set_PRIMASK(primask);
+
+	return received && ((now_ms - rx_ms) < CAN_DRIVE_STATUS_TIMEOUT_MS);
 }
 
 /**
  * @brief 준비된 CAN TxData를 전송한다.
  * @note 이 함수는 TxData 배열에 전송할 데이터가 채워진 후 호출되어야 한다.
+ * 하드웨어 메일박스가 모두 사용 중이면 CAN 송신 스케줄러(can_tx) 큐에서 ID 우선순위대로 대기한다.
  */
 void CAN_Send(void)
 {
-    // CAN 메시지 전송 함수 호출
-    HAL_CAN_AddTxMessage(&hcan, &TxHeader, TxData, &TxMailbox);
+    // ID 0x6A5, 4바이트 (can_db.h의 SENSOR_STATUS 프레임 정의)
+    CanTx_Send(CANDB_SENSOR_STATUS_ID, TxData, CANDB_SENSOR_STATUS_DLC, CAN_SENSOR_DEADLINE_MS);
+}
+
+/**
+ * @brief 오도메트리 프레임을 인코딩하여 전송한다.
+ * @param msg 전송할 신호 값
+ * @note ID 0x6A6, 7바이트 (can_db.h의 ODOMETRY 프레임 정의). 0x6A5보다 ID가 커서 버스 중재에서 항상 양보한다.
+ */
+void CAN_SendOdometry(const CanDb_Odometry_t *msg)
+{
+    uint8_t data[CANDB_ODOMETRY_DLC];
+
+    CanDb_Odometry_Pack(msg, data);
+    CanTx_Send(CANDB_ODOMETRY_ID, data, CANDB_ODOMETRY_DLC, CAN_ODOM_PERIOD_MS);
+}
+
+/**
+ * @brief 필터 거리 프레임을 전송한다.
+ * @param msg 전송할 신호 값
+ * @note ID 0x6A7, 8바이트 (can_db.h의 RANGE 프레임 정의). 진단/표시용이므로 ID가 가장 커서 다른 프레임에 양보한다.
+ */
+void CAN_SendRange(const CanDb_Range_t *msg)
+{
+    uint8_t data[CANDB_RANGE_DLC];
+
+    CanDb_Range_Pack(msg, data);
+    CanTx_Send(CANDB_RANGE_ID, data, CANDB_RANGE_DLC, CAN_RANGE_PERIOD_MS);
+}
+
+/**
+ * @brief 비상 정지 상태를 갱신하고, 필요하면 비상 프레임을 전송한다.
+ * @note 정지 비트가 바뀌면(해제 포함) 즉시, 정지 중에는 CAN_EMERGENCY_REPEAT_MS마다 보낸다.
+ * ID 0x010은 버스에서 가장 높은 우선순위로 중재에 이기며, CAN 송신 스케줄러 큐에서도 맨 앞에 선다.
+ * 수신 측은 반복 프레임이 끊기면 정지를 해제하므로, 센서 ECU가 멈추면 차단도 풀린다.
+ */
+void CAN_UpdateEmergency(bool stop_front, bool stop_rear, uint16_t ttc_ms, uint32_t now_ms)
+{
+    bool changed = (emergency_msg.stop_front != stop_front) || (emergency_msg.stop_rear != stop_rear);
+    bool active = stop_front || stop_rear;
+
+    if (!changed && !(active && (now_ms - emergency_tx_ms) >= CAN_EMERGENCY_REPEAT_MS))
+    {
+        return;
+    }
+
+    uint8_t data[CANDB_EMERGENCY_DLC];
+
+    emergency_msg.stop_front = stop_front;
+    emergency_msg.stop_rear = stop_rear;
+    emergency_msg.ttc_ms = ttc_ms;
+    CanDb_Emergency_Pack(&emergency_msg, data);
+    CanTx_Send(CANDB_EMERGENCY_ID, data, CANDB_EMERGENCY_DLC, CAN_EMERGENCY_REPEAT_MS);
+    emergency_msg.counter++;
+    emergency_tx_ms = now_ms;
 }
@@ -0,0 +1,83 @@
+/**
+ * @file can_publish.c
+ * @brief SENSOR_STATUS 프레임의 변화 기반 송신 정책을 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ */
+
+#include "can_publish.h"
+
+void CanPublish_Init(CanPublish_t *pub)
+{
+    *pub = (CanPublish_t){0};
+    pub->cfg.heartbeat_ms = CAN_PUB_HEARTBEAT_MS;
+    pub->cfg.active_heartbeat_ms = CAN_PUB_ACTIVE_HEARTBEAT_MS;
+    pub->cfg.min_interval_ms = CAN_PUB_MIN_INTERVAL_MS;
+    pub->cfg.rpm_deadband = CAN_PUB_RPM_DEADBAND;
+}
+
+/**
+ * @brief 이산 신호 중 하나라도 바뀌었는지 확인한다.
+ */
+static bool CanPublish_DiscreteChanged(const CanDb_SensorStatus_t *a, const CanDb_SensorStatus_t *b)
+{
+    return (a->obstacle_front != b->obstacle_front) || (a->obstacle_rear != b->obstacle_rear) ||
+           (a->front_valid != b->front_valid) || (a->rear_valid != b->rear_valid) ||
+           (a->light_dark != b->light_dark);
+}
+
+/**
+ * @brief 새 샘플을 송신할지 결정한다.
+ * @note 하트비트는 마지막 송신(사유 무관)으로부터 계산하므로, 변화가 잦으면 하트비트는 나가지 않는다.
+ * 회전 중(마지막 송신 RPM ≠ 0)에는 Central ECU의 속도 제어가 측정값을 잃지 않도록 짧은 하트비트를 쓴다.
+ */
+CanPublishReason_t CanPublish_Evaluate(CanPublish_t *pub, const CanDb_SensorStatus_t *msg, uint32_t now_ms)
+{
+    CanPublishReason_t reason = CAN_PUB_NONE;
+    uint32_t since = now_ms - pub->last_tx_ms;
+
+    pub->evaluated_count++;
+
+    if (!pub->sent_once || CanPublish_DiscreteChanged(msg, &pub->last_sent))
+    {
+        reason = CAN_PUB_URGENT;
+    }
+    else
+    {
+        int32_t drpm = (int32_t)msg->motor_rpm - pub->last_sent.motor_rpm;
+        uint16_t heartbeat = (pub->last_sent.motor_rpm != 0) ? pub->cfg.active_heartbeat_ms : pub->cfg.heartbeat_ms;
+
+        if (drpm < 0) drpm = -drpm;
+
+        if (drpm >= pub->cfg.rpm_deadband && since >= pub->cfg.min_interval_ms)
+        {
+            reason = CAN_PUB_CHANGE;
+        }
+        else if (since >= heartbeat)
+        {
+            reason = CAN_PUB_HEARTBEAT;
+        }
+    }
+
+    pub->sent_count[reason]++;
+    if (reason != CAN_PUB_NONE)
+    {
+        pub->last_sent = *msg;
+        pub->last_tx_ms = now_ms;
+        pub->sent_once = true;
+        pub->tx_bits += CanPublish_FrameBits(CANDB_SENSOR_STATUS_DLC);
+    }
+
+    return reason;
+}
+
+/**
+ * @note SOF~CRC 구간 34 + 8×DLC 비트는 스터핑 대상이며, 최악의 경우 4비트마다 1비트가 추가된다.
+ * 여기에 CRC 구분자, ACK, EOF, IFS 13비트를 더한다.
+ */
+uint32_t CanPublish_FrameBits(uint8_t dlc)
+{
+    uint32_t stuffed = 34U + 8U * dlc;
+
+    return stuffed + (stuffed - 1U) / 4U + 13U;
+}
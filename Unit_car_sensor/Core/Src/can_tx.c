@@ -0,0 +1,245 @@
+/**
+ * @file can_tx.c
+ * @brief 우선순위 큐 기반 CAN 송신 스케줄러를 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 큐는 ID 오름차순으로 정렬된 작은 배열이며(삽입 정렬), 앞쪽부터 빈 하드웨어 메일박스에 적재한다.
+ * bxCAN은 TXFP=0(기본값)일 때 메일박스 사이에서도 ID 순으로 송신하므로, 소프트웨어/하드웨어 모두
+ * 버스 중재와 같은 우선순위를 따른다. 큐 조작은 짧은 인터럽트 금지 구간에서 수행한다.
+ */
+
+#include "can_tx.h"
+#include "timebase.h"
+#include <string.h>
+
+/**
+ * @brief 송신 대기 프레임
+ */
+typedef struct {
+    uint16_t std_id;
+    uint8_t  dlc;
+    uint8_t  data[8];
+    uint32_t enqueue_us;   // 큐에 들어온 시각 (대기 시간 통계용, 교체 시 유지)
+    uint32_t update_us;    // 데이터가 마지막으로 갱신된 시각 (마감 시간 기준, 교체 시 갱신)
+    uint32_t deadline_us;  // 허용 대기 시간 (0: 무제한)
+} CanTxFrame_t;
+
+volatile CanTxStats_t g_canTxStats;
+
+static CAN_HandleTypeDef *can_tx_hcan = NULL;
+static CanTxFrame_t tx_queue[CAN_TX_QUEUE_SIZE]; // std_id 오름차순
+static uint8_t tx_count = 0;
+
+/**
+ * @brief ID별 통계 슬롯을 찾는다. 없으면 빈 슬롯을 할당하고, 가득 차면 NULL을 반환한다.
+ */
+static volatile CanTxIdStats_t *CanTx_IdStats(uint16_t std_id)
+{
+    for (uint8_t i = 0; i < CAN_TX_MAX_IDS; i++)
+    {
+        volatile CanTxIdStats_t *st = &g_canTxStats.id_stats[i];
+        if (st->std_id == std_id)
+        {
+            return st;
+        }
+        if (st->std_id == 0U)
+        {
+            st->std_id = std_id;
+            return st;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 큐의 index 위치 프레임을 제거한다.
+ */
+static void CanTx_Remove(uint8_t index)
+{
+    for (uint8_t i = index; i + 1U < tx_count; i++)
+    {
+        tx_queue[i] = tx_queue[i + 1U];
+    }
+    tx_count--;
+}
+
+/**
+ * @brief 빈 하드웨어 메일박스를 큐 앞쪽(높은 우선순위) 프레임으로 채운다.
+ * @note 인터럽트 금지 상태에서 호출해야 한다.
+ */
+static void CanTx_Pump(void)
+{
+    uint32_t now_us = Timebase_GetMicros();
+
+    while (tx_count > 0U && HAL_CAN_GetTxMailboxesFreeLevel(can_tx_hcan) > 0U)
+    {
+        CanTxFrame_t *f = &tx_queue[0];
+        uint32_t age_us = now_us - f->enqueue_us;
+        volatile CanTxIdStats_t *st = CanTx_IdStats(f->std_id);
+
+        // 마감 시간은 데이터 나이로 판단한다. 교체로 갱신된 프레임은 최신 값이므로 폐기하지 않는다.
+        if (f->deadline_us != 0U && (now_us - f->update_us) > f->deadline_us)
+        {
+            // 이미 의미가 없어진 오래된 값은 버스에 싣지 않는다.
+            g_canTxStats.expired_count++;
+            if (st) st->expired_count++;
+            CanTx_Remove(0);
+            continue;
+        }
+
+        CAN_TxHeaderTypeDef header;
+        uint32_t mailbox;
+        header.StdId = f->std_id;
+        header.ExtId = 0;
+        header.IDE = CAN_ID_STD;
+        header.RTR = CAN_RTR_DATA;
+        header.DLC = f->dlc;
+        header.TransmitGlobalTime = DISABLE;
+
+        if (HAL_CAN_AddTxMessage(can_tx_hcan, &header, f->data, &mailbox) != HAL_OK)
+        {
+            g_canTxStats.hal_error_count++;
+            break; // 다음 송신 완료 인터럽트에서 다시 시도
+        }
+
+        g_canTxStats.sent_count++;
+        if (st)
+        {
+            st->sent_count++;
+            st->last_age_us = age_us;
+            if (age_us > st->max_age_us) st->max_age_us = age_us;
+        }
+        CanTx_Remove(0);
+    }
+
+    g_canTxStats.depth = tx_count;
+}
+
+void CanTx_Init(CAN_HandleTypeDef *hcan)
+{
+    can_tx_hcan = hcan;
+    tx_count = 0;
+    memset((void *)&g_canTxStats, 0, sizeof(g_canTxStats));
+
+    if (HAL_CAN_ActivateNotification(hcan, CAN_IT_TX_MAILBOX_EMPTY) != HAL_OK)
+        Error_Handler();
+}
+
+CanTxResult_t CanTx_Send(uint16_t std_id, const uint8_t *data, uint8_t dlc, uint16_t deadline_ms)
+{
+    CanTxResult_t result = CAN_TX_QUEUED;
+    uint32_t now_us = Timebase_GetMicros();
+
+    if (dlc > 8U) dlc = 8U;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    g_canTxStats.queued_count++;
+    volatile CanTxIdStats_t *st = CanTx_IdStats(std_id);
+
+    // 1. 같은 ID가 아직 송신 대기 중이면 최신 데이터로 교체
+    //    대기 시작 시각(age 통계)은 유지하고, 마감 시간은 새 데이터 기준으로 다시 시작한다.
+    for (uint8_t i = 0; i < tx_count; i++)
+    {
+        if (tx_queue[i].std_id == std_id)
+        {
+            tx_queue[i].dlc = dlc;
+            memcpy(tx_queue[i].data, data, dlc);
+            tx_queue[i].update_us = now_us;
+            tx_queue[i].deadline_us = (uint32_t)deadline_ms * 1000U;
+            if (st) st->replaced_count++;
+            result = CAN_TX_REPLACED;
+            break;
+        }
+    }
+
+    if (result == CAN_TX_QUEUED)
+    {
+        // 2. 큐가 가득 찼으면 가장 낮은 우선순위(마지막) 프레임과 비교하여 하나를 버린다.
+        if (tx_count >= CAN_TX_QUEUE_SIZE)
+        {
+            if (std_id >= tx_queue[tx_count - 1U].std_id)
+            {
+                result = CAN_TX_DROPPED;
+                g_canTxStats.dropped_count++;
+                if (st) st->dropped_count++;
+            }
+            else
+            {
+                volatile CanTxIdStats_t *victim = CanTx_IdStats(tx_queue[tx_count - 1U].std_id);
+                g_canTxStats.dropped_count++;
+                if (victim) victim->dropped_count++;
+                tx_count--;
+            }
+        }
+
+        // 3. ID 오름차순 위치에 삽입
+        if (result == CAN_TX_QUEUED)
+        {
+            uint8_t pos = tx_count;
+            while (pos > 0U && tx_queue[pos - 1U].std_id > std_id)
+            {
+                tx_queue[pos] = tx_queue[pos - 1U];
+                pos--;
+            }
+            tx_queue[pos].std_id = std_id;
+            tx_queue[pos].dlc = dlc;
+            memcpy(tx_queue[pos].data, data, dlc);
+            tx_queue[pos].enqueue_us = now_us;
+            tx_queue[pos].update_us = now_us;
+            tx_queue[pos].deadline_us = (uint32_t)deadline_ms * 1000U;
+            tx_count++;
+            if (tx_count > g_canTxStats.high_water) g_canTxStats.high_water = tx_count;
+        }
+    }
+
+    CanTx_Pump();
+
+    __set_PRIMASK(primask);
+    return result;
+}
+
+/**
+ * @brief 송신 메일박스 0/1/2 완료(또는 중단) 콜백. 빈 메일박스를 큐의 다음 프레임으로 채운다.
+ * @note ISR 컨텍스트에서 실행된다.
+ */
+static void CanTx_MailboxFreeCallback(CAN_HandleTypeDef *hcan)
+{
+    if (hcan != can_tx_hcan)
+    {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    CanTx_Pump();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief CAN 오류 콜백. 성공 없이 끝난 송신 요청(중재 패배, 송신 에러)으로 비워진 메일박스도 다시 채운다.
+ * @note 자동 재전송이 켜져 있으므로(can.c AutoRetransmission = ENABLE) 중재 패배나 송신 에러는 하드웨어가
+ * 스스로 재시도하며, HAL은 요청이 성공 없이 완료된 경우(중단 등)에만 ALST/TERR를 보고한다.
+ * hcan->ErrorCode는 HAL이 누적(OR)만 하므로, 이번 인터럽트의 오류만 세도록 읽은 뒤 HAL_CAN_ResetError로 비운다.
+ */
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)
+{
+    const uint32_t tx_errors = HAL_CAN_ERROR_TX_ALST0 | HAL_CAN_ERROR_TX_TERR0
+                             | HAL_CAN_ERROR_TX_ALST1 | HAL_CAN_ERROR_TX_TERR1
+                             | HAL_CAN_ERROR_TX_ALST2 | HAL_CAN_ERROR_TX_TERR2;
+
+    if (hcan->ErrorCode & tx_errors)
+    {
+        g_canTxStats.bus_error_count++;
+    }
+    HAL_CAN_ResetError(hcan);
+    CanTx_MailboxFreeCallback(hcan);
+}
+
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan) { CanTx_MailboxFreeCallback(hcan); }
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan) { CanTx_MailboxFreeCallback(hcan); }
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan) { CanTx_MailboxFreeCallback(hcan); }
+void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan) { CanTx_MailboxFreeCallback(hcan); }
+void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan) { CanTx_MailboxFreeCallback(hcan); }
+void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan) { CanTx_MailboxFreeCallback(hcan); }
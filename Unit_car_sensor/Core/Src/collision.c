@@ -0,0 +1,156 @@
+/**
+ * @file collision.c
+ * @brief 접근 속도와 충돌 예상 시간(TTC) 계산을 정수 연산으로 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ */
+
+#include "collision.h"
+
+void Collision_Init(CollisionTrack_t *trk)
+{
+    *trk = (CollisionTrack_t){0};
+    trk->ttc_ms = COLL_TTC_NONE;
+}
+
+/**
+ * @brief 새 측정과 바퀴 속도로 접근 속도, TTC, 정지 여부를 갱신한다.
+ * @note 새 측정은 측정 시각(now - age)이 마지막으로 본 측정 시각과 달라진 것으로 판단한다.
+ * 거리 변화율은 직전 값과 1:1 평균하고, COLL_RANGE_RATE_MAX_MM_S를 넘는 변화는 튀는 에코로 보고 한 번 버린다.
+ * 연속 두 번 넘으면 장면 변화로 보고 그 거리를 새 기준으로 삼는다.
+ * 새 기준(첫 측정, 장면 변화)은 변화율 게이트를 통과한 다음 측정이 와야 확인되며, 그 전에는 정지하지 않는다.
+ */
+bool Collision_Update(CollisionTrack_t *trk, uint16_t distance_mm, uint16_t age_ms, bool valid,
+                      int32_t wheel_mm_s, uint32_t now_ms)
+{
+    if (!valid)
+    {
+        Collision_Init(trk);
+        return false;
+    }
+
+    uint32_t meas_ms = now_ms - age_ms;
+    if (!trk->has_last)
+    {
+        trk->has_last = true;
+        trk->last_mm = distance_mm;
+        trk->last_meas_ms = meas_ms;
+        trk->seen_meas_ms = meas_ms;
+    }
+    else if (meas_ms != trk->seen_meas_ms)
+    {
+        trk->seen_meas_ms = meas_ms;
+
+        int32_t dt_ms = (int32_t)(meas_ms - trk->last_meas_ms);
+        int32_t rate = (((int32_t)trk->last_mm - distance_mm) * 1000) / dt_ms;
+
+        bool implausible = (rate > COLL_RANGE_RATE_MAX_MM_S) || (rate < -COLL_RANGE_RATE_MAX_MM_S);
+
+        if (implausible && !trk->rejected)
+        {
+            // 물리적으로 불가능한 변화는 튀는 에코로 보고 한 번 버린다. 기준 측정은 유지한다.
+            trk->rejected = true;
+        }
+        else if (implausible)
+        {
+            // 연속 두 번 벗어나면 실제 장면 변화(물체 등장/사라짐)로 보고 새 기준으로 삼는다.
+            trk->rejected = false;
+            trk->confirmed = false;
+            trk->range_rate = 0;
+            trk->last_mm = distance_mm;
+            trk->last_meas_ms = meas_ms;
+        }
+        else
+        {
+            trk->rejected = false;
+            trk->confirmed = true;
+            trk->range_rate = (trk->range_rate + rate) / 2;
+            trk->last_mm = distance_mm;
+            trk->last_meas_ms = meas_ms;
+        }
+    }
+
+    int32_t closing = (trk->range_rate > wheel_mm_s) ? trk->range_rate : wheel_mm_s;
+    trk->closing_mm_s = closing;
+
+    // 마지막으로 채택한 측정 이후 접근한 거리만큼 현재 거리를 외삽한다. (버린 측정은 쓰지 않는다)
+    int32_t dist = (int32_t)trk->last_mm;
+    if (closing > 0)
+    {
+        dist -= (closing * (int32_t)(now_ms - trk->last_meas_ms)) / 1000;
+        if (dist < 0) dist = 0;
+    }
+
+    if (closing < COLL_CLOSING_MIN_MM_S)
+    {
+        trk->ttc_ms = COLL_TTC_NONE;
+        // 근접 상태에서 멈춰 있으면 멀어지기 전까지 정지를 유지한다. (다시 가속해 밀고 들어가는 것 방지)
+        trk->stop = trk->confirmed && (dist <= COLL_STOP_DIST_MM) && (closing > -COLL_CLOSING_MIN_MM_S);
+        return trk->stop;
+    }
+
+    int32_t ttc = (dist * 1000) / closing;
+    trk->ttc_ms = (ttc >= (int32_t)COLL_TTC_NONE) ? (uint16_t)(COLL_TTC_NONE - 1) : (uint16_t)ttc;
+    // 확인되지 않은 새 추적의 기준 거리는 튀는 에코일 수 있으므로 정지하지 않는다. (TTC는 그대로 보고)
+    trk->stop = trk->confirmed && ((trk->ttc_ms < COLL_TTC_STOP_MS) || (dist <= COLL_STOP_DIST_MM));
+
+    return trk->stop;
+}
+
+void Collision_SignInit(CollisionWheelSign_t *ws)
+{
+    *ws = (CollisionWheelSign_t){0};
+}
+
+/**
+ * @brief 주행 방향 명령과 엔코더 RPM으로 RPM 부호 → 전진 방향을 학습한다.
+ * @note 후보 부호 = RPM 부호 × 명령 방향(전진 +1, 후진 -1)이다.
+ * 명령이 바뀐 직후에는 모터가 이전 방향으로 관성 회전하므로 COLL_SIGN_SETTLE_MS 동안 판단하지 않고,
+ * 같은 후보가 COLL_SIGN_CONFIRM_COUNT번 연속 나와야 확정한다. 한 번 확정하면 배선은 바뀌지 않으므로 고정하고,
+ * 이후 반대 후보는 mismatch_count로만 센다.
+ */
+int8_t Collision_SignUpdate(CollisionWheelSign_t *ws, bool cmd_valid, bool cmd_forward, int32_t rpm_x10,
+                            uint32_t now_ms)
+{
+    if (!cmd_valid)
+    {
+        ws->run = 0;
+        return ws->sign;
+    }
+
+    if (!ws->has_dir || (ws->last_forward != cmd_forward))
+    {
+        ws->has_dir = true;
+        ws->last_forward = cmd_forward;
+        ws->dir_change_ms = now_ms;
+        ws->run = 0;
+    }
+
+    if (((now_ms - ws->dir_change_ms) < COLL_SIGN_SETTLE_MS) ||
+        ((rpm_x10 < COLL_SIGN_MIN_RPM_X10) && (rpm_x10 > -COLL_SIGN_MIN_RPM_X10)))
+    {
+        return ws->sign;
+    }
+
+    int8_t candidate = (int8_t)(((rpm_x10 > 0) == cmd_forward) ? 1 : -1);
+
+    if (ws->sign != 0)
+    {
+        if (candidate != ws->sign)
+        {
+            ws->mismatch_count++;
+        }
+        return ws->sign;
+    }
+
+    if (candidate != ws->run_sign)
+    {
+        ws->run_sign = candidate;
+        ws->run = 0;
+    }
+    if (++ws->run >= COLL_SIGN_CONFIRM_COUNT)
+    {
+        ws->sign = candidate;
+    }
+    return ws->sign;
+}
@@ -26,8 +26,11 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "can_handler.h"
+#include "can_db.h"
 #include "ultrasonic.h"
 #include "motor_encoder.h"
+#include "odometry.h"
+#include "collision.h"
 #include "tim.h"
 /* USER CODE END Includes */
 
@@ -138,7 +141,13 @@ void StartSensorTask(void *argument)
   /* USER CODE BEGIN StartSensorTask */
 	// --- SensorTask 초기화 ---
 	Ultrasonic_Init(); // 초음파 센서 관련 타이머(TIM2, TIM4)를 초기화하고 시작한다.
-	HAL_TIM_Encoder_Start(&htim1, TIM_CHANNEL_ALL); // 엔코더 입력을 위한 타이머(TIM1)를 시작한다.
+	MotorEncoder_Init(); // 엔코더 입력을 위한 타이머(TIM1)와 엣지 캡처 인터럽트를 시작한다.
+
+	CollisionTrack_t coll_front, coll_rear; // 전/후방 접근 속도 및 TTC 추적 상태
+	Collision_Init(&coll_front);
+	Collision_Init(&coll_rear);
+	CollisionWheelSign_t wheel_sign; // 엔코더 RPM 부호 → 전진 방향 학습 상태
+	Collision_SignInit(&wheel_sign);
 
 	// osDelayUntil을 사용하기 위한 변수
 	uint32_t last_wake_time = osKernelGetTickCount();
@@ -153,19 +162,45 @@ void StartSensorTask(void *argument)
 
 	    // 센서 데이터 수집
 	    Update_Motor_RPM();   // 엔코더 값을 읽어 RPM을 계산한다.
-	    Ultrasonic_Trigger(); // 초음파 센서 거리 측정을 시작한다.
+	    uint32_t now_ms = osKernelGetTickCount();
+	    Ultrasonic_Update(now_ms); // 에코를 거리(mm)로 변환하고, 60ms 주기로 다음 측정을 트리거한다.
 
 	    SensorData_t sensor_packet; // CANTask로 전송할 데이터 패킷 구조체
 
 	    // 데이터 패킷 채우기
 	    sensor_packet.light_condition = HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_3); // 조도 센서 값(GPIO)을 읽는다.
-	    sensor_packet.rpm = MotorControl_GetRPM(); // 계산된 RPM 값을 가져온다.
-
-	    // ISR(ultrasonic.c의 콜백 함수)에서 변경되는 전역 변수에 안전하게 접근하기 위해 Critical Section으로 보호한다.
-	    taskENTER_CRITICAL();
-	    sensor_packet.distance_front = distance_front; // 전방 거리 값을 복사한다.
-	    sensor_packet.distance_rear = distance_rear;   // 후방 거리 값을 복사한다.
-	    taskEXIT_CRITICAL();
+	    sensor_packet.rpm_x10 = MotorEncoder_GetRpmX10(); // 계산된 RPM 값(부호 포함)을 가져온다.
+	    sensor_packet.travel_mm = MotorEncoder_GetTravelMm(); // 누적 주행 거리를 가져온다.
+
+	    // 거리 값은 이 태스크의 Ultrasonic_Update()에서만 갱신되므로 Critical Section이 필요 없다.
+	    UsReading_t front, rear;
+	    Ultrasonic_GetReading(US_FRONT, now_ms, &front);
+	    Ultrasonic_GetReading(US_REAR, now_ms, &rear);
+	    sensor_packet.distance_front_mm = front.distance_mm;
+	    sensor_packet.front_spread_mm = front.spread_mm;
+	    sensor_packet.front_confidence = front.confidence;
+	    sensor_packet.front_age_ms = front.age_ms;
+	    sensor_packet.front_valid = front.valid;
+	    sensor_packet.distance_rear_mm = rear.distance_mm;
+	    sensor_packet.rear_spread_mm = rear.spread_mm;
+	    sensor_packet.rear_confidence = rear.confidence;
+	    sensor_packet.rear_age_ms = rear.age_ms;
+	    sensor_packet.rear_valid = rear.valid;
+
+	    // 충돌 예상 시간(TTC)을 계산하고, 정지 상태가 바뀌거나 유지 중이면 비상 프레임(0x010)을 바로 보낸다.
+	    // CANTask의 큐/정책을 거치지 않으므로 측정 → 송신 요청 지연이 이 태스크 안에서 끝난다.
+	    // 충돌 추적기는 자체 변화율 게이트(튀는 값 1회 폐기)가 있으므로, 중앙값 필터 지연(최대 2측정) 없이 필터 전 거리를 쓴다.
+	    // 바퀴 속도의 전진 방향 부호는 중앙 ECU의 방향 명령(0x321)과 실제 회전 방향을 비교해 학습한다.
+	    // 확정 전(부호 0)에는 바퀴 속도 항이 0이 되어 거리 변화율만으로 판단한다.
+	    CanDb_DriveStatus_t drive;
+	    bool cmd_valid = CAN_GetDriveStatus(&drive, now_ms) && drive.rf_ok && !drive.brake;
+	    int8_t wheel_sign_now = Collision_SignUpdate(&wheel_sign, cmd_valid, drive.direction != 0,
+	                                                 sensor_packet.rpm_x10, now_ms);
+	    int32_t wheel_mm_s = wheel_sign_now * Odometry_RpmX10ToMmPerS(sensor_packet.rpm_x10);
+	    Collision_Update(&coll_front, front.raw_mm, front.age_ms, front.valid, wheel_mm_s, now_ms);
+	    Collision_Update(&coll_rear, rear.raw_mm, rear.age_ms, rear.valid, -wheel_mm_s, now_ms);
+	    uint16_t ttc_ms = (coll_front.ttc_ms < coll_rear.ttc_ms) ? coll_front.ttc_ms : coll_rear.ttc_ms;
+	    CAN_UpdateEmergency(coll_front.stop, coll_rear.stop, ttc_ms, now_ms);
 
 	    // 채워진 데이터 패킷을 큐(CANTxQueueHandle)로 전송한다.
 	    osMessageQueuePut(CANTxQueueHandle, &sensor_packet, 0, 0);
@@ -176,7 +211,8 @@ void StartSensorTask(void *argument)
 /* USER CODE BEGIN Header_StartCANTask */
 /**
 * @brief CANTask는 SensorTask로부터 큐를 통해 데이터를 수신하고, 이를 가공하여 CAN 버스로 전송하는 역할을 한다.
-* @note 큐에 데이터가 들어올 때까지 대기(Block)하며, 수신된 데이터를 CAN 프로토콜에 맞는 형식으로 변환하여 송신한다.
+* @note 큐에 데이터가 들어올 때까지 대기(Block)하며, 수신된 데이터를 CAN 프로토콜에 맞는 형식으로 변환한다.
+* 0x6A5는 매 샘플이 아니라 송신 정책(can_publish)이 결정한 경우에만 보낸다. (이산 신호 변화 즉시, RPM 데드밴드 초과, 하트비트)
 */
 /* USER CODE END Header_StartCANTask */
 void StartCANTask(void *argument)
@@ -186,6 +222,9 @@ void StartCANTask(void *argument)
     CAN_tx_Init(); // CAN 통신 및 Tx 메시지 헤더를 초기화한다.
 
     SensorData_t received_packet; // SensorTask로부터 받을 데이터 패킷 구조체
+    CanDb_Odometry_t odom = {0};  // 오도메트리 프레임 신호 (counter는 전송마다 증가)
+    uint32_t last_odom_tick = osKernelGetTickCount();
+    uint32_t last_range_tick = last_odom_tick;
 
     /* Infinite loop */
     for(;;)
@@ -193,32 +232,56 @@ void StartCANTask(void *argument)
 			// 큐(CANTxQueue)에 데이터가 들어올 때까지 무한정 대기한다.
 			if (osMessageQueueGet(CANTxQueueHandle, &received_packet, NULL, osWaitForever) == osOK)
 			{
-        // --- 수신된 데이터를 CAN 전송 형식에 맞게 가공 ---
-
-				// 1. 장애물 상태 데이터를 1바이트 비트마스크로 가공한다.
-				uint8_t obstacle_status = 0; // 0으로 초기화 (장애물 없음)
-
-				if (received_packet.distance_front <= 10) // 전방 10cm 이내에 장애물 감지 시
+        // --- 수신된 데이터를 CAN 신호(can_db.h, SENSOR_STATUS)로 변환 ---
+				CanDb_SensorStatus_t msg;
+
+				// 1. 전방/후방 10cm(100mm) 이내 장애물 감지 여부. 유효하지 않은 값으로는 판단하지 않고 valid 비트로 알린다.
+				//    필터 거리를 쓰고, 윈도우가 덜 찼거나 값이 흩어져 신뢰도가 낮으면 장애물로 판단하지 않는다.
+				msg.obstacle_front = received_packet.front_valid && (received_packet.front_confidence >= US_MIN_CONFIDENCE) &&
+				                     (received_packet.distance_front_mm <= 100);
+				msg.obstacle_rear = received_packet.rear_valid && (received_packet.rear_confidence >= US_MIN_CONFIDENCE) &&
+				                    (received_packet.distance_rear_mm <= 100);
+				msg.front_valid = received_packet.front_valid;
+				msg.rear_valid = received_packet.rear_valid;
+
+				// 2. 조도 센서 상태 (SET이면 1, RESET이면 0)
+				msg.light_dark = (received_packet.light_condition == GPIO_PIN_SET);
+
+				// 3. 0.1 RPM 단위 값을 부호 있는 정수 RPM으로 반올림 (부호: 회전 방향)
+				msg.motor_rpm = (int16_t)((received_packet.rpm_x10 + ((received_packet.rpm_x10 >= 0) ? 5 : -5)) / 10);
+
+				// 송신 정책이 보내기로 결정한 경우에만 인코딩하여 CAN 버스로 전송한다.
+				uint32_t now = osKernelGetTickCount();
+				if (CanPublish_Evaluate(&g_canPublish, &msg, now) != CAN_PUB_NONE)
 				{
-					obstacle_status |= (1 << 0); // 0번 비트를 1로 세팅한다. (값: 1)
+					CanDb_SensorStatus_Pack(&msg, TxData);
+					CAN_Send();
 				}
-				if (received_packet.distance_rear <= 10) // 후방 10cm 이내에 장애물 감지 시
+
+				// 4. CAN_ODOM_PERIOD_MS마다 오도메트리 프레임(누적 거리, 선속도)을 전송한다.
+				if ((now - last_odom_tick) >= CAN_ODOM_PERIOD_MS)
 				{
-					obstacle_status |= (1 << 1); // 1번 비트를 1로 세팅한다. (값: 2)
+					last_odom_tick = now;
+					odom.travel_mm = received_packet.travel_mm;
+					odom.speed_mm_s = (int16_t)Odometry_RpmX10ToMmPerS(received_packet.rpm_x10);
+					CAN_SendOdometry(&odom);
+					odom.counter++;
 				}
-				TxData[0] = obstacle_status; // 최종 계산된 값을 TxData[0]에 할당한다.
 
-				// 2. 조도 센서 상태를 1바이트로 가공한다 (SET이면 1, RESET이면 0)
-				TxData[1] = (received_packet.light_condition == GPIO_PIN_SET);
-
-				// 3. float 타입의 RPM 값을 2바이트 정수형으로 변환하여 저장한다.
-				uint16_t rpm_value = (uint16_t)received_packet.rpm;
-				// 하위 8비트(LSB)와 상위 8비트(MSB)로 분리한다.
-				TxData[2] = (uint8_t)(rpm_value & 0x00FF);      // LSB
-				TxData[3] = (uint8_t)((rpm_value >> 8) & 0x00FF); // MSB
-
-				// 가공된 데이터가 담긴 TxData 배열을 CAN 버스로 전송한다.
-				CAN_Send();
+				// 5. CAN_RANGE_PERIOD_MS마다 필터 거리와 퍼짐/신뢰도를 전송한다. (퍼짐은 8비트에서 포화)
+				if ((now - last_range_tick) >= CAN_RANGE_PERIOD_MS)
+				{
+					CanDb_Range_t range;
+
+					last_range_tick = now;
+					range.front_mm = received_packet.distance_front_mm;
+					range.rear_mm = received_packet.distance_rear_mm;
+					range.front_spread_mm = (received_packet.front_spread_mm > UINT8_MAX) ? UINT8_MAX : (uint8_t)received_packet.front_spread_mm;
+					range.rear_spread_mm = (received_packet.rear_spread_mm > UINT8_MAX) ? UINT8_MAX : (uint8_t)received_packet.rear_spread_mm;
+					range.front_confidence = received_packet.front_confidence;
+					range.rear_confidence = received_packet.rear_confidence;
+					CAN_SendRange(&range);
+				}
       }
     }
   /* USER CODE END StartCANTask */
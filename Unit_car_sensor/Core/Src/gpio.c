@@ -49,16 +49,6 @@ void MX_GPIO_Init(void)
   __HAL_RCC_GPIOB_CLK_ENABLE();
   __HAL_RCC_GPIOA_CLK_ENABLE();
 
-  /*Configure GPIO pin Output Level */
-  HAL_GPIO_WritePin(GPIOB, Rear_Trig_Pin|Front_Trig_Pin, GPIO_PIN_RESET);
-
-  /*Configure GPIO pins : Rear_Trig_Pin Front_Trig_Pin */
-  GPIO_InitStruct.Pin = Rear_Trig_Pin|Front_Trig_Pin;
-  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-  GPIO_InitStruct.Pull = GPIO_NOPULL;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-  HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-
   /*Configure GPIO pin : LDR_IN_Pin */
   GPIO_InitStruct.Pin = LDR_IN_Pin;
   GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
@@ -0,0 +1,166 @@
+/**
+ * @file hampel_filter.c
+ * @brief 정렬 윈도우 기반의 증분 중앙값/Hampel 필터를 정수 연산으로 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ */
+
+#include "hampel_filter.h"
+
+void HampelFilter_Init(HampelFilter_t *f)
+{
+    *f = (HampelFilter_t){0};
+}
+
+/**
+ * @brief a[0..n)에서 v 이상인 첫 인덱스를 찾는다. (이진 탐색)
+ */
+static uint8_t HampelFilter_LowerBound(const uint16_t *a, uint8_t n, uint32_t v)
+{
+    uint8_t lo = 0, hi = n;
+
+    while (lo < hi)
+    {
+        uint8_t mid = (uint8_t)((lo + hi) / 2);
+        if (a[mid] < v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief a[0..n)에서 v보다 큰 첫 인덱스를 찾는다. (이진 탐색)
+ */
+static uint8_t HampelFilter_UpperBound(const uint16_t *a, uint8_t n, uint32_t v)
+{
+    uint8_t lo = 0, hi = n;
+
+    while (lo < hi)
+    {
+        uint8_t mid = (uint8_t)((lo + hi) / 2);
+        if (a[mid] <= v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief 가장 오래된 샘플을 새 샘플로 바꾸며 정렬을 유지한다.
+ * @note 지울 값의 위치를 이진 탐색으로 찾고, 그 자리에서 새 값 쪽으로 순위가 바뀐 만큼만 원소를 민다.
+ */
+static void HampelFilter_Replace(HampelFilter_t *f, uint16_t old_mm, uint16_t mm)
+{
+    uint16_t *s = f->sorted;
+    uint8_t i = HampelFilter_LowerBound(s, HAMPEL_WINDOW, old_mm);
+
+    if (mm > old_mm)
+    {
+        while ((i + 1 < HAMPEL_WINDOW) && (s[i + 1] < mm))
+        {
+            s[i] = s[i + 1];
+            i++;
+        }
+    }
+    else
+    {
+        while ((i > 0) && (s[i - 1] > mm))
+        {
+            s[i] = s[i - 1];
+            i--;
+        }
+    }
+    s[i] = mm;
+}
+
+/**
+ * @brief 정렬 윈도우에서 중앙값 절대 편차(MAD)를 구한다.
+ * @param m 중앙값 인덱스
+ * @note 중앙값 왼쪽 편차 A[i] = med - s[m - i] (i = 0..m, A[0] = 0)와
+ * 오른쪽 편차 B[j] = s[m + 1 + j] - med는 각각 오름차순이므로,
+ * 두 정렬 배열에서 (count - 1) / 2번째 값을 이진 탐색으로 찾는다.
+ */
+static uint16_t HampelFilter_Mad(const HampelFilter_t *f, uint8_t m)
+{
+    const uint16_t *s = f->sorted;
+    uint16_t med = s[m];
+    int8_t a_len = (int8_t)(m + 1);
+    int8_t b_len = (int8_t)(f->count - 1 - m);
+    int8_t k = (int8_t)((f->count - 1) / 2); // 0부터 센 순위
+    int8_t lo = (k + 1 - b_len > 0) ? (int8_t)(k + 1 - b_len) : 0;
+    int8_t hi = (a_len < k + 1) ? a_len : (int8_t)(k + 1);
+
+    // A에서 i개, B에서 j = k + 1 - i개를 가져와 A[i-1] <= B[j], B[j-1] <= A[i]를 만족하는 i를 찾는다.
+    while (lo <= hi)
+    {
+        int8_t i = (int8_t)((lo + hi) / 2);
+        int8_t j = (int8_t)(k + 1 - i);
+
+        if ((i < a_len) && (j > 0) && ((uint16_t)(s[m + j] - med) > (uint16_t)(med - s[m - i])))
+        {
+            lo = (int8_t)(i + 1);
+        }
+        else if ((i > 0) && (j < b_len) && ((uint16_t)(med - s[m - i + 1]) > (uint16_t)(s[m + 1 + j] - med)))
+        {
+            hi = (int8_t)(i - 1);
+        }
+        else
+        {
+            uint16_t a_last = (i > 0) ? (uint16_t)(med - s[m - i + 1]) : 0;
+            uint16_t b_last = (j > 0) ? (uint16_t)(s[m + j] - med) : 0;
+            return (a_last > b_last) ? a_last : b_last;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 새 샘플을 넣고 중앙값, MAD, 신뢰도, 출력을 갱신한다.
+ * @note 새 샘플도 윈도우에 포함한 뒤 판단한다. (인과적 Hampel 필터)
+ * 중앙값은 윈도우의 절반 미만이 이상값이면 영향을 받지 않으므로 HAMPEL_WINDOW = 5에서 연속 2개까지 걸러낸다.
+ */
+uint16_t HampelFilter_Push(HampelFilter_t *f, uint16_t mm)
+{
+    if (f->count < HAMPEL_WINDOW)
+    {
+        // 채우는 중: 뒤에서부터 삽입 정렬
+        uint8_t i = f->count;
+        while ((i > 0) && (f->sorted[i - 1] > mm))
+        {
+            f->sorted[i] = f->sorted[i - 1];
+            i--;
+        }
+        f->sorted[i] = mm;
+        f->count++;
+    }
+    else
+    {
+        HampelFilter_Replace(f, f->ring[f->head], mm);
+    }
+    f->ring[f->head] = mm;
+    f->head = (uint8_t)((f->head + 1) % HAMPEL_WINDOW);
+    f->sample_count++;
+
+    uint8_t m = (uint8_t)((f->count - 1) / 2);
+    uint16_t med = f->sorted[m];
+    uint16_t mad = HampelFilter_Mad(f, m);
+    uint32_t thr = ((uint32_t)mad * HAMPEL_K_X10 * HAMPEL_MAD_TO_SIGMA_X1000) / 10000U;
+    if (thr < HAMPEL_MIN_THRESHOLD_MM) thr = HAMPEL_MIN_THRESHOLD_MM;
+
+    // 임계값 안의 샘플 수 / 윈도우 크기. 채우는 중이거나 값이 흩어져 있으면 낮아진다.
+    uint8_t in_lo = HampelFilter_LowerBound(f->sorted, f->count, (med > thr) ? (med - thr) : 0U);
+    uint8_t in_hi = HampelFilter_UpperBound(f->sorted, f->count, med + thr);
+
+    uint16_t dev = (mm > med) ? (uint16_t)(mm - med) : (uint16_t)(med - mm);
+
+    f->median_mm = med;
+    f->mad_mm = mad;
+    f->confidence = (uint8_t)(((in_hi - in_lo) * 100U) / HAMPEL_WINDOW);
+    f->outlier = (f->count >= HAMPEL_MIN_SAMPLES) && (dev > thr);
+    if (f->outlier)
+    {
+        f->outlier_count++;
+    }
+    f->output_mm = f->outlier ? med : mm;
+
+    return f->output_mm;
+}
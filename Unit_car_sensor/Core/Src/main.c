@@ -28,6 +28,7 @@
 #include "can_handler.h"
 #include "ultrasonic.h"
 #include "motor_encoder.h"
+#include "timebase.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -97,8 +98,8 @@ int main(void)
   MX_TIM4_Init();
   MX_TIM1_Init();
   /* USER CODE BEGIN 2 */
-  // RPM 계산에 사용할 정밀 타이머(DWT)를 초기화한다.
-  DWT_Init(); 
+  // RPM 계산 등에 사용할 µs 타임베이스(DWT)를 초기화한다.
+  Timebase_Init();
   /* USER CODE END 2 */
 
   /* Init scheduler */
@@ -184,6 +185,10 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
+  if (htim->Instance == TIM2)
+  {
+    Ultrasonic_TriggerPeriodElapsed(); // 초음파 트리거 1주기(전방 펄스) 종료
+  }
 
   /* USER CODE END Callback 1 */
 }
@@ -3,80 +3,95 @@
  * @brief DC 모터 엔코더를 이용한 RPM 측정 소스 파일이다.
  * @author YeonsuJ
  * @date 2025-07-25
+ * @note TIM1 엔코더 모드에서 CH1 캡처를 켜 두면 A상 상승 엣지마다 CCR1에 그 순간의 엔코더 카운트가 래치된다.
+ * 캡처 인터럽트에서 이 카운트와 DWT 타임스탬프를 기록하고, 10ms 주기의 Update_Motor_RPM()이
+ * rpm_calc의 M/T 방식으로 RPM을 추정한다. 10ms 창의 카운트 차분(1틱 ≈ 8.8 RPM) 대신
+ * 엣지 간 실제 시간을 쓰므로 저속에서도 0이나 큰 떨림 없이 측정되며, 별도의 IIR 필터가 필요 없다.
+ * 같은 주기에 odometry 모듈로 16비트 카운터를 64비트 위치/이동량으로 확장한다.
  */
 
-#include <math.h>
 #include "motor_encoder.h"
 #include "tim.h"
-
-// --- 상수 정의 ---
-#define PPR 8                    // 모터 엔코더의 한 회전당 펄스 수 (Pulse Per Revolution)
-#define GEAR_RATIO 21.3f         // 감속 기어비
-#define TICKS_PER_REV (PPR * GEAR_RATIO * 4) // 한 바퀴 회전당 발생하는 총 틱 수 (4배수 모드 사용)
-#define RPM_FILTER_ALPHA 0.3f    // 저주파 통과 필터 계수 (0.0 ~ 1.0). 값이 클수록 반응이 빠르다.
+#include "timebase.h"
+#include "rpm_calc.h"
+#include "odometry.h"
 
 // --- 타이머 핸들 ---
 extern TIM_HandleTypeDef htim1; // DC 모터 엔코더 입력을 위한 타이머 핸들
 
 // --- static 변수 ---
-static float motor_rpm = 0.0f;     // 필터링된 최종 RPM 값을 저장하는 변수
-static float filtered_rpm = 0.0f;  // 저주파 통과 필터의 내부 계산을 위한 변수
+static volatile uint32_t edge_seq = 0;    // 캡처 엣지 수 (ISR에서 증가)
+static volatile uint32_t edge_cycles = 0; // 마지막 엣지의 DWT 타임스탬프
+static volatile int16_t edge_count = 0;   // 마지막 엣지에서 래치된 엔코더 카운트
+static RpmCalc_t rpm_calc;                // M/T 추정기 상태
+static int32_t motor_rpm_x10 = 0;         // 최종 RPM (0.1 RPM 단위, 부호: 회전 방향)
+static Odometry_t odometry;               // 확장 위치/누적 이동량 (SensorTask에서만 접근)
 
 /**
- * @brief DWT Cycle Counter를 활성화하여 초정밀 타이머로 사용한다.
- * @note 이 함수는 HAL_Init() 이후, RTOS 스케줄러 시작 전에 한 번만 호출해야 한다.
+ * @brief 엔코더 타이머와 A상 엣지 캡처 인터럽트를 시작한다.
  */
-void DWT_Init(void)
+void MotorEncoder_Init(void)
 {
-    // DWT 기능 활성화
-    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
-    // Cycle Counter 활성화
-    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
-    // Cycle Counter 리셋
-    DWT->CYCCNT = 0;
+    RpmCalc_Init(&rpm_calc, SystemCoreClock);
+    Odometry_Init(&odometry, (uint16_t)__HAL_TIM_GET_COUNTER(&htim1));
+
+    HAL_TIM_Encoder_Start(&htim1, TIM_CHANNEL_ALL); // 엔코더 카운트 시작 (CC1E/CC2E 캡처도 활성화된다)
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_CC1);
+    __HAL_TIM_ENABLE_IT(&htim1, TIM_IT_CC1);        // A상 상승 엣지 캡처 인터럽트
 }
 
 /**
- * @brief 주기적으로 호출되어 엔코더 카운트 변화량과 경과 시간을 바탕으로 RPM을 계산한다.
- * @note 저주파 통과 필터(IIR)를 적용하여 RPM 값을 부드럽게 처리한다.
+ * @brief 엔코더 A상 엣지 캡처를 기록한다. (ISR 전용, HAL_TIM_IC_CaptureCallback에서 호출)
+ * @note 타임스탬프는 ISR 진입 지연만큼 늦지만, 같은 우선순위 ISR들이 짧으므로 수 µs 이내이다.
  */
-void Update_Motor_RPM(void)
+void MotorEncoder_CaptureCallback(void)
 {
-    static int16_t last_encoder_count = 0;   // 이전 엔코더 카운터 값
-    static uint32_t last_cycle_count = 0;    // 이전 DWT 사이클 카운트 값
-
-    uint32_t current_cycle_count = DWT->CYCCNT;
-    int16_t current_encoder_count = (int16_t)__HAL_TIM_GET_COUNTER(&htim1);
-
-    // 경과 시간 및 엔코더 변화량 계산
-    uint32_t delta_cycles = current_cycle_count - last_cycle_count;
-    int16_t delta_encoder = current_encoder_count - last_encoder_count;
+    edge_count = (int16_t)htim1.Instance->CCR1;
+    edge_cycles = Timebase_GetCycles();
+    edge_seq++;
+}
 
-    // 다음 측정을 위해 현재 값 저장
-    last_encoder_count = current_encoder_count;
-    last_cycle_count = current_cycle_count;
+/**
+ * @brief 주기적으로 호출되어 마지막 엣지 정보로 RPM을, 현재 카운터로 위치와 이동량을 갱신한다.
+ * @note 카운터 확장을 위해 32767틱(약 48바퀴) 이동 전에 다시 호출되어야 한다. (10ms 주기면 충분)
+ */
+void Update_Motor_RPM(void)
+{
+    // ISR이 세 값을 갱신하는 도중에 읽지 않도록 짧게 인터럽트를 막고 복사한다.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t seq = edge_seq;
+    uint32_t cycles = edge_cycles;
+    int16_t count = edge_count;
+    __set_PRIMASK(primask);
 
-    // 경과 시간(초) 계산
-    float delta_time_s = (float)delta_cycles / (float)SystemCoreClock;
+    motor_rpm_x10 = RpmCalc_Update(&rpm_calc, seq, count, cycles, Timebase_GetCycles());
+    Odometry_Update(&odometry, (uint16_t)__HAL_TIM_GET_COUNTER(&htim1));
+}
 
-    if (delta_time_s > 0)
-    {
-        // 1. 실제 경과 시간을 이용해 정확한 RPM 계산
-        float pps = (float)delta_encoder / delta_time_s; // Pulses Per Second
-        float raw_rpm = (pps / TICKS_PER_REV) * 60.0f;
+/**
+ * @brief 현재 모터 RPM을 반환한다.
+ * @retval 0.1 RPM 단위 RPM. 양수/음수는 엔코더 카운트 증가/감소 방향이다.
+ */
+int32_t MotorEncoder_GetRpmX10(void)
+{
+    return motor_rpm_x10;
+}
 
-        // 2. 저주파 통과 필터(IIR) 적용하여 값을 부드럽게 만듦
-        filtered_rpm = (RPM_FILTER_ALPHA * raw_rpm) + ((1.0f - RPM_FILTER_ALPHA) * filtered_rpm);
-        motor_rpm = filtered_rpm;
-    }
+/**
+ * @brief 부팅 후 누적 위치를 반환한다.
+ * @retval 틱 (부호: 회전 방향, 64비트라 랩어라운드 없음)
+ */
+int64_t MotorEncoder_GetPositionTicks(void)
+{
+    return odometry.position_ticks;
 }
 
 /**
- * @brief 현재 계산된 모터의 RPM 값을 반환한다.
- * @retval float 필터링된 현재 RPM 값 (항상 양수)
- * @note fabsf() 함수를 사용하여 모터의 회전 방향과 관계없이 항상 양수 값을 반환한다.
+ * @brief 부팅 후 방향과 무관한 누적 주행 거리를 반환한다.
+ * @retval mm (32비트, 약 4295km에서 랩어라운드)
  */
-float MotorControl_GetRPM(void)
+uint32_t MotorEncoder_GetTravelMm(void)
 {
-	return fabsf(motor_rpm);
+    return (uint32_t)Odometry_TicksToMm((int64_t)odometry.travel_ticks);
 }
@@ -0,0 +1,47 @@
+/**
+ * @file odometry.c
+ * @brief 엔코더 카운터 확장과 주행 거리 적산을 정수 연산으로 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note mm = ticks × 둘레(µm) / (TICKS_PER_REV × 1000) = ticks × 둘레(µm) × 10 / (TICKS_PER_REV_X10 × 1000)
+ */
+
+#include "odometry.h"
+#include "rpm_calc.h"
+
+void Odometry_Init(Odometry_t *od, uint16_t raw)
+{
+    od->last_raw = raw;
+    od->position_ticks = 0;
+    od->travel_ticks = 0;
+}
+
+int16_t Odometry_Update(Odometry_t *od, uint16_t raw)
+{
+    int16_t delta = (int16_t)(raw - od->last_raw); // 16비트 랩어라운드 보정
+
+    od->last_raw = raw;
+    od->position_ticks += delta;
+    od->travel_ticks += (uint16_t)((delta < 0) ? -delta : delta);
+
+    return delta;
+}
+
+static int64_t Odometry_DivRound(int64_t num, int64_t den)
+{
+    num += (num >= 0) ? den / 2 : -den / 2;
+    return num / den;
+}
+
+int64_t Odometry_TicksToMm(int64_t ticks)
+{
+    return Odometry_DivRound(ticks * ODOM_WHEEL_CIRC_UM * 10, (int64_t)RPM_TICKS_PER_REV_X10 * 1000);
+}
+
+/**
+ * @note mm/s = rpm × 둘레(mm) / 60 = rpm_x10 × 둘레(µm) / 600000
+ */
+int32_t Odometry_RpmX10ToMmPerS(int32_t rpm_x10)
+{
+    return (int32_t)Odometry_DivRound((int64_t)rpm_x10 * ODOM_WHEEL_CIRC_UM, 600000);
+}
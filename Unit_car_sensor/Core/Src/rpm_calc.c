@@ -0,0 +1,83 @@
+/**
+ * @file rpm_calc.c
+ * @brief 엔코더 엣지 타임스탬프 기반 M/T 방식 RPM 추정을 정수 연산으로 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note rpm_x10 = ticks × 60 × 10 × clk / (TICKS_PER_REV × cycles) = ticks × clk × 6000 / (TICKS_PER_REV_X10 × cycles)
+ * |ticks| ≤ 32768, clk = 72MHz에서 분자는 약 1.4e16이므로 64비트 정수로 계산한다. (10ms당 한 번)
+ */
+
+#include "rpm_calc.h"
+
+void RpmCalc_Init(RpmCalc_t *st, uint32_t clk_hz)
+{
+    st->clk_hz = clk_hz;
+    st->ref_seq = 0;
+    st->ref_cycles = 0;
+    st->ref_count = 0;
+    st->has_ref = false;
+    st->rpm_x10 = 0;
+}
+
+int32_t RpmCalc_TicksToRpmX10(int32_t ticks, uint32_t cycles, uint32_t clk_hz)
+{
+    if (cycles == 0)
+    {
+        return 0;
+    }
+
+    int64_t num = (int64_t)ticks * clk_hz * 6000;
+    int64_t den = (int64_t)RPM_TICKS_PER_REV_X10 * cycles;
+
+    num += (num >= 0) ? den / 2 : -den / 2; // 0으로부터 멀어지는 방향으로 반올림
+    return (int32_t)(num / den);
+}
+
+/**
+ * @brief 최신 엣지 정보로 RPM 추정값을 갱신한다.
+ * @note 새 엣지가 있으면 기준 엣지와 마지막 엣지 사이로 계산하고(M/T), 마지막 엣지를 새 기준으로 삼는다.
+ * 새 엣지가 없으면 기준 엣지 이후 경과 시간으로 속도 상한을 구해 추정값을 줄이고(T),
+ * RPM_ZERO_TIMEOUT_MS가 지나면 0으로 만든다.
+ */
+int32_t RpmCalc_Update(RpmCalc_t *st, uint32_t edge_seq, int16_t edge_count,
+                       uint32_t edge_cycles, uint32_t now_cycles)
+{
+    if (edge_seq != st->ref_seq)
+    {
+        if (st->has_ref)
+        {
+            int16_t ticks = (int16_t)(edge_count - st->ref_count); // 16비트 랩어라운드 보정
+            st->rpm_x10 = RpmCalc_TicksToRpmX10(ticks, edge_cycles - st->ref_cycles, st->clk_hz);
+        }
+        st->ref_seq = edge_seq;
+        st->ref_cycles = edge_cycles;
+        st->ref_count = edge_count;
+        st->has_ref = true;
+        return st->rpm_x10;
+    }
+
+    if (!st->has_ref)
+    {
+        return st->rpm_x10;
+    }
+
+    uint32_t elapsed = now_cycles - st->ref_cycles;
+    if (elapsed >= (st->clk_hz / 1000U) * RPM_ZERO_TIMEOUT_MS)
+    {
+        st->rpm_x10 = 0;
+        st->has_ref = false;
+        return 0;
+    }
+
+    int32_t bound = RpmCalc_TicksToRpmX10(RPM_TICKS_PER_EDGE, elapsed, st->clk_hz);
+    if (st->rpm_x10 > bound)
+    {
+        st->rpm_x10 = bound;
+    }
+    else if (st->rpm_x10 < -bound)
+    {
+        st->rpm_x10 = -bound;
+    }
+
+    return st->rpm_x10;
+}
@@ -3,116 +3,382 @@
  * @brief 초음파 센서 드라이버 소스 파일
  * @author YeonsuJ
  * @date 2025-07-26
- * @note TIM2를 us 단위 지연(delay)에 사용하고, TIM4를 입력 캡처(Input Capture)에 사용한다.
+ * @note TIM2(CH3: 전방, CH4: 후방)를 트리거 펄스 생성에, TIM4를 입력 캡처(Input Capture)에 사용한다.
+ *
+ * 트리거 펄스는 TIM2 PWM2 모드(CNT >= CCR 구간에서 High)와 원펄스(OPM) 동작으로 하드웨어가 만든다.
+ * PWM 출력은 업데이트 이벤트(카운터 리셋)에서 Low로 돌아가므로 한 주기에 채널당 펄스 하나만 만들 수 있다.
+ * 전방/후방 펄스를 서로 다른 시각에 내보내기 위해 주기를 두 개로 나눈다.
+ * - 1주기: 전방 CH3 펄스 [LEAD, LEAD+WIDTH), 후방 CH4 비활성
+ * - 2주기: ARR/CCR 프리로드 값으로 자동 전환. 후방 CH4 펄스가 1주기 종료 후 stagger µs 시점에 끝난다.
+ * 1주기 종료 업데이트 인터럽트에서 OPM 비트만 세워 2주기 끝에서 카운터가 멈추게 한다.
+ * 펄스 폭과 간격은 모두 타이머 하드웨어가 정하므로 태스크 선점/인터럽트 지연과 무관하다.
+ * (인터럽트는 2주기 길이 이내에만 실행되면 된다)
+ *
+ * 에코 처리는 두 단계로 나뉜다.
+ * - ISR(HAL_TIM_IC_CaptureCallback): 캡처 값으로 펄스 폭(µs)만 구해 센서별 링 버퍼에 넣고 시퀀스 번호를 올린다.
+ * - 태스크(Ultrasonic_Process): 새 샘플을 꺼내 ultrasonic_calc의 정수 연산으로 온도 보상 거리(mm)를 계산하고,
+ *   센서별 Hampel 필터(hampel_filter)로 튀는 에코를 윈도우 중앙값으로 대체한다.
+ *
+ * 에코 타임아웃은 TIM4 CH3(전방)/CH4(후방) 출력 비교로 감지한다. 두 채널은 핀 없이 리셋 기본값(Frozen)으로
+ * 비교 인터럽트만 사용한다. 트리거 시 "현재 CNT + US_ECHO_TIMEOUT_US"로 CCR을 설정하고,
+ * 하강 엣지가 먼저 오면 비교 인터럽트를 끄며, 비교가 먼저 오면 타임아웃 표시(폭 0)를 링 버퍼에 넣는다.
+ * 측정 주기(US_MEAS_PERIOD_MS)는 HC-SR04 권장 사이클(60ms)을 따르며, 진행 중인 측정이 있으면 트리거하지 않는다.
  */
 
 #include "ultrasonic.h"
 #include "tim.h"
+#include "ultrasonic_calc.h"
+#include "motor_encoder.h"
 
 /* --- 외부 핸들 --- */
-extern TIM_HandleTypeDef htim2; // us 지연에 사용될 타이머 핸들
+extern TIM_HandleTypeDef htim2; // 트리거 펄스 생성에 사용될 타이머 핸들 (1 tick = 1 µs)
 extern TIM_HandleTypeDef htim4; // 입력 캡처에 사용될 타이머 핸들
 
-// --- 전역 변수 ---
-volatile uint32_t ic_val1_front = 0;           // 전방 센서 ECHO 핀의 상승 엣지 시점 타이머 값
-volatile uint32_t ic_val2_front = 0;           // 전방 센서 ECHO 핀의 하강 엣지 시점 타이머 값
-volatile uint8_t is_first_captured_front = 0;  // 전방 센서 ECHO 핀의 상승 엣지 감지 여부 플래그
-volatile uint32_t distance_front = 0;          // 계산된 전방 거리 (cm)
+#define US_TRIG_LEAD_US  1       // 카운터 시작 후 전방 펄스 시작까지 (CNT=0 유휴 상태에서 Low 유지)
+#define US_TRIG_CCR_OFF  0xFFFFU // PWM2에서 ARR보다 큰 CCR은 출력을 활성화하지 않는다.
 
-volatile uint32_t ic_val1_rear = 0;            // 후방 센서 ECHO 핀의 상승 엣지 시점 타이머 값
-volatile uint32_t ic_val2_rear = 0;            // 후방 센서 ECHO 핀의 하강 엣지 시점 타이머 값
-volatile uint8_t is_first_captured_rear = 0;   // 후방 센서 ECHO 핀의 상승 엣지 감지 여부 플래그
-volatile uint32_t distance_rear = 0;           // 계산된 후방 거리 (cm)
+#define US_ECHO_TIMEOUT_MARK 0 // 링 버퍼에서 타임아웃을 나타내는 폭 값 (실제 에코는 수백 µs 이상)
+
+static volatile uint16_t trig_stagger_us = US_TRIG_STAGGER_US; // 전방 → 후방 펄스 하강 엣지 간격
 
 /**
- * @brief 마이크로초(us) 단위의 지연을 생성한다.
- * @param us 지연시킬 시간 (마이크로초)
- * @note TIM2를 사용하며, 블로킹 방식으로 지연을 생성한다.
+ * @brief 센서별 에코 펄스 폭 링 버퍼
+ * @note 단일 생산자(ISR)/단일 소비자(SensorTask). ISR은 width_us에 쓴 뒤 seq를 증가시키며,
+ * 소비자는 읽은 뒤 seq를 다시 확인하여 그 사이 덮어써졌는지 판별한다.
  */
-void delay_us(uint16_t us)
-{
-  __HAL_TIM_SET_COUNTER(&htim2, 0);
-  while (__HAL_TIM_GET_COUNTER(&htim2) < us);
-}
+typedef struct {
+    volatile uint16_t width_us[US_ECHO_RING_SIZE]; // 에코 High 구간 길이 (µs)
+    volatile uint32_t seq;                         // 지금까지 기록된 에코 수 (ISR만 증가)
+    uint16_t rise;                                 // 상승 엣지 캡처 값 (ISR 전용)
+} UsEchoRing_t;
+
+static UsEchoRing_t echo_ring[US_SENSOR_COUNT];
+static uint32_t read_seq[US_SENSOR_COUNT];           // 소비자가 다음에 읽을 시퀀스 번호
+static uint16_t distance_mm[US_SENSOR_COUNT];        // 마지막 에코의 필터 출력 거리 (mm)
+static uint16_t raw_mm[US_SENSOR_COUNT];             // 마지막 에코의 변환 거리 (mm, 필터 전)
+static HampelFilter_t filter[US_SENSOR_COUNT];       // 센서별 중앙값/이상값 필터
+static bool last_echo_ok[US_SENSOR_COUNT];           // 마지막 측정이 에코로 끝났는지 (타임아웃이면 false)
+static bool has_echo[US_SENSOR_COUNT];               // 한 번이라도 에코를 받았는지
+static uint32_t last_echo_ms[US_SENSOR_COUNT];       // 마지막 에코를 변환한 시각 (ms)
+static uint32_t last_trigger_ms;                     // 마지막 트리거 시각 (ms)
+static bool triggered_once = false;
+static volatile uint8_t echo_armed;                  // 측정 진행 중인 센서 비트마스크 (bit0: 전방, bit1: 후방)
+static int16_t temperature_c_x10 = US_DEFAULT_TEMP_C_X10;
+
+volatile UltrasonicStats_t g_ultrasonicStats;
 
 /**
  * @brief 초음파 센서 사용에 필요한 타이머를 초기화하고 시작한다.
- * @note TIM2는 delay_us 함수를 위해, TIM4는 입력 캡처를 위해 사용된다.
+ * @note TIM2는 트리거 펄스 생성을 위해, TIM4는 입력 캡처를 위해 사용된다.
+ * TIM2 카운터는 여기서 시작하지 않고, Ultrasonic_Trigger() 호출마다 한 번씩 돈다.
  */
 void Ultrasonic_Init(void)
 {
-	HAL_TIM_Base_Start(&htim2);  // delay_us를 위한 타이머 카운터 시작
+	// UG(강제 업데이트)로 프리로드 값을 옮길 때 업데이트 인터럽트가 발생하지 않도록 한다.
+	__HAL_TIM_URS_ENABLE(&htim2);
+	// 트리거 출력 채널 활성화 (카운터 정지 상태, CNT=0 < CCR 이므로 Low 유지)
+	htim2.Instance->CCER |= TIM_CCER_CC3E | TIM_CCER_CC4E;
+
 	HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_1); // 전방 센서 입력 캡처 인터럽트 시작 (CH1)
 	HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_2); // 후방 센서 입력 캡처 인터럽트 시작 (CH2)
 }
 
+/**
+ * @brief 전방 → 후방 트리거 펄스 간격을 설정한다.
+ * @param stagger_us 두 펄스 하강 엣지(측정 시작 시점) 사이 간격 (µs).
+ * 0이면 두 펄스를 동시에 내보내며, 그 외에는 US_TRIG_STAGGER_MIN_US 이상으로 제한된다.
+ * @note 다음 Ultrasonic_Trigger() 호출부터 적용된다.
+ */
+void Ultrasonic_SetStagger(uint16_t stagger_us)
+{
+	if (stagger_us != 0 && stagger_us < US_TRIG_STAGGER_MIN_US)
+	{
+		stagger_us = US_TRIG_STAGGER_MIN_US;
+	}
+	if (stagger_us > US_TRIG_STAGGER_MAX_US)
+	{
+		stagger_us = US_TRIG_STAGGER_MAX_US;
+	}
+	trig_stagger_us = stagger_us;
+}
+
+/**
+ * @brief 새 측정을 위해 에코 캡처 극성을 초기화하고 타임아웃 비교를 설정한다.
+ * @param stagger 후방 트리거 지연 (µs)
+ * @note TIM4 인터럽트와 같은 레지스터(CCER, DIER)를 수정하므로 짧게 인터럽트를 막는다.
+ */
+static void Ultrasonic_ArmTimeout(uint16_t stagger)
+{
+	TIM_TypeDef *tim = htim4.Instance;
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	uint16_t now = (uint16_t)tim->CNT;
+	tim->CCER &= ~(TIM_CCER_CC1P | TIM_CCER_CC2P);          // 상승 엣지부터 다시 시작
+	tim->CCR3 = (uint16_t)(now + US_ECHO_TIMEOUT_US);
+	tim->CCR4 = (uint16_t)(now + stagger + US_ECHO_TIMEOUT_US);
+	__HAL_TIM_CLEAR_FLAG(&htim4, TIM_FLAG_CC3 | TIM_FLAG_CC4); // 이전 비교 일치 플래그 제거
+	tim->DIER |= TIM_DIER_CC3IE | TIM_DIER_CC4IE;
+	echo_armed = (1U << US_FRONT) | (1U << US_REAR);
+
+	__set_PRIMASK(primask);
+}
+
 /**
  * @brief 전방 및 후방 초음파 센서에 트리거 펄스를 전송하여 거리 측정을 시작한다.
+ * @retval true: 트리거 시작, false: 이전 트리거 펄스가 아직 출력 중
+ * @note 레지스터만 설정하고 바로 반환한다. (바쁜 대기 없음)
  */
-void Ultrasonic_Trigger(void)
+bool Ultrasonic_Trigger(void)
 {
-	// 1) 전방 트리거 핀에 10us 펄스 출력
-	HAL_GPIO_WritePin(GPIOB, GPIO_PIN_13, GPIO_PIN_SET);
-	delay_us(10);
-	HAL_GPIO_WritePin(GPIOB, GPIO_PIN_13, GPIO_PIN_RESET);
-
-	// 2) 후방 트리거 핀에 10us 펄스 출력
-	HAL_GPIO_WritePin(GPIOB, GPIO_PIN_12, GPIO_PIN_SET);
-	delay_us(10);
-	HAL_GPIO_WritePin(GPIOB, GPIO_PIN_12, GPIO_PIN_RESET);
+	TIM_TypeDef *tim = htim2.Instance;
+	uint16_t stagger = trig_stagger_us;
+
+	if (tim->CR1 & TIM_CR1_CEN)
+	{
+		return false;
+	}
+
+	Ultrasonic_ArmTimeout(stagger);
+
+	// 1주기 설정: 전방 펄스 [LEAD, LEAD + WIDTH). stagger가 0이면 후방도 같은 구간에 출력한다.
+	tim->ARR  = US_TRIG_LEAD_US + US_TRIG_WIDTH_US - 1;
+	tim->CCR3 = US_TRIG_LEAD_US;
+	tim->CCR4 = (stagger == 0) ? US_TRIG_LEAD_US : US_TRIG_CCR_OFF;
+	tim->CNT  = 0;
+	tim->EGR  = TIM_EGR_UG; // 프리로드 → 섀도 레지스터 즉시 반영
+
+	if (stagger == 0)
+	{
+		// 한 주기로 끝난다.
+		tim->CR1 |= TIM_CR1_OPM | TIM_CR1_CEN;
+		return true;
+	}
+
+	// 2주기 설정(프리로드): 1주기 종료(전방 하강 엣지) 후 stagger µs 시점에 후방 펄스가 끝나도록 한다.
+	tim->ARR  = stagger - 1;
+	tim->CCR3 = US_TRIG_CCR_OFF;
+	tim->CCR4 = stagger - US_TRIG_WIDTH_US;
+
+	// 1주기 종료 시 OPM을 세우기 위한 업데이트 인터럽트
+	__HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_UPDATE);
+	__HAL_TIM_ENABLE_IT(&htim2, TIM_IT_UPDATE);
+
+	tim->CR1 = (tim->CR1 & ~TIM_CR1_OPM) | TIM_CR1_CEN;
+	return true;
+}
+
+/**
+ * @brief TIM2 업데이트(1주기 종료) 인터럽트에서 호출된다.
+ * @note 2주기 값은 하드웨어가 이미 적재했으므로, 2주기 끝에서 카운터가 멈추도록 OPM만 세운다.
+ */
+void Ultrasonic_TriggerPeriodElapsed(void)
+{
+	htim2.Instance->CR1 |= TIM_CR1_OPM;
+	__HAL_TIM_DISABLE_IT(&htim2, TIM_IT_UPDATE);
+}
+
+/**
+ * @brief 한 채널의 캡처 이벤트를 처리한다. (ISR 전용)
+ * @param tim TIM4 레지스터
+ * @param ccr 해당 채널의 CCR 값
+ * @param ccp 해당 채널의 극성 비트 (TIM_CCER_CC1P / TIM_CCER_CC2P)
+ * @param sensor 센서 인덱스
+ * @note 현재 극성 비트로 상승/하강 엣지를 구분하므로 별도 상태 플래그가 필요 없다.
+ * 16비트 카운터 랩어라운드는 uint16_t 뺄셈으로 처리된다.
+ */
+static inline void Ultrasonic_Capture(TIM_TypeDef *tim, uint16_t ccr, uint32_t ccp, UsSensor_t sensor)
+{
+  UsEchoRing_t *ring = &echo_ring[sensor];
+
+  if (tim->CCER & ccp) // 하강 엣지: 펄스 폭 기록, 타임아웃 해제
+  {
+    uint16_t width = (uint16_t)(ccr - ring->rise);
+    uint32_t seq = ring->seq;
+
+    ring->width_us[seq & (US_ECHO_RING_SIZE - 1)] = (width == US_ECHO_TIMEOUT_MARK) ? 1 : width;
+    ring->seq = seq + 1;
+    tim->DIER &= ~((sensor == US_FRONT) ? TIM_DIER_CC3IE : TIM_DIER_CC4IE);
+    echo_armed &= ~(1U << sensor);
+  }
+  else // 상승 엣지: 시작 시점 저장
+  {
+    ring->rise = ccr;
+  }
+  tim->CCER ^= ccp; // 다음 엣지 극성으로 전환
 }
 
 /**
  * @brief 타이머 입력 캡처 인터럽트 콜백 함수이다.
  * @param htim 콜백을 발생시킨 타이머의 핸들
- * @note 전방(TIM4_CH1) 및 후방(TIM4_CH2) 초음파 센서의 ECHO 핀 신호를 감지하여 거리를 계산한다.
+ * @note 전방(TIM4_CH1) 및 후방(TIM4_CH2) 초음파 센서의 ECHO 핀 엣지마다 호출된다.
+ * 부동소수점 연산이나 인터럽트 재설정 없이 펄스 폭만 링 버퍼에 기록한다.
+ * TIM1(엔코더) CH1 캡처는 motor_encoder 모듈로 넘긴다.
  */
 void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
 {
   if (htim->Instance == TIM4)
   {
-    // 전방 센서(Channel 1)의 Echo 신호 처리
-    if (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_1)
+    if (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_1)      // 전방 센서
     {
-      if (is_first_captured_front == 0) // 상승 엣지 감지
-      {
-        ic_val1_front = HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_1);
-        __HAL_TIM_SET_CAPTUREPOLARITY(htim, TIM_CHANNEL_1, TIM_INPUTCHANNELPOLARITY_FALLING);
-        is_first_captured_front = 1;
-      }
-      else // 하강 엣지 감지
-      {
-        ic_val2_front = HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_1);
-        __HAL_TIM_SET_CAPTUREPOLARITY(htim, TIM_CHANNEL_1, TIM_INPUTCHANNELPOLARITY_RISING);
-        
-        // 거리 계산 중 인터럽트 방지를 위해 잠시 비활성화
-        __HAL_TIM_DISABLE_IT(htim, TIM_IT_CC1);
-        uint32_t diff = (ic_val2_front > ic_val1_front) ? (ic_val2_front - ic_val1_front) : (0xFFFF - ic_val1_front + ic_val2_front);
-        distance_front = (diff * 0.0343f) / 2.0f; // 음속 기반 거리 계산 (cm)
-        is_first_captured_front = 0;  // 다음 측정을 위해 플래그 리셋
-        __HAL_TIM_ENABLE_IT(htim, TIM_IT_CC1); // 인터럽트 재활성화
-      }
+      Ultrasonic_Capture(htim->Instance, (uint16_t)htim->Instance->CCR1, TIM_CCER_CC1P, US_FRONT);
+    }
+    else if (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_2) // 후방 센서
+    {
+      Ultrasonic_Capture(htim->Instance, (uint16_t)htim->Instance->CCR2, TIM_CCER_CC2P, US_REAR);
+    }
+  }
+  else if (htim->Instance == TIM1)
+  {
+    MotorEncoder_CaptureCallback();
+  }
+}
+
+/**
+ * @brief 한 센서의 에코 타임아웃을 처리한다. (ISR 전용)
+ * @note 에코가 시작되지 않았거나(센서 분리) 끝나지 않은(범위 밖) 경우이다.
+ * 타임아웃 표시를 기록하고, 극성을 상승 엣지로 되돌려 늦게 오는 하강 엣지를 무시한다.
+ */
+static inline void Ultrasonic_Timeout(TIM_TypeDef *tim, uint32_t ccp, uint32_t ccie, UsSensor_t sensor)
+{
+  UsEchoRing_t *ring = &echo_ring[sensor];
+  uint32_t seq = ring->seq;
+
+  ring->width_us[seq & (US_ECHO_RING_SIZE - 1)] = US_ECHO_TIMEOUT_MARK;
+  ring->seq = seq + 1;
+  tim->CCER &= ~ccp;
+  tim->DIER &= ~ccie;
+  echo_armed &= ~(1U << sensor);
+}
+
+/**
+ * @brief 타이머 출력 비교 인터럽트 콜백 함수이다.
+ * @param htim 콜백을 발생시킨 타이머의 핸들
+ * @note TIM4 CH3(전방)/CH4(후방) 비교 일치 = 에코 타임아웃
+ */
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM4)
+  {
+    if (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_3)
+    {
+      Ultrasonic_Timeout(htim->Instance, TIM_CCER_CC1P, TIM_DIER_CC3IE, US_FRONT);
     }
-    
-    // 후방 센서(Channel 2)의 Echo 신호 처리
-    else if (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_2)
+    else if (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_4)
     {
-      if (is_first_captured_rear == 0) // 상승 엣지 감지
+      Ultrasonic_Timeout(htim->Instance, TIM_CCER_CC2P, TIM_DIER_CC4IE, US_REAR);
+    }
+  }
+}
+
+/**
+ * @brief 링 버퍼에 쌓인 새 에코를 거리(mm)로 변환한다. (태스크 컨텍스트)
+ * @param now_ms 현재 시각 (ms)
+ * @note 소비자가 늦어 덮어써진 샘플은 g_ultrasonicStats.overrun_count로 센다.
+ * 새 샘플이 여러 개면 순서대로 변환하며, 마지막 값이 현재 거리가 된다.
+ * 직전 에코가 US_MAX_AGE_MS보다 오래되었으면 필터 윈도우를 비워 오래된 장면과 섞지 않는다.
+ */
+static void Ultrasonic_Process(uint32_t now_ms)
+{
+  for (uint8_t i = 0; i < US_SENSOR_COUNT; i++)
+  {
+    UsEchoRing_t *ring = &echo_ring[i];
+    uint32_t head = ring->seq;
+
+    // 버퍼 크기보다 많이 밀렸다면 남아 있는 최신 샘플부터 읽는다.
+    if (head - read_seq[i] > US_ECHO_RING_SIZE)
+    {
+      g_ultrasonicStats.overrun_count[i] += head - read_seq[i] - US_ECHO_RING_SIZE;
+      read_seq[i] = head - US_ECHO_RING_SIZE;
+    }
+
+    while (read_seq[i] != head)
+    {
+      uint16_t width = ring->width_us[read_seq[i] & (US_ECHO_RING_SIZE - 1)];
+
+      // 읽는 동안 ISR이 같은 슬롯을 덮어썼다면 버린다.
+      if (ring->seq - read_seq[i] > US_ECHO_RING_SIZE)
       {
-        ic_val1_rear = HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_2);
-        __HAL_TIM_SET_CAPTUREPOLARITY(htim, TIM_CHANNEL_2, TIM_INPUTCHANNELPOLARITY_FALLING);
-        is_first_captured_rear = 1;
+        g_ultrasonicStats.overrun_count[i]++;
       }
-      else // 하강 엣지 감지
+      else if (width == US_ECHO_TIMEOUT_MARK)
       {
-        ic_val2_rear = HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_2);
-        __HAL_TIM_SET_CAPTUREPOLARITY(htim, TIM_CHANNEL_2, TIM_INPUTCHANNELPOLARITY_RISING);
-        __HAL_TIM_DISABLE_IT(htim, TIM_IT_CC2);
-        uint32_t diff = (ic_val2_rear > ic_val1_rear) ? (ic_val2_rear - ic_val1_rear) : (0xFFFF - ic_val1_rear + ic_val2_rear);
-        distance_rear = (diff * 0.0343f) / 2.0f;
-        is_first_captured_rear = 0;
-        __HAL_TIM_ENABLE_IT(htim, TIM_IT_CC2);
+        last_echo_ok[i] = false;
+        g_ultrasonicStats.timeout_count[i]++;
       }
+      else
+      {
+        if (has_echo[i] && (now_ms - last_echo_ms[i]) > US_MAX_AGE_MS)
+        {
+          HampelFilter_Init(&filter[i]);
+        }
+        raw_mm[i] = UltrasonicCalc_EchoToMm(width, temperature_c_x10);
+        distance_mm[i] = HampelFilter_Push(&filter[i], raw_mm[i]);
+        if (filter[i].outlier)
+        {
+          g_ultrasonicStats.outlier_count[i]++;
+        }
+        last_echo_ok[i] = true;
+        has_echo[i] = true;
+        last_echo_ms[i] = now_ms;
+        g_ultrasonicStats.echo_count[i]++;
+        g_ultrasonicStats.last_width_us[i] = width;
+      }
+      read_seq[i]++;
     }
   }
 }
+
+/**
+ * @brief 측정 스케줄러. SensorTask에서 주기적으로 호출한다.
+ * @param now_ms 현재 시각 (ms)
+ * @note 새 에코를 변환한 뒤, 마지막 트리거로부터 US_MEAS_PERIOD_MS가 지났고
+ * 진행 중인 측정(에코 대기)이 없을 때만 다음 트리거를 낸다. 겹치는 에코로 인한 오측정을 막는다.
+ */
+void Ultrasonic_Update(uint32_t now_ms)
+{
+  Ultrasonic_Process(now_ms);
+
+  if (echo_armed != 0)
+  {
+    return;
+  }
+  if (triggered_once && (now_ms - last_trigger_ms) < US_MEAS_PERIOD_MS)
+  {
+    return;
+  }
+
+  if (Ultrasonic_Trigger())
+  {
+    last_trigger_ms = now_ms;
+    triggered_once = true;
+  }
+}
+
+/**
+ * @brief 센서의 최신 측정 결과를 유효성/경과 시간과 함께 반환한다.
+ * @param sensor US_FRONT 또는 US_REAR
+ * @param now_ms 현재 시각 (ms)
+ * @param out [출력] 측정 결과
+ * @note 마지막 측정이 타임아웃이었거나, 마지막 에코가 US_MAX_AGE_MS보다 오래되었으면 valid = false이다.
+ */
+void Ultrasonic_GetReading(UsSensor_t sensor, uint32_t now_ms, UsReading_t *out)
+{
+  uint32_t age = has_echo[sensor] ? (now_ms - last_echo_ms[sensor]) : UINT16_MAX;
+
+  out->distance_mm = distance_mm[sensor];
+  out->raw_mm = raw_mm[sensor];
+  out->spread_mm = filter[sensor].mad_mm;
+  out->confidence = filter[sensor].confidence;
+  out->age_ms = (age > UINT16_MAX) ? UINT16_MAX : (uint16_t)age;
+  out->valid = has_echo[sensor] && last_echo_ok[sensor] && (age <= US_MAX_AGE_MS);
+}
+
+/**
+ * @brief 음속 보상에 사용할 기온을 설정한다.
+ * @param temp_c_x10 기온 (0.1°C 단위)
+ */
+void Ultrasonic_SetTemperature(int16_t temp_c_x10)
+{
+  temperature_c_x10 = temp_c_x10;
+}
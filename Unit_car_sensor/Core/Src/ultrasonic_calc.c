@@ -0,0 +1,32 @@
+/**
+ * @file ultrasonic_calc.c
+ * @brief 초음파 에코 펄스 폭 → 거리 변환(온도 보상 포함)을 정수 연산으로 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 거리(mm) = width(µs) * c(m/s) / 2 / 1000 = width * c_x10 / 20000
+ * width ≤ 65535, c_x10 ≤ 약 3600(50°C)이므로 곱은 2.4e8로 uint32_t 범위 안에 있다.
+ */
+
+#include "ultrasonic_calc.h"
+
+/**
+ * @brief 온도에 따른 음속을 계산한다.
+ * @note c_x10 = 3313 + 0.606 * temp_c_x10 (0으로부터 멀어지는 방향으로 반올림)
+ */
+uint16_t UltrasonicCalc_SoundSpeedX10(int16_t temp_c_x10)
+{
+    int32_t delta = (int32_t)US_SOUND_SPEED_SLOPE_X1000 * temp_c_x10;
+
+    delta = (delta >= 0) ? (delta + 500) / 1000 : (delta - 500) / 1000;
+    return (uint16_t)(US_SOUND_SPEED_0C_X10 + delta);
+}
+
+/**
+ * @brief 에코 펄스 폭을 거리로 변환한다.
+ */
+uint16_t UltrasonicCalc_EchoToMm(uint16_t width_us, int16_t temp_c_x10)
+{
+    uint32_t c_x10 = UltrasonicCalc_SoundSpeedX10(temp_c_x10);
+
+    return (uint16_t)(((uint32_t)width_us * c_x10 + 10000U) / 20000U);
+}
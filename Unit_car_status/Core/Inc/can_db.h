@@ -0,0 +1,253 @@
+/**
+ * @file can_db.h
+ * @brief 차량부 CAN 프레임의 신호 정의와 pack/unpack 코덱
+ * @note 이 파일은 can_db/gen_can_db.py가 can_db/vehicle.dbc로부터 자동 생성한다. 직접 수정하지 말 것.
+ * 프레임 레이아웃을 바꾸려면 vehicle.dbc를 수정하고 생성기를 다시 실행한다.
+ * car_central, car_sensor, car_status가 동일한 파일을 사용한다.
+ */
+
+#ifndef INC_CAN_DB_H_
+#define INC_CAN_DB_H_
+
+#include <stdint.h>
+
+/* --- 0x010 EMERGENCY (DLC 4, 송신: SENSOR) --- */
+#define CANDB_EMERGENCY_ID  0x010U
+#define CANDB_EMERGENCY_DLC 4U
+
+/**
+ * @brief 센서 ECU 비상 정지 요청 (최고 우선순위 ID, 상태 변화 시 즉시 + 정지 중 20ms 반복)
+ */
+typedef struct {
+    uint8_t   stop_front; // bit 0, 1비트. 전방 충돌 위험, 전진 구동 차단 (1: 정지)
+    uint8_t   stop_rear;  // bit 1, 1비트. 후방 충돌 위험, 후진 구동 차단 (1: 정지)
+    uint16_t  ttc_ms;     // bit 8, 16비트. 전/후방 중 짧은 충돌 예상 시간 (65535: 접근 없음) [ms]
+    uint8_t   counter;    // bit 24, 8비트. 프레임마다 1 증가하는 롤링 카운터
+} CanDb_Emergency_t;
+
+/**
+ * @brief CanDb_Emergency_t를 CAN 데이터 바이트로 인코딩한다. (분기 없음)
+ * @param msg 인코딩할 신호 값. 각 신호는 정의된 비트 수로 잘린다.
+ * @param data 출력 버퍼 (CANDB_EMERGENCY_DLC 바이트)
+ */
+static inline void CanDb_Emergency_Pack(const CanDb_Emergency_t *msg, uint8_t *data)
+{
+    data[0] = (uint8_t)(((uint32_t)msg->stop_front & 0x01U) | (((uint32_t)msg->stop_rear & 0x01U) << 1));
+    data[1] = (uint8_t)((uint32_t)msg->ttc_ms & 0xFFU);
+    data[2] = (uint8_t)(((uint32_t)msg->ttc_ms >> 8) & 0xFFU);
+    data[3] = (uint8_t)((uint32_t)msg->counter & 0xFFU);
+}
+
+/**
+ * @brief CAN 데이터 바이트를 CanDb_Emergency_t로 디코딩한다. (분기 없음)
+ * @param data 수신 데이터 (CANDB_EMERGENCY_DLC 바이트 이상)
+ * @param msg 디코딩 결과
+ */
+static inline void CanDb_Emergency_Unpack(const uint8_t *data, CanDb_Emergency_t *msg)
+{
+    msg->stop_front = (uint8_t)((uint32_t)data[0] & 0x01U);
+    msg->stop_rear = (uint8_t)(((uint32_t)data[0] >> 1) & 0x01U);
+    msg->ttc_ms = (uint16_t)((uint32_t)data[1] | ((uint32_t)data[2] << 8));
+    msg->counter = (uint8_t)((uint32_t)data[3]);
+}
+
+/* --- 0x6A5 SENSOR_STATUS (DLC 4, 송신: SENSOR) --- */
+#define CANDB_SENSOR_STATUS_ID  0x6A5U
+#define CANDB_SENSOR_STATUS_DLC 4U
+
+/**
+ * @brief 센서 ECU 상태 (10ms마다 평가, 변화 시 송신: 이산 신호 즉시, RPM 변화 최소 20ms 간격, 하트비트 정지 200ms/회전 50ms)
+ */
+typedef struct {
+    uint8_t   obstacle_front; // bit 0, 1비트. 전방 10cm 이내 장애물 (1: 감지)
+    uint8_t   obstacle_rear;  // bit 1, 1비트. 후방 10cm 이내 장애물 (1: 감지)
+    uint8_t   front_valid;    // bit 2, 1비트. 전방 거리 측정 유효 (0: 에코 타임아웃 또는 오래된 값)
+    uint8_t   rear_valid;     // bit 3, 1비트. 후방 거리 측정 유효 (0: 에코 타임아웃 또는 오래된 값)
+    uint8_t   light_dark;     // bit 8, 8비트. 조도 센서 어두움 여부 (1: dark, 0: bright)
+    int16_t   motor_rpm;      // bit 16, 16비트. 엔코더 기반 모터 RPM (부호: 회전 방향, 양수: 엔코더 카운트 증가) [rpm]
+} CanDb_SensorStatus_t;
+
+/**
+ * @brief CanDb_SensorStatus_t를 CAN 데이터 바이트로 인코딩한다. (분기 없음)
+ * @param msg 인코딩할 신호 값. 각 신호는 정의된 비트 수로 잘린다.
+ * @param data 출력 버퍼 (CANDB_SENSOR_STATUS_DLC 바이트)
+ */
+static inline void CanDb_SensorStatus_Pack(const CanDb_SensorStatus_t *msg, uint8_t *data)
+{
+    data[0] = (uint8_t)(((uint32_t)msg->obstacle_front & 0x01U) | (((uint32_t)msg->obstacle_rear & 0x01U) << 1) | (((uint32_t)msg->front_valid & 0x01U) << 2) | (((uint32_t)msg->rear_valid & 0x01U) << 3));
+    data[1] = (uint8_t)((uint32_t)msg->light_dark & 0xFFU);
+    data[2] = (uint8_t)((uint32_t)msg->motor_rpm & 0xFFU);
+    data[3] = (uint8_t)(((uint32_t)msg->motor_rpm >> 8) & 0xFFU);
+}
+
+/**
+ * @brief CAN 데이터 바이트를 CanDb_SensorStatus_t로 디코딩한다. (분기 없음)
+ * @param data 수신 데이터 (CANDB_SENSOR_STATUS_DLC 바이트 이상)
+ * @param msg 디코딩 결과
+ */
+static inline void CanDb_SensorStatus_Unpack(const uint8_t *data, CanDb_SensorStatus_t *msg)
+{
+    msg->obstacle_front = (uint8_t)((uint32_t)data[0] & 0x01U);
+    msg->obstacle_rear = (uint8_t)(((uint32_t)data[0] >> 1) & 0x01U);
+    msg->front_valid = (uint8_t)(((uint32_t)data[0] >> 2) & 0x01U);
+    msg->rear_valid = (uint8_t)(((uint32_t)data[0] >> 3) & 0x01U);
+    msg->light_dark = (uint8_t)((uint32_t)data[1]);
+    msg->motor_rpm = (int16_t)((int32_t)(((uint32_t)data[2] | ((uint32_t)data[3] << 8)) << 16) >> 16);
+}
+
+/* --- 0x6A6 ODOMETRY (DLC 7, 송신: SENSOR) --- */
+#define CANDB_ODOMETRY_ID  0x6A6U
+#define CANDB_ODOMETRY_DLC 7U
+
+/**
+ * @brief 센서 ECU 오도메트리 (100ms 주기)
+ */
+typedef struct {
+    uint32_t  travel_mm;  // bit 0, 32비트. 부팅 후 누적 주행 거리 (방향 무관, 랩어라운드) [mm]
+    int16_t   speed_mm_s; // bit 32, 16비트. 바퀴 선속도 (부호: 회전 방향) [mm/s]
+    uint8_t   counter;    // bit 48, 8비트. 프레임마다 1 증가하는 롤링 카운터 (누락 감지용)
+} CanDb_Odometry_t;
+
+/**
+ * @brief CanDb_Odometry_t를 CAN 데이터 바이트로 인코딩한다. (분기 없음)
+ * @param msg 인코딩할 신호 값. 각 신호는 정의된 비트 수로 잘린다.
+ * @param data 출력 버퍼 (CANDB_ODOMETRY_DLC 바이트)
+ */
+static inline void CanDb_Odometry_Pack(const CanDb_Odometry_t *msg, uint8_t *data)
+{
+    data[0] = (uint8_t)((uint32_t)msg->travel_mm & 0xFFU);
+    data[1] = (uint8_t)(((uint32_t)msg->travel_mm >> 8) & 0xFFU);
+    data[2] = (uint8_t)(((uint32_t)msg->travel_mm >> 16) & 0xFFU);
+    data[3] = (uint8_t)(((uint32_t)msg->travel_mm >> 24) & 0xFFU);
+    data[4] = (uint8_t)((uint32_t)msg->speed_mm_s & 0xFFU);
+    data[5] = (uint8_t)(((uint32_t)msg->speed_mm_s >> 8) & 0xFFU);
+    data[6] = (uint8_t)((uint32_t)msg->counter & 0xFFU);
+}
+
+/**
+ * @brief CAN 데이터 바이트를 CanDb_Odometry_t로 디코딩한다. (분기 없음)
+ * @param data 수신 데이터 (CANDB_ODOMETRY_DLC 바이트 이상)
+ * @param msg 디코딩 결과
+ */
+static inline void CanDb_Odometry_Unpack(const uint8_t *data, CanDb_Odometry_t *msg)
+{
+    msg->travel_mm = (uint32_t)((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+    msg->speed_mm_s = (int16_t)((int32_t)(((uint32_t)data[4] | ((uint32_t)data[5] << 8)) << 16) >> 16);
+    msg->counter = (uint8_t)((uint32_t)data[6]);
+}
+
+/* --- 0x6A7 RANGE (DLC 8, 송신: SENSOR) --- */
+#define CANDB_RANGE_ID  0x6A7U
+#define CANDB_RANGE_DLC 8U
+
+/**
+ * @brief 센서 ECU 필터링된 초음파 거리 (100ms 주기)
+ */
+typedef struct {
+    uint16_t  front_mm;         // bit 0, 16비트. 전방 Hampel 필터 출력 거리 (이상값은 윈도우 중앙값으로 대체) [mm]
+    uint16_t  rear_mm;          // bit 16, 16비트. 후방 Hampel 필터 출력 거리 (이상값은 윈도우 중앙값으로 대체) [mm]
+    uint8_t   front_spread_mm;  // bit 32, 8비트. 전방 윈도우 중앙값 절대 편차(MAD), 255에서 포화 [mm]
+    uint8_t   rear_spread_mm;   // bit 40, 8비트. 후방 윈도우 중앙값 절대 편차(MAD), 255에서 포화 [mm]
+    uint8_t   front_confidence; // bit 48, 8비트. 전방 신뢰도 (윈도우 중 임계값 안의 샘플 비율, 0: 측정 없음) [%]
+    uint8_t   rear_confidence;  // bit 56, 8비트. 후방 신뢰도 (윈도우 중 임계값 안의 샘플 비율, 0: 측정 없음) [%]
+} CanDb_Range_t;
+
+/**
+ * @brief CanDb_Range_t를 CAN 데이터 바이트로 인코딩한다. (분기 없음)
+ * @param msg 인코딩할 신호 값. 각 신호는 정의된 비트 수로 잘린다.
+ * @param data 출력 버퍼 (CANDB_RANGE_DLC 바이트)
+ */
+static inline void CanDb_Range_Pack(const CanDb_Range_t *msg, uint8_t *data)
+{
+    data[0] = (uint8_t)((uint32_t)msg->front_mm & 0xFFU);
+    data[1] = (uint8_t)(((uint32_t)msg->front_mm >> 8) & 0xFFU);
+    data[2] = (uint8_t)((uint32_t)msg->rear_mm & 0xFFU);
+    data[3] = (uint8_t)(((uint32_t)msg->rear_mm >> 8) & 0xFFU);
+    data[4] = (uint8_t)((uint32_t)msg->front_spread_mm & 0xFFU);
+    data[5] = (uint8_t)((uint32_t)msg->rear_spread_mm & 0xFFU);
+    data[6] = (uint8_t)((uint32_t)msg->front_confidence & 0xFFU);
+    data[7] = (uint8_t)((uint32_t)msg->rear_confidence & 0xFFU);
+}
+
+/**
+ * @brief CAN 데이터 바이트를 CanDb_Range_t로 디코딩한다. (분기 없음)
+ * @param data 수신 데이터 (CANDB_RANGE_DLC 바이트 이상)
+ * @param msg 디코딩 결과
+ */
+static inline void CanDb_Range_Unpack(const uint8_t *data, CanDb_Range_t *msg)
+{
+    msg->front_mm = (uint16_t)((uint32_t)data[0] | ((uint32_t)data[1] << 8));
+    msg->rear_mm = (uint16_t)((uint32_t)data[2] | ((uint32_t)data[3] << 8));
+    msg->front_spread_mm = (uint8_t)((uint32_t)data[4]);
+    msg->rear_spread_mm = (uint8_t)((uint32_t)data[5]);
+    msg->front_confidence = (uint8_t)((uint32_t)data[6]);
+    msg->rear_confidence = (uint8_t)((uint32_t)data[7]);
+}
+
+/* --- 0x321 DRIVE_STATUS (DLC 3, 송신: CENTRAL) --- */
+#define CANDB_DRIVE_STATUS_ID  0x321U
+#define CANDB_DRIVE_STATUS_DLC 3U
+
+/**
+ * @brief 중앙 ECU 주행 상태 (RF 명령 수신 시)
+ */
+typedef struct {
+    uint8_t   direction; // bit 0, 8비트. 주행 방향 (1: forward, 0: backward)
+    uint8_t   brake;     // bit 8, 8비트. 브레이크 상태 (1: on, 0: off)
+    uint8_t   rf_ok;     // bit 16, 8비트. RF 수신 상태 (1: 정상, 0: 끊김)
+} CanDb_DriveStatus_t;
+
+/**
+ * @brief CanDb_DriveStatus_t를 CAN 데이터 바이트로 인코딩한다. (분기 없음)
+ * @param msg 인코딩할 신호 값. 각 신호는 정의된 비트 수로 잘린다.
+ * @param data 출력 버퍼 (CANDB_DRIVE_STATUS_DLC 바이트)
+ */
+static inline void CanDb_DriveStatus_Pack(const CanDb_DriveStatus_t *msg, uint8_t *data)
+{
+    data[0] = (uint8_t)((uint32_t)msg->direction & 0xFFU);
+    data[1] = (uint8_t)((uint32_t)msg->brake & 0xFFU);
+    data[2] = (uint8_t)((uint32_t)msg->rf_ok & 0xFFU);
+}
+
+/**
+ * @brief CAN 데이터 바이트를 CanDb_DriveStatus_t로 디코딩한다. (분기 없음)
+ * @param data 수신 데이터 (CANDB_DRIVE_STATUS_DLC 바이트 이상)
+ * @param msg 디코딩 결과
+ */
+static inline void CanDb_DriveStatus_Unpack(const uint8_t *data, CanDb_DriveStatus_t *msg)
+{
+    msg->direction = (uint8_t)((uint32_t)data[0]);
+    msg->brake = (uint8_t)((uint32_t)data[1]);
+    msg->rf_ok = (uint8_t)((uint32_t)data[2]);
+}
+
+/* --- 컴파일 타임 검사 --- */
+_Static_assert(CANDB_EMERGENCY_DLC <= 8U, "EMERGENCY: DLC must be <= 8");
+_Static_assert(0 + 1 <= CANDB_EMERGENCY_DLC * 8U, "EMERGENCY.stop_front exceeds DLC");
+_Static_assert(1 + 1 <= CANDB_EMERGENCY_DLC * 8U, "EMERGENCY.stop_rear exceeds DLC");
+_Static_assert(8 + 16 <= CANDB_EMERGENCY_DLC * 8U, "EMERGENCY.ttc_ms exceeds DLC");
+_Static_assert(24 + 8 <= CANDB_EMERGENCY_DLC * 8U, "EMERGENCY.counter exceeds DLC");
+_Static_assert(CANDB_SENSOR_STATUS_DLC <= 8U, "SENSOR_STATUS: DLC must be <= 8");
+_Static_assert(0 + 1 <= CANDB_SENSOR_STATUS_DLC * 8U, "SENSOR_STATUS.obstacle_front exceeds DLC");
+_Static_assert(1 + 1 <= CANDB_SENSOR_STATUS_DLC * 8U, "SENSOR_STATUS.obstacle_rear exceeds DLC");
+_Static_assert(2 + 1 <= CANDB_SENSOR_STATUS_DLC * 8U, "SENSOR_STATUS.front_valid exceeds DLC");
+_Static_assert(3 + 1 <= CANDB_SENSOR_STATUS_DLC * 8U, "SENSOR_STATUS.rear_valid exceeds DLC");
+_Static_assert(8 + 8 <= CANDB_SENSOR_STATUS_DLC * 8U, "SENSOR_STATUS.light_dark exceeds DLC");
+_Static_assert(16 + 16 <= CANDB_SENSOR_STATUS_DLC * 8U, "SENSOR_STATUS.motor_rpm exceeds DLC");
+_Static_assert(CANDB_ODOMETRY_DLC <= 8U, "ODOMETRY: DLC must be <= 8");
+_Static_assert(0 + 32 <= CANDB_ODOMETRY_DLC * 8U, "ODOMETRY.travel_mm exceeds DLC");
+_Static_assert(32 + 16 <= CANDB_ODOMETRY_DLC * 8U, "ODOMETRY.speed_mm_s exceeds DLC");
+_Static_assert(48 + 8 <= CANDB_ODOMETRY_DLC * 8U, "ODOMETRY.counter exceeds DLC");
+_Static_assert(CANDB_RANGE_DLC <= 8U, "RANGE: DLC must be <= 8");
+_Static_assert(0 + 16 <= CANDB_RANGE_DLC * 8U, "RANGE.front_mm exceeds DLC");
+_Static_assert(16 + 16 <= CANDB_RANGE_DLC * 8U, "RANGE.rear_mm exceeds DLC");
+_Static_assert(32 + 8 <= CANDB_RANGE_DLC * 8U, "RANGE.front_spread_mm exceeds DLC");
+_Static_assert(40 + 8 <= CANDB_RANGE_DLC * 8U, "RANGE.rear_spread_mm exceeds DLC");
+_Static_assert(48 + 8 <= CANDB_RANGE_DLC * 8U, "RANGE.front_confidence exceeds DLC");
+_Static_assert(56 + 8 <= CANDB_RANGE_DLC * 8U, "RANGE.rear_confidence exceeds DLC");
+_Static_assert(CANDB_DRIVE_STATUS_DLC <= 8U, "DRIVE_STATUS: DLC must be <= 8");
+_Static_assert(0 + 8 <= CANDB_DRIVE_STATUS_DLC * 8U, "DRIVE_STATUS.direction exceeds DLC");
+_Static_assert(8 + 8 <= CANDB_DRIVE_STATUS_DLC * 8U, "DRIVE_STATUS.brake exceeds DLC");
+_Static_assert(16 + 8 <= CANDB_DRIVE_STATUS_DLC * 8U, "DRIVE_STATUS.rf_ok exceeds DLC");
+
+#endif /* INC_CAN_DB_H_ */
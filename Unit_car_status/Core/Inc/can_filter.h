@@ -0,0 +1,51 @@
+/**
+ * @file can_filter.h
+ * @brief 구독할 CAN ID 목록으로 bxCAN 하드웨어 필터 뱅크(16비트 리스트 모드)를 구성하는 API를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 마스크 0x0000 필터는 버스의 모든 프레임을 받아 불필요한 인터럽트와 큐 복사를 만든다.
+ * 리스트 모드는 정확히 일치하는 ID만 통과시키므로 구독하지 않은 트래픽은 CPU에 도달하지 않는다.
+ * 16비트 리스트 모드에서 뱅크 하나는 표준 ID 4개를 담으며, STM32F103은 14개 뱅크(최대 56개 ID)를 제공한다.
+ */
+
+#ifndef INC_CAN_FILTER_H_
+#define INC_CAN_FILTER_H_
+
+#include "main.h"
+
+#define CAN_FILTER_BANK_COUNT    14 // STM32F103(CAN1 단독)의 필터 뱅크 수
+#define CAN_FILTER_IDS_PER_BANK  4  // 16비트 리스트 모드에서 뱅크당 표준 ID 수
+
+/**
+ * @brief 구독 ID의 수신 우선순위
+ * @note HIGH는 FIFO0, LOW는 FIFO1로 라우팅된다. 두 FIFO는 각각 3단 하드웨어 버퍼를 가지므로
+ * 저우선순위 트래픽이 몰려도 고우선순위 FIFO는 넘치지 않으며, HAL_CAN_IRQHandler()는 FIFO0을 먼저 처리한다.
+ */
+typedef enum {
+    CAN_FILTER_PRIO_HIGH = 0, // FIFO0
+    CAN_FILTER_PRIO_LOW       // FIFO1
+} CanFilterPrio_t;
+
+/**
+ * @brief 구독 항목 (표준 ID 데이터 프레임 1개)
+ */
+typedef struct {
+    uint16_t std_id;       // 11비트 표준 ID
+    CanFilterPrio_t prio;  // 수신 FIFO 선택
+} CanFilterSub_t;
+
+/**
+ * @brief 구독 목록으로 필터 뱅크를 구성하고, 사용하지 않는 뱅크는 비활성화한다.
+ * @param hcan CAN 핸들러에 대한 포인터
+ * @param subs 구독 항목 배열 (중복 ID는 한 번만 등록된다)
+ * @param count 구독 항목 수
+ * @retval HAL_OK: 성공, HAL_ERROR: 잘못된 ID 또는 뱅크 부족, 그 외: HAL_CAN_ConfigFilter() 실패
+ */
+HAL_StatusTypeDef CanFilter_Apply(CAN_HandleTypeDef *hcan, const CanFilterSub_t *subs, uint8_t count);
+
+/**
+ * @brief 마지막 CanFilter_Apply()에서 사용한 필터 뱅크 수를 반환한다.
+ */
+uint8_t CanFilter_GetUsedBanks(void);
+
+#endif /* INC_CAN_FILTER_H_ */
@@ -18,8 +18,25 @@
 typedef struct {
     CAN_RxHeaderTypeDef header; // CAN 메시지 헤더 (ID, 길이 등)
     uint8_t data[8];            // 수신된 데이터 (최대 8바이트)
+    uint32_t rx_us;             // 수신 ISR에서 기록한 타임스탬프 (µs, 지연시간 측정용)
 } CAN_RxPacket_t;
 
+#define CAN_LATENCY_BINS 12 // 지연시간 히스토그램 구간 수 (2의 거듭제곱 µs 구간)
+
+/**
+ * @brief CAN 수신 ISR → LED GPIO 출력까지의 종단 간 지연시간 히스토그램
+ * @note bins[0]은 2µs 미만, bins[i]는 [2^i, 2^(i+1)) µs, 마지막 구간은 2^(BINS-1)µs 이상을 센다.
+ * 디버거 Live Expression으로 확인한다.
+ */
+typedef struct {
+    uint32_t bins[CAN_LATENCY_BINS];
+    uint32_t count;   // 전체 샘플 수
+    uint32_t last_us; // 마지막 측정값 (µs)
+    uint32_t max_us;  // 최대 측정값 (µs)
+} CAN_LatencyHist_t;
+
+extern volatile CAN_LatencyHist_t g_canLatencyHist;
+
 // FreeRTOS 객체 및 공유 변수에 대한 extern 선언
 extern osMessageQueueId_t CANRxQueueHandle;     // CAN 수신 메시지를 담는 큐
 extern osMutexId_t SharedDataMutexHandle;       // 공유 데이터 접근을 위한 뮤텍스
@@ -39,4 +56,11 @@ void CANHandler_Init(void);
  */
 void CAN_Filter_Config(CAN_HandleTypeDef *hcan_ptr);
 
+/**
+ * @brief 수신 시각(rx_us)부터 현재까지의 지연시간을 히스토그램에 기록한다.
+ * @param rx_us CAN_RxPacket_t.rx_us 값
+ * @note LED GPIO를 갱신한 직후 CANTask에서 호출한다.
+ */
+void CANHandler_RecordLatency(uint32_t rx_us);
+
 #endif /* __CAN_HANDLER_H */
@@ -0,0 +1,55 @@
+/**
+ * @file timebase.h
+ * @brief DWT 사이클 카운터 기반의 µs/사이클 단위 단조 증가 타임베이스를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 네 유닛(controller, car_central, car_sensor, car_status)이 동일한 파일을 사용한다.
+ * IMU dt, RPM 계산, 지연시간 측정 등 ms 이하 정밀도가 필요한 타임스탬프는 모두 이 모듈에서 얻는다.
+ */
+
+#ifndef INC_TIMEBASE_H_
+#define INC_TIMEBASE_H_
+
+#include "main.h"
+
+/**
+ * @brief DWT 사이클 카운터를 활성화하고 타임베이스를 초기화한다.
+ * @note HAL_Init()과 SystemClock_Config() 이후, RTOS 스케줄러 시작 전에 한 번 호출해야 한다.
+ */
+void Timebase_Init(void);
+
+/**
+ * @brief 현재 DWT 사이클 카운트를 반환한다. (72MHz 기준 약 59.6초마다 랩어라운드)
+ * @note 두 값의 차이는 부호 없는 뺄셈으로 구하면 랩어라운드와 무관하게 정확하다.
+ * ISR에서 호출해도 안전하며 비용은 레지스터 읽기 1회다.
+ */
+static inline uint32_t Timebase_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief 부팅 이후 경과 시간을 µs 단위로 반환한다. (32비트, 약 71분마다 랩어라운드)
+ * @note 내부적으로 사이클 카운터의 랩어라운드를 누적하므로,
+ * 시스템 어딘가에서 최소 59초에 한 번 이상 호출되어야 단조성이 유지된다.
+ * ISR/태스크 어디서든 호출할 수 있다.
+ */
+uint32_t Timebase_GetMicros(void);
+
+/**
+ * @brief 부팅 이후 경과 시간을 µs 단위 64비트 값으로 반환한다.
+ */
+uint64_t Timebase_GetMicros64(void);
+
+/**
+ * @brief 사이클 수를 µs로 변환한다.
+ */
+uint32_t Timebase_CyclesToMicros(uint32_t cycles);
+
+/**
+ * @brief 지정한 시간(µs)만큼 바쁜 대기(busy-wait)한다.
+ * @note 수 µs ~ 수십 µs의 짧은 펄스 생성용이다. 긴 대기에는 osDelay를 사용해야 한다.
+ */
+void Timebase_DelayMicros(uint32_t us);
+
+#endif /* INC_TIMEBASE_H_ */
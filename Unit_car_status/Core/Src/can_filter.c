@@ -0,0 +1,149 @@
+/**
+ * @file can_filter.c
+ * @brief 16비트 리스트 모드 CAN 필터 뱅크 빌더를 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 16비트 필터 레지스터 형식: [15:5] STDID, [4] RTR, [3] IDE, [2:0] EXTID[17:15].
+ * 데이터 프레임의 표준 ID만 구독하므로 (std_id << 5) 값을 그대로 사용한다.
+ * HAL은 FilterIdLow / FilterMaskIdLow / FilterIdHigh / FilterMaskIdHigh 네 필드를 각각 한 ID로 쓴다.
+ */
+
+#include "can_filter.h"
+#include <stdbool.h>
+
+#define CAN_STD_ID_MAX 0x7FFU
+
+static uint8_t used_banks = 0;
+
+/**
+ * @brief ID 최대 4개를 필터 뱅크 하나에 기록한다.
+ * @note 남는 슬롯은 마지막 ID로 채운다. 같은 ID가 두 번 들어가도 수신 동작은 같다.
+ */
+static HAL_StatusTypeDef CanFilter_WriteBank(CAN_HandleTypeDef *hcan, uint8_t bank, uint32_t fifo,
+                                             const uint16_t *ids, uint8_t n)
+{
+    CAN_FilterTypeDef cfg;
+    uint16_t slot[CAN_FILTER_IDS_PER_BANK];
+
+    for (uint8_t i = 0; i < CAN_FILTER_IDS_PER_BANK; i++)
+    {
+        slot[i] = (uint16_t)(ids[(i < n) ? i : (n - 1)] << 5);
+    }
+
+    cfg.FilterBank = bank;
+    cfg.FilterMode = CAN_FILTERMODE_IDLIST;
+    cfg.FilterScale = CAN_FILTERSCALE_16BIT;
+    cfg.FilterFIFOAssignment = fifo;
+    cfg.FilterIdLow = slot[0];
+    cfg.FilterMaskIdLow = slot[1];
+    cfg.FilterIdHigh = slot[2];
+    cfg.FilterMaskIdHigh = slot[3];
+    cfg.FilterActivation = CAN_FILTER_ENABLE;
+    cfg.SlaveStartFilterBank = CAN_FILTER_BANK_COUNT;
+
+    return HAL_CAN_ConfigFilter(hcan, &cfg);
+}
+
+/**
+ * @brief 한 FIFO에 해당하는 구독 ID를 모아 뱅크 단위로 기록한다.
+ * @param bank [입출력] 다음에 사용할 뱅크 번호
+ */
+static HAL_StatusTypeDef CanFilter_BuildFifo(CAN_HandleTypeDef *hcan, const CanFilterSub_t *subs, uint8_t count,
+                                             CanFilterPrio_t prio, uint32_t fifo, uint8_t *bank)
+{
+    uint16_t ids[CAN_FILTER_IDS_PER_BANK];
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (subs[i].prio != prio)
+        {
+            continue;
+        }
+
+        // 앞에서 이미 등록한 ID는 건너뛴다. (우선순위가 다르게 중복 등록되면 먼저 나온 항목을 따른다)
+        bool duplicate = false;
+        for (uint8_t j = 0; j < i; j++)
+        {
+            if (subs[j].std_id == subs[i].std_id)
+            {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+
+        ids[n++] = subs[i].std_id;
+        if (n == CAN_FILTER_IDS_PER_BANK)
+        {
+            if (*bank >= CAN_FILTER_BANK_COUNT) return HAL_ERROR;
+            if (CanFilter_WriteBank(hcan, (*bank)++, fifo, ids, n) != HAL_OK) return HAL_ERROR;
+            n = 0;
+        }
+    }
+
+    if (n > 0)
+    {
+        if (*bank >= CAN_FILTER_BANK_COUNT) return HAL_ERROR;
+        if (CanFilter_WriteBank(hcan, (*bank)++, fifo, ids, n) != HAL_OK) return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief 구독 목록으로 필터 뱅크를 구성한다.
+ * @note FIFO0(HIGH) 뱅크를 먼저, FIFO1(LOW) 뱅크를 그 다음 번호에 배치한다.
+ * 재구성 시 이전 설정에서 남은 뱅크를 비활성화하므로 구독 목록을 실행 중에 바꿀 수 있다.
+ * HAL_CAN_ConfigFilter()는 설정 동안 필터 초기화 모드(FINIT)에 들어가며, 그동안 수신 프레임은 버려진다.
+ */
+HAL_StatusTypeDef CanFilter_Apply(CAN_HandleTypeDef *hcan, const CanFilterSub_t *subs, uint8_t count)
+{
+    uint8_t bank = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (subs[i].std_id > CAN_STD_ID_MAX)
+        {
+            return HAL_ERROR;
+        }
+    }
+
+    if (CanFilter_BuildFifo(hcan, subs, count, CAN_FILTER_PRIO_HIGH, CAN_FILTER_FIFO0, &bank) != HAL_OK ||
+        CanFilter_BuildFifo(hcan, subs, count, CAN_FILTER_PRIO_LOW, CAN_FILTER_FIFO1, &bank) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    // 이전 구성에서 사용했던 나머지 뱅크를 비활성화한다.
+    for (uint8_t b = bank; b < used_banks; b++)
+    {
+        CAN_FilterTypeDef cfg = {0};
+
+        cfg.FilterBank = b;
+        cfg.FilterMode = CAN_FILTERMODE_IDLIST;
+        cfg.FilterScale = CAN_FILTERSCALE_16BIT;
+        cfg.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+        cfg.FilterActivation = CAN_FILTER_DISABLE;
+        cfg.SlaveStartFilterBank = CAN_FILTER_BANK_COUNT;
+
+        if (HAL_CAN_ConfigFilter(hcan, &cfg) != HAL_OK)
+        {
+            return HAL_ERROR;
+        }
+    }
+
+    used_banks = bank;
+    return HAL_OK;
+}
+
+/**
+ * @brief 마지막 CanFilter_Apply()에서 사용한 필터 뱅크 수를 반환한다.
+ */
+uint8_t CanFilter_GetUsedBanks(void)
+{
+    return used_banks;
+}
@@ -9,9 +9,12 @@
 #include "can_handler.h"
 #include "can.h"
 #include "cmsis_os.h"
+#include "can_filter.h"
+#include "can_db.h"
+#include "timebase.h"
 
 /**
- * @note CAN 수신 패킷의 ID 및 데이터 구조
+ * @note CAN 수신 패킷의 ID 및 데이터 구조 (신호 정의: can_db/vehicle.dbc, 디코딩: can_db.h)
  * - ID 0x6A5 (Sensor Board):
  * - data[1]: LDR 센서 값 기반의 어두움 여부 (1: dark, 0: bright)
  * - ID 0x321 (Central Board):
@@ -19,8 +22,17 @@
  * - data[1]: 브레이크 상태 (1: on, 0: off)
  */
 
-// CAN 수신 필터 설정을 위한 구조체 변수
-CAN_FilterTypeDef sFilterConfig;
+/**
+ * @brief Status ECU가 구독하는 CAN ID 목록
+ * @note 목록에 없는 ID는 하드웨어 필터에서 걸러져 인터럽트를 발생시키지 않는다.
+ * 주행 상태(0x321)는 제동/방향 표시에 직결되므로 FIFO0(HIGH), 센서 상태(0x6A5)는 FIFO1(LOW)로 받는다.
+ */
+static const CanFilterSub_t can_subscriptions[] = {
+    { CANDB_DRIVE_STATUS_ID,  CAN_FILTER_PRIO_HIGH },
+    { CANDB_SENSOR_STATUS_ID, CAN_FILTER_PRIO_LOW  },
+};
+
+volatile CAN_LatencyHist_t g_canLatencyHist;
 
 /**
  * @brief   CAN 컨트롤러를 시작하고 수신 필터를 설정하며, 수신 인터럽트를 활성화한다.
@@ -32,51 +44,37 @@ void CANHandler_Init(void)
     HAL_CAN_Start(&hcan);
     CAN_Filter_Config(&hcan);
 
-    // FIFO1에 메시지가 수신되면 인터럽트가 발생하도록 활성화한다.
-    if (HAL_CAN_ActivateNotification(&hcan, CAN_IT_RX_FIFO1_MSG_PENDING) != HAL_OK)
+    // FIFO0/FIFO1에 메시지가 수신되면 인터럽트가 발생하도록 활성화한다.
+    if (HAL_CAN_ActivateNotification(&hcan, CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING) != HAL_OK)
         Error_Handler();
 }
 
 /**
  * @brief   CAN 메시지 수신 필터를 설정한다.
- * @note    현재 설정은 모든 CAN ID를 수신하도록 구성되어 있다.
+ * @note    구독 목록(can_subscriptions)으로 16비트 리스트 모드 필터 뱅크를 구성한다.
  * @param   hcan_ptr CAN 핸들러에 대한 포인터
  */
 void CAN_Filter_Config(CAN_HandleTypeDef *hcan_ptr)
 {
-	// 필터를 활성화하고, 수신된 메시지는 FIFO1에 저장하도록 설정한다.
-	sFilterConfig.FilterActivation = CAN_FILTER_ENABLE;
-	sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO1;
-	// Identifier Mask 모드로 설정하여 특정 비트만 비교한다.
-	sFilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
-	sFilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
-
-	// ID와 Mask를 모두 0으로 설정하여 모든 ID의 메시지를 수신하도록 한다.
-	// (센서 보드의 0x6A5, 중앙 보드의 0x321 메시지를 모두 받기 위함)
-	sFilterConfig.FilterIdHigh     = 0x0000;
-	sFilterConfig.FilterIdLow      = 0x0000;
-	sFilterConfig.FilterMaskIdHigh = 0x0000;
-	sFilterConfig.FilterMaskIdLow  = 0x0000;
-
-	// 설정된 필터를 CAN 컨트롤러에 적용한다.
-	if (HAL_CAN_ConfigFilter(&hcan, &sFilterConfig) != HAL_OK)
+	if (CanFilter_Apply(hcan_ptr, can_subscriptions,
+	                    sizeof(can_subscriptions) / sizeof(can_subscriptions[0])) != HAL_OK)
 	        Error_Handler(); // 실패 시 에러 처리
 }
 
 /**
-  * @brief  CAN RX FIFO1에 메시지가 수신되었을 때 호출되는 인터럽트 콜백 함수
+  * @brief  지정한 RX FIFO에서 메시지를 읽어 FreeRTOS 메시지 큐에 넣는다.
   * @note   ISR(Interrupt Service Routine)에서는 최소한의 작업만 수행해야 한다.
-  * 수신된 메시지를 FreeRTOS 메시지 큐에 넣어 실제 처리는 CAN 처리 태스크에서 수행하도록 한다.
-  * @param  hcan CAN handle
-  * @retval None
+  * 실제 처리는 CAN 처리 태스크에서 수행하도록 한다.
   */
-void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+static void CAN_RxFifoToQueue(CAN_HandleTypeDef *hcan, uint32_t fifo)
 {
     CAN_RxPacket_t rxPacket;
 
-    // CAN 하드웨어 수신 버퍼(FIFO1)에서 메시지를 읽어온다.
-    if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO1, &rxPacket.header, rxPacket.data) == HAL_OK)
+    // CAN 하드웨어 수신 버퍼(FIFO)에서 메시지를 읽어온다.
+    if (HAL_CAN_GetRxMessage(hcan, fifo, &rxPacket.header, rxPacket.data) == HAL_OK)
     {
+        rxPacket.rx_us = Timebase_GetMicros(); // 종단 간 지연시간 측정의 시작점
+
         // 메시지 큐가 생성되었다면, 읽어온 메시지를 큐에 전송한다.
         if (CANRxQueueHandle != NULL)
         {
@@ -85,3 +83,47 @@ void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
         }
     }
 }
+
+/**
+  * @brief  CAN RX FIFO0(고우선순위 구독 ID)에 메시지가 수신되었을 때 호출되는 인터럽트 콜백 함수
+  * @param  hcan CAN handle
+  * @retval None
+  */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_RxFifoToQueue(hcan, CAN_RX_FIFO0);
+}
+
+/**
+  * @brief  CAN RX FIFO1(저우선순위 구독 ID)에 메시지가 수신되었을 때 호출되는 인터럽트 콜백 함수
+  * @param  hcan CAN handle
+  * @retval None
+  */
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_RxFifoToQueue(hcan, CAN_RX_FIFO1);
+}
+
+/**
+ * @brief   수신 시각부터 현재까지의 지연시간을 히스토그램에 기록한다.
+ * @note    구간 번호는 지연시간(µs)의 최상위 비트 위치로 정한다. CANTask에서만 호출된다.
+ * @param   rx_us ISR에서 기록한 수신 타임스탬프 (µs)
+ */
+void CANHandler_RecordLatency(uint32_t rx_us)
+{
+    uint32_t latency = Timebase_GetMicros() - rx_us;
+    uint32_t bin = (latency < 2) ? 0 : (31U - (uint32_t)__builtin_clz(latency));
+
+    if (bin >= CAN_LATENCY_BINS)
+    {
+        bin = CAN_LATENCY_BINS - 1;
+    }
+
+    g_canLatencyHist.bins[bin]++;
+    g_canLatencyHist.count++;
+    g_canLatencyHist.last_us = latency;
+    if (latency > g_canLatencyHist.max_us)
+    {
+        g_canLatencyHist.max_us = latency;
+    }
+}
@@ -27,6 +27,7 @@
 /* USER CODE BEGIN Includes */
 #include "can.h"
 #include "can_handler.h"
+#include "can_db.h"
 #include "battery_monitor.h"
 #include "oled_display.h"
 #include "led_control.h"
@@ -37,12 +38,8 @@
  * @brief CANTask에서 처리된 데이터를 DisplayTask로 전달하기 위한 구조체
  */
 typedef struct {
-    // Sensor 데이터
-    uint8_t status_distance;    // 거리 센서 상태
-    uint8_t status_ldr;         // LDR 센서 값 (어두움 여부)
+    // LED 상태(조도, 방향, 브레이크)는 CANTask가 수신 즉시 직접 갱신하므로 포함하지 않는다.
     // Central 데이터
-    uint8_t status_direction;   // 주행 방향 상태
-    uint8_t status_brake;       // 브레이크 상태
     bool rf_ok;                 // Central 보드의 RF 통신 상태
     // CAN 통신 상태 진단 결과
 	bool is_central_can_ok;     // Central 보드와의 CAN 통신 정상 여부
@@ -55,6 +52,8 @@ typedef struct {
 /* USER CODE BEGIN PD */
 // CAN 메시지 수신 타임아웃 시간 (ms). 이 시간 동안 메시지가 없으면 통신 두절로 간주한다.
 #define CAN_TIMEOUT_MS 250
+// DisplayTask로 상태 패키지를 보내는 주기 (ms). 노드 타임아웃 진단도 이 주기로 수행한다.
+#define DISPLAY_PERIOD_MS 50
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -158,8 +157,10 @@ void MX_FREERTOS_Init(void) {
   * @brief  CANTask: CAN 수신 메시지를 처리하고 통신 상태를 진단한다.
   * @param  argument: None
   * @retval None
-  * @details 20ms 주기로 CAN Rx 큐를 확인하여 수신된 모든 메시지를 처리한다.
-  * 최신 데이터와 각 노드별 통신 타임아웃을 진단한 결과를 종합하여 DisplayDataQueue를 통해 DisplayTask로 전송한다.
+  * @details CAN Rx 큐에서 메시지가 들어올 때까지 블로킹 대기하며, 수신 즉시 디코딩하여
+  * 조도/방향/브레이크가 바뀌면 LED를 바로 갱신한다. (브레이크등 지연을 폴링 주기와 무관하게 만든다)
+  * 대기 타임아웃은 다음 진단 시각까지로 설정하여, 메시지가 없어도 DISPLAY_PERIOD_MS마다
+  * 노드별 통신 타임아웃을 진단하고 DisplayDataQueue를 통해 DisplayTask로 전송한다.
   */
 /* USER CODE END Header_StartCANTask */
 void StartCANTask(void *argument)
@@ -167,33 +168,61 @@ void StartCANTask(void *argument)
   /* USER CODE BEGIN StartCANTask */
     CAN_RxPacket_t rxPacket;
     DisplayData_t displayData = {0};  // DisplayTask로 전송할 데이터 구조체
+    uint8_t led_ldr = 0, led_direction = 0, led_brake = 0; // 현재 LED에 반영된 상태
 
     CANHandler_Init(); // CAN 컨트롤러 시작, 필터 설정 및 수신 인터럽트 활성화
 
+    LEDControl_Update(led_ldr, led_direction, led_brake);
+    uint32_t next_display_tick = HAL_GetTick();
+
     for(;;)
 	{
-		// 20ms 주기로 동작하여 시스템의 다른 태스크에 영향을 주지 않으면서도 충분한 반응성을 확보한다.
-		osDelay(20);
+		// 1. 다음 진단 시각까지 CAN 수신 큐에서 대기한다. 메시지가 들어오면 즉시 깨어난다.
+		int32_t wait = (int32_t)(next_display_tick - HAL_GetTick());
+		if (wait < 0) wait = 0;
 
-		// 1. CAN 수신 큐에 쌓여있는 모든 메시지를 non-blocking 방식으로 읽어들여 데이터를 최신 상태로 업데이트한다.
-		while (osMessageQueueGet(CANRxQueueHandle, &rxPacket, NULL, 0) == osOK)
+		if (osMessageQueueGet(CANRxQueueHandle, &rxPacket, NULL, (uint32_t)wait) == osOK)
 		{
-			if (rxPacket.header.StdId == 0x6A5) // Sensor 보드로부터의 메시지인 경우
+			uint8_t ldr = led_ldr, direction = led_direction, brake = led_brake;
+
+			if (rxPacket.header.StdId == CANDB_SENSOR_STATUS_ID) // Sensor 보드로부터의 메시지인 경우
 			{
+				CanDb_SensorStatus_t sensor;
+				CanDb_SensorStatus_Unpack(rxPacket.data, &sensor);
+
 				g_last_rx_time_sensor = HAL_GetTick(); // 마지막 수신 시간 갱신
-				displayData.status_ldr = rxPacket.data[1];
+				ldr = sensor.light_dark;
 			}
-			else if (rxPacket.header.StdId == 0x321) // Central 보드로부터의 메시지인 경우
+			else if (rxPacket.header.StdId == CANDB_DRIVE_STATUS_ID) // Central 보드로부터의 메시지인 경우
 			{
+				CanDb_DriveStatus_t drive;
+				CanDb_DriveStatus_Unpack(rxPacket.data, &drive);
+
 				g_last_rx_time_central = HAL_GetTick(); // 마지막 수신 시간 갱신
-				displayData.status_direction = rxPacket.data[0];
-				displayData.status_brake = rxPacket.data[1];
-				displayData.rf_ok = (bool)rxPacket.data[2];
+				direction = drive.direction;
+				brake = drive.brake;
+				displayData.rf_ok = (bool)drive.rf_ok;
+			}
+
+			// LED 상태가 바뀐 경우에만 GPIO를 갱신하고, ISR부터 GPIO 출력까지의 지연시간을 기록한다.
+			if (ldr != led_ldr || direction != led_direction || brake != led_brake)
+			{
+				led_ldr = ldr;
+				led_direction = direction;
+				led_brake = brake;
+				LEDControl_Update(led_ldr, led_direction, led_brake);
+				CANHandler_RecordLatency(rxPacket.rx_us);
 			}
 		}
 
-		// 2. CAN 통신 상태를 진단한다.
+		// 2. 진단 주기가 되면 CAN 통신 상태를 진단한다.
 		uint32_t now = HAL_GetTick();
+		if ((int32_t)(now - next_display_tick) < 0)
+		{
+			continue;
+		}
+		next_display_tick = now + DISPLAY_PERIOD_MS;
+
 		// CAN 컨트롤러 하드웨어 자체의 에러 상태를 확인한다.
 		bool is_status_hw_ok = (HAL_CAN_GetState(&hcan) != HAL_CAN_STATE_ERROR);
 
@@ -214,40 +243,30 @@ void StartCANTask(void *argument)
 * @param argument: None
 * @retval None
 * @details DisplayDataQueue로부터 새로운 데이터가 수신될 때까지 대기한다.
-* 데이터 수신 시, LED 상태는 즉시 업데이트하고 OLED 화면은 과도한 업데이트를 방지하기 위해 50ms 주기로 업데이트한다.
+* LED는 CANTask가 직접 갱신하므로, 이 태스크는 OLED 화면만 담당한다.
+* OLED 화면은 과도한 업데이트를 방지하기 위해 CANTask의 전송 주기(50ms)로만 업데이트된다.
 */
 /* USER CODE END Header_StartDisplayTask */
 void StartDisplayTask(void *argument)
 {
   /* USER CODE BEGIN StartDisplayTask */
     DisplayData_t localData = {0};
-    uint32_t last_oled_update_tick = 0; // 마지막 OLED 업데이트 시간을 기록
 
   for(;;)
   {
 	  // DisplayDataQueue에 데이터가 들어올 때까지 무한정 대기한다.
+	  // CANTask가 DISPLAY_PERIOD_MS 주기로만 전송하므로 I2C 버스 부하 및 화면 깜빡임이 제한된다.
 	  if (osMessageQueueGet(DisplayDataQueueHandle, &localData, NULL, osWaitForever) == osOK)
 	  {
-		  // LED는 즉각적인 반응이 중요하므로, 데이터 수신 즉시 상태를 업데이트한다.
-		  LEDControl_Update(localData.status_ldr, localData.status_direction, localData.status_brake);
-
-		  uint32_t current_tick = HAL_GetTick();
-
-		  // OLED 화면은 50ms마다 한 번씩만 업데이트하여 I2C 버스 부하 및 화면 깜빡임을 줄인다.
-		  if (current_tick - last_oled_update_tick >= 50)
-		  {
-			  last_oled_update_tick = current_tick; // 마지막 업데이트 시간 갱신
-
-			  // 배터리 상태를 읽어온다.
-			  float vout = 0.0f;
-			  float percent = Read_Battery_Percentage(&vout);
+		  // 배터리 상태를 읽어온다.
+		  float vout = 0.0f;
+		  float percent = Read_Battery_Percentage(&vout);
 
-			  // 전체 CAN 통신 상태를 종합한다 (Central과 Sensor 모두 정상이어야 함).
-			  bool is_can_ok = localData.is_central_can_ok && localData.is_sensor_can_ok;
+		  // 전체 CAN 통신 상태를 종합한다 (Central과 Sensor 모두 정상이어야 함).
+		  bool is_can_ok = localData.is_central_can_ok && localData.is_sensor_can_ok;
 
-			  // 최종적으로 계산된 모든 정보를 OLED에 표시한다.
-			  OLED_UpdateDisplay(percent, vout, is_can_ok, localData.rf_ok);
-		  }
+		  // 최종적으로 계산된 모든 정보를 OLED에 표시한다.
+		  OLED_UpdateDisplay(percent, vout, is_can_ok, localData.rf_ok);
 	  }
   }
   /* USER CODE END StartDisplayTask */
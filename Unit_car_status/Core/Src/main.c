@@ -31,6 +31,7 @@
 #include "oled_display.h"
 #include "string.h" // strlen() 함수를 사용하기 위해 string.h 헤더를 추가합니다.
 #include "stdio.h"
+#include "timebase.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -105,6 +106,9 @@ int main(void)
   MX_ADC1_Init();
   /* USER CODE BEGIN 2 */
 
+  // µs 타임베이스(DWT)를 초기화한다.
+  Timebase_Init();
+
   // 주변장치 드라이버 및 관련 변수를 초기화한다.
   OLED_Init();
   
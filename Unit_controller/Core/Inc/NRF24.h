@@ -41,6 +41,14 @@ enum {
 	disable = 0
 };
 
+/*
+ * One entry of a configuration table for "nrf24_apply_config"
+ */
+typedef struct {
+	uint8_t reg;
+	uint8_t val;
+} nrf24_reg_cfg_t;
+
 
 
 /*
@@ -61,6 +69,30 @@ void nrf24_defaults(void);
 void nrf24_init(void);
 
 
+/*
+ * Reload the RAM register shadow from the chip.
+ * Called by "nrf24_init", because MCU reset does not reset NRF24 module.
+ * Afterwards configuration functions write registers without reading them first
+ */
+void nrf24_shadow_sync(void);
+
+
+/*
+ * Forget the RAM register shadow without any SPI transaction.
+ * The next read-modify-write of each register reads the chip again.
+ * Use it when the module may have lost its registers on its own (supply brown-out)
+ */
+void nrf24_shadow_invalidate(void);
+
+
+/*
+ * Write a table of single byte registers.
+ * Entries whose value already matches the register shadow are skipped.
+ * Returns the number of registers actually written
+ */
+uint8_t nrf24_apply_config(const nrf24_reg_cfg_t *cfg, uint8_t count);
+
+
 //These functions are for controll CE and CSN pins which are selected in NRF24_conf.h
 void csn_high(void);
 void csn_low(void);
@@ -195,6 +227,13 @@ void nrf24_flush_rx(void);
 uint8_t nrf24_r_status(void);
 
 
+/*
+ * Return STATUS register value captured during the last SPI command.
+ * Every command byte shifts STATUS out, so this costs no extra SPI transaction
+ */
+uint8_t nrf24_last_status(void);
+
+
 /*
  * This function is for clear RX_DR bit in NRF24 STATUS register which sets
  * after receiving data in RX FIFO and it must be cleared by writing 1 which
@@ -322,6 +361,15 @@ size_t nrf24_uint8_t_to_type(uint8_t* in, uint16_t size);
 uint8_t nrf24_transmit(uint8_t *data, uint8_t size);
 
 
+/*
+ * Transmit data without waiting for the result.
+ * Loads the payload and pulses CE for nrf24_ce_pulse_us, then returns immediately.
+ * Completion is signalled on the IRQ pin (TX_DS or MAX_RT) and must be cleared by the caller.
+ * Returns 1 without sending if TX FIFO is full, otherwise 0
+ */
+uint8_t nrf24_transmit_async(uint8_t *data, uint8_t size);
+
+
 /*
  * Transmit in auto_ack mode without request ack packet from RX device
  */
@@ -347,9 +395,12 @@ uint8_t nrf24_data_available(void);
 
 
 /*
- * Receive data
+ * Receive data.
+ * Returns STATUS register value captured with R_RX_PAYLOAD command.
+ * If RX_P_NO field of it is RX_P_NO_EMPTY, RX FIFO was empty and "data" is left untouched.
+ * Otherwise one payload is read and RX_DR is cleared
  */
-void nrf24_receive(uint8_t *data, uint8_t size);
+uint8_t nrf24_receive(uint8_t *data, uint8_t size);
 
 
 #endif
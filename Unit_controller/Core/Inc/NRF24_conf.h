@@ -17,4 +17,6 @@
 #define ce_gpio_port GPIOA
 #define ce_gpio_pin GPIO_PIN_4
 
+#define nrf24_ce_pulse_us 10  // CE high time to start one TX (datasheet min. 10us)
+
 #endif
@@ -87,6 +87,8 @@
 #define TX_DS           5
 #define MAX_RT          4
 #define RX_P_NO         1  // 3 bits
+#define RX_P_NO_MASK    7
+#define RX_P_NO_EMPTY   7  // RX_P_NO value when RX FIFO is empty
 #define TX_FULL         0
 
 // OBSERVE_TX Register
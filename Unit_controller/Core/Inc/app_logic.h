@@ -3,6 +3,7 @@
 
 #include "main.h"
 #include "cmsis_os.h"
+#include "mpu6050.h"
 
 // --- 공유 데이터 타입 정의 ---
 typedef struct {
@@ -12,11 +13,29 @@ typedef struct {
 } DisplayData_t;
 
 
+// IMU 취득 통계 (Data Ready + DMA 모드)
+typedef struct {
+     uint32_t drdy_count;    // Data Ready 인터럽트 수
+     uint32_t busy_count;    // 버스트를 시작하지 못해 건너뛴 샘플 수 (이전 버스트 진행 중/버스 오류)
+     uint32_t error_count;   // I2C/DMA 오류 수
+     uint32_t timeout_count; // Data Ready 또는 DMA 완료를 제시간에 받지 못한 횟수
+} ImuStats_t;
+
+
 // --- 상수 정의 ---
 // 태스크 실행 주기 (ms 단위)
 #define SENSOR_TASK_PERIOD_MS 5
 #define DISPLAY_TASK_PERIOD_MS 100
 
+// IMU Data Ready 대기 시간 (샘플 주기 3회분 동안 알림이 없으면 누락으로 판단)
+#define IMU_DRDY_TIMEOUT_MS (3 * MPU6050_DRDY_PERIOD_MS)
+// DMA 버스트 완료 대기 시간 (14바이트 @400kHz ≈ 0.4ms, 여유 포함)
+#define IMU_BURST_TIMEOUT_MS 2
+// sensorTask에 전달되는 스레드 플래그
+#define IMU_FLAG_SAMPLE_READY 0x0001U // DMA 버스트 완료
+#define IMU_FLAG_DRDY         0x0002U // MPU6050 Data Ready (EXTI)
+#define IMU_FLAG_BURST_ERROR  0x0004U // I2C2 오류
+
 // 디스플레이 속성
 #define MAX_RPM 300.0f
 
@@ -31,10 +50,14 @@ typedef struct {
 // --- 공유 변수 (app_logic.c 또는 freertos.c에 정의됨) ---
 extern DisplayData_t g_displayData;
 extern osMutexId_t g_displayDataMutexHandle;
+extern volatile ImuStats_t g_imuStats;
 
 
 // --- 함수 프로토타입 ---
 float App_GetRollAngle(void);
+void App_ImuDataReadyCallback(void);
+void App_ImuReadCpltCallback(void);
+void App_ImuErrorCallback(void);
 void App_BuildPacket(uint8_t* packet_buffer, float roll_angle);
 void App_HandleAckPayload(uint8_t* ack_payload);
 
@@ -4,21 +4,41 @@
 #define INC_COMM_HANDLER_H_
 
 #include "main.h"
+#include "cmsis_os.h"
 
 // ACK 페이로드 크기 정의
 #define ACK_PAYLOAD_SIZE 3
 #define PAYLOAD_SIZE 8
 
+#define COMM_FLAG_IRQ          0x0001U // ackHandlerTask 스레드 플래그: NRF24 IRQ 발생
+#define COMM_IRQ_TIMEOUT_MS    50      // IRQ 누락 시 상태 레지스터를 직접 확인하는 주기
+#define COMM_SPI_LOCK_TIMEOUT_MS 5     // NRF24 SPI 뮤텍스 대기 한도 (트랜잭션은 수십 us)
+
 // 송신 결과 상태를 나타내는 열거형
 typedef enum {
-    COMM_OK,          // 별다른 이벤트 없음
-    COMM_TX_SUCCESS,  // 송신 성공 및 ACK 수신
-    COMM_TX_FAIL      // 송신 실패 (MAX_RT)
+    COMM_OK,             // 별다른 이벤트 없음
+    COMM_TX_SUCCESS,     // 송신 성공 및 ACK 수신 (페이로드 없음)
+    COMM_TX_ACK_PAYLOAD, // 송신 성공 및 ACK 페이로드 수신
+    COMM_TX_FAIL,        // 송신 실패 (MAX_RT)
+    COMM_TX_BUSY         // TX FIFO가 가득 차 이번 패킷을 건너뜀
 } CommStatus_t;
 
+// 송신 결과 누적 카운터 (패킷 전송 주기 튜닝용)
+typedef struct {
+    uint32_t tx_ds_count;       // 송신 성공(TX_DS)
+    uint32_t max_rt_count;      // 송신 실패(MAX_RT)
+    uint32_t ack_payload_count; // ACK 페이로드 수신
+    uint32_t tx_busy_count;     // TX FIFO 가득 참으로 건너뛴 패킷
+    uint32_t irq_timeout_count; // IRQ 없이 타임아웃으로 상태를 확인한 횟수
+    uint32_t spi_lock_timeout_count; // SPI 뮤텍스를 얻지 못해 송신/상태 확인을 건너뛴 횟수
+} CommStats_t;
+
+extern volatile CommStats_t g_commStats;
+extern osMutexId_t g_nrf24MutexHandle; // commTask와 ackHandlerTask의 NRF24 SPI(SPI1/CSN) 접근 직렬화
+
 void CommHandler_Init(void);
 void CommHandler_IrqCallback(void);
-void CommHandler_Transmit(uint8_t* payload, uint8_t len);
+CommStatus_t CommHandler_Transmit(uint8_t* payload, uint8_t len);
 CommStatus_t CommHandler_CheckStatus(uint8_t* ack_payload, uint8_t len);
 
 #endif /* INC_COMM_HANDLER_H_ */
@@ -0,0 +1,40 @@
+// kalman_fixed.h
+
+#ifndef INC_KALMAN_FIXED_H_
+#define INC_KALMAN_FIXED_H_
+
+#include <stdint.h>
+
+// --- 고정소수점 형식 정의 ---
+// Q16 : 각도(°), 각속도(°/s) 표현용. 분해능 1/65536°, 범위 ±32768°
+// Q31 : 공분산, 칼만 이득, dt(s) 표현용. 범위 [-1, 1)
+typedef int32_t q16_t;
+typedef int32_t q31_t;
+
+#define Q16_SHIFT 16
+#define Q31_SHIFT 31
+#define Q16_ONE   ((q16_t)1 << Q16_SHIFT)
+
+// 컴파일 타임 상수 변환용 매크로 (런타임 인자에 사용하지 말 것)
+#define Q16_FROM_DOUBLE(x) ((q16_t)((x) * 65536.0 + (((x) >= 0) ? 0.5 : -0.5)))
+#define Q31_FROM_DOUBLE(x) ((q31_t)((x) * 2147483648.0 + 0.5))
+
+/**
+ * @brief 고정소수점 칼만 필터 구조체
+ * @note  Kalman_t(double)와 동일한 2상태(angle, bias) 모델을 사용한다.
+ */
+typedef struct
+{
+    q31_t Q_angle;    // 각도 프로세스 노이즈
+    q31_t Q_bias;     // 바이어스 프로세스 노이즈
+    q31_t R_measure;  // 측정 노이즈
+    q16_t angle;      // 추정 각도 (°)
+    q16_t bias;       // 추정 자이로 바이어스 (°/s)
+    q31_t P[2][2];    // 오차 공분산 행렬
+} KalmanQ_t;
+
+q16_t KalmanQ_getAngle(KalmanQ_t *Kalman, q16_t newAngle, q16_t newRate, q31_t dt);
+q16_t Fixed_Atan2Deg(int32_t y, int32_t x);
+uint32_t Fixed_Sqrt(uint32_t x);
+
+#endif /* INC_KALMAN_FIXED_H_ */
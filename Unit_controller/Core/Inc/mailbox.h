@@ -0,0 +1,76 @@
+/**
+ * @file mailbox.h
+ * @brief 단일 생산자/단일 소비자(SPSC)용 최신값 메일박스(덮어쓰기 방식)를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 깊이 1~2의 RTOS 큐는 가득 차면 새 값을 버리므로 소비자가 오래된 값을 읽게 된다.
+ * 메일박스는 항상 가장 최근 값을 보관하며(이전 미소비 값은 덮어씀), 트리플 버퍼 구조라
+ * 생산자/소비자 모두 대기나 재시도 없이(wait-free) 동작한다. 따라서 ISR ↔ 태스크,
+ * 우선순위가 어떻게 배치된 태스크 ↔ 태스크 사이에서도 찢어진 값(torn read)을 읽지 않는다.
+ * 컨트롤러와 중앙 ECU가 동일한 파일을 사용한다.
+ */
+
+#ifndef INC_MAILBOX_H_
+#define INC_MAILBOX_H_
+
+#include "main.h"
+#include <stdbool.h>
+
+/**
+ * @brief 메일박스 하나에 필요한 저장 공간 크기 (슬롯 3개)
+ */
+#define MAILBOX_STORAGE_SIZE(size) (3U * (size))
+
+/**
+ * @brief 메일박스 정적 초기화 매크로
+ * @param buf MAILBOX_STORAGE_SIZE(sz) 바이트 이상의 저장 공간
+ * @param sz 메시지 하나의 크기 (바이트)
+ * @note 정적 초기화된 메일박스는 main() 진입 전부터 유효하므로,
+ * 초기화 순서와 무관하게 ISR에서 바로 사용할 수 있다.
+ */
+#define MAILBOX_INITIALIZER(buf, sz) { .storage = (buf), .size = (sz), .state = 1U, .back = 2U, .front = 0U }
+
+/**
+ * @brief 최신값 메일박스 구조체
+ * @note 생산자만 back과 put 계열 카운터를, 소비자만 front와 get 계열 카운터를 수정한다.
+ * 두 쪽이 공유하는 값은 state 하나이며 LDREX/STREX로 원자적으로 교환된다.
+ */
+typedef struct {
+    uint8_t *storage;                  // 슬롯 3개 크기의 저장 공간
+    uint16_t size;                     // 메시지 하나의 크기 (바이트)
+    volatile uint8_t state;            // bit0~1: 중간(교환) 슬롯 번호, bit2: 새 값 있음
+    uint8_t back;                      // 생산자가 쓰는 슬롯 번호
+    uint8_t front;                     // 소비자가 읽는 슬롯 번호
+    volatile uint32_t put_count;       // 게시 횟수
+    volatile uint32_t overwrite_count; // 소비되기 전에 덮어써진(드롭된) 값의 수
+    volatile uint32_t get_count;       // 새 값을 읽은 횟수
+    volatile uint32_t empty_count;     // 새 값이 없어 읽지 못한 횟수
+} Mailbox_t;
+
+/**
+ * @brief 메일박스를 초기화한다.
+ * @param mb 메일박스
+ * @param storage MAILBOX_STORAGE_SIZE(size) 바이트 이상의 저장 공간
+ * @param size 메시지 하나의 크기 (바이트)
+ * @note 생산자/소비자가 동작하기 전에 호출해야 한다. 정적 객체는 MAILBOX_INITIALIZER를 사용할 수 있다.
+ */
+void Mailbox_Init(Mailbox_t *mb, void *storage, uint16_t size);
+
+/**
+ * @brief 새 값을 게시한다. 소비되지 않은 이전 값이 있으면 덮어쓴다.
+ * @param mb 메일박스
+ * @param data 게시할 메시지 (size 바이트)
+ * @note 생산자 하나에서만 호출해야 하며, ISR에서 호출해도 안전하다.
+ */
+void Mailbox_Put(Mailbox_t *mb, const void *data);
+
+/**
+ * @brief 새 값이 있으면 꺼내온다.
+ * @param mb 메일박스
+ * @param data 메시지를 복사할 버퍼 (size 바이트)
+ * @retval true: 새 값을 읽음, false: 마지막으로 읽은 이후 게시된 값이 없음 (data는 변경되지 않음)
+ * @note 소비자 하나에서만 호출해야 하며, ISR에서 호출해도 안전하다.
+ */
+bool Mailbox_Get(Mailbox_t *mb, void *data);
+
+#endif /* INC_MAILBOX_H_ */
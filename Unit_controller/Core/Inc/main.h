@@ -57,6 +57,9 @@ void Error_Handler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
+#define MPU_INT_Pin GPIO_PIN_2
+#define MPU_INT_GPIO_Port GPIOA
+#define MPU_INT_EXTI_IRQn EXTI2_IRQn
 #define CSN_Pin GPIO_PIN_3
 #define CSN_GPIO_Port GPIOA
 #define CE_Pin GPIO_PIN_4
@@ -8,10 +8,50 @@
 #ifndef INC_GY521_H_
 #define INC_GY521_H_
 
-#endif /* INC_GY521_H_ */
-
 #include <stdint.h>
 #include "i2c.h"
+#include "kalman_fixed.h"
+#include "mpu6050_fifo.h"
+
+// 자세 추정 연산 방식 선택 (컴파일 타임)
+// 1 : Q16/Q31 고정소수점 칼만 필터 + CORDIC atan2 (FPU 없는 Cortex-M3용 기본값)
+// 0 : 원본 double 칼만 필터 + libm atan/atan2/sqrt (기준 구현)
+#ifndef MPU6050_USE_FIXED_POINT
+#define MPU6050_USE_FIXED_POINT 1
+#endif
+
+// 출력 마스크 (컴파일 타임). 마스크에 없는 항목은 연산 자체를 생략한다.
+#define MPU6050_OUT_ROLL   0x01 // KalmanAngleX(_Q16): roll 칼만 필터
+#define MPU6050_OUT_PITCH  0x02 // KalmanAngleY(_Q16): pitch atan2 + KalmanY
+#define MPU6050_OUT_SCALED 0x04 // Ax~Gz 및 고정소수점 모드의 KalmanAngleX/Y double 사본
+#define MPU6050_OUT_TEMP   0x08 // Temperature
+#define MPU6050_OUT_ALL    (MPU6050_OUT_ROLL | MPU6050_OUT_PITCH | MPU6050_OUT_SCALED | MPU6050_OUT_TEMP)
+
+// 컨트롤러는 roll만 사용한다 (App_GetRollAngle).
+// PITCH를 제외하면 |pitch| > 90°(뒤집힘) 구간의 roll 자이로 부호 보정도 생략된다.
+#ifndef MPU6050_OUTPUT_MASK
+#define MPU6050_OUTPUT_MASK MPU6050_OUT_ROLL
+#endif
+
+// 데이터 취득 방식 선택 (컴파일 타임)
+#define MPU6050_ACQ_POLL 0 // sensorTask가 5ms마다 블로킹 I2C 읽기 (원본 방식)
+#define MPU6050_ACQ_DMA  1 // INT(Data Ready) 핀 → I2C DMA 버스트 → 완료 콜백에서 태스크 알림
+#define MPU6050_ACQ_FIFO 2 // 1kHz 샘플을 센서 FIFO에 모아 5ms마다 일괄 읽기 + 데시메이션
+#ifndef MPU6050_ACQ_MODE
+#define MPU6050_ACQ_MODE MPU6050_ACQ_DMA
+#endif
+
+// Data Ready 모드 샘플 주기: DLPF 사용 시 자이로 출력 1kHz / (1 + SMPLRT_DIV) = 200Hz
+#define MPU6050_DRDY_DLPF_CFG   0x03 // DLPF 44Hz (200Hz 샘플링의 앨리어싱 방지)
+#define MPU6050_DRDY_SMPLRT_DIV 4
+#define MPU6050_DRDY_PERIOD_MS  5
+
+#define MPU6050_BURST_LEN 14 // ACCEL_XOUT_H(0x3B) ~ GYRO_ZOUT_L(0x48)
+
+// FIFO 모드 설정: SMPLRT_DIV 0x07(DLPF off) → 1kHz 샘플이 FIFO에 적재된다.
+#define MPU6050_FIFO_SIZE              1024 // 센서 FIFO 크기 (Byte)
+#define MPU6050_FIFO_MAX_BURST         32   // 한 번에 읽는 최대 프레임 수 (32ms 분량)
+#define MPU6050_FIFO_SAMPLE_PERIOD_US  1000
 
 // MPU6050 structure
 typedef struct
@@ -35,8 +75,20 @@ typedef struct
 
     double KalmanAngleX;
     double KalmanAngleY;
+
+    q16_t KalmanAngleX_Q16; // MPU6050_USE_FIXED_POINT=1 일 때 갱신 (Q16, °)
+    q16_t KalmanAngleY_Q16;
 } MPU6050_t;
 
+// FIFO statistics
+typedef struct
+{
+    uint32_t sample_count;   // 필터에 반영된 총 샘플 수
+    uint32_t drain_count;    // 데이터를 읽은 드레인 횟수
+    uint32_t overflow_count; // FIFO 오버플로우(리셋) 횟수
+    uint32_t error_count;    // I2C 오류 횟수
+} MPU6050_FifoStats_t;
+
 // Kalman structure
 typedef struct
 {
@@ -58,4 +110,14 @@ void MPU6050_Read_Temp(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct);
 
 void MPU6050_Read_All(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct);
 
+HAL_StatusTypeDef MPU6050_Read_All_DMA(I2C_HandleTypeDef *I2Cx);
+
+void MPU6050_Process_All(MPU6050_t *DataStruct, uint32_t dt_us);
+
+uint16_t MPU6050_Read_FIFO(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct);
+
+extern MPU6050_FifoStats_t MPU6050_FifoStats;
+
 double Kalman_getAngle(Kalman_t *Kalman, double newAngle, double newRate, double dt);
+
+#endif /* INC_GY521_H_ */
@@ -0,0 +1,32 @@
+/**
+ * @file mpu6050_fifo.h
+ * @brief MPU6050 FIFO 바이트 스트림을 프레임 단위로 누적(데시메이션)하는 함수를 선언한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note HAL에 의존하지 않는 순수 함수만 모아 두어 호스트에서 합성 바이트 스트림으로 검증할 수 있다.
+ */
+
+#ifndef INC_MPU6050_FIFO_H_
+#define INC_MPU6050_FIFO_H_
+
+#include <stdint.h>
+
+#define MPU6050_FIFO_FRAME_LEN 12 // 가속도 6 + 자이로 6 (Byte)
+
+// FIFO decimation accumulator (sum of RAW AX AY AZ GX GY GZ)
+typedef struct
+{
+    int32_t sum[6];
+    uint16_t count;
+} MPU6050_FifoAccum_t;
+
+/**
+ * @brief 12바이트 프레임(AX AY AZ GX GY GZ, 빅 엔디안)을 누적한다.
+ * @param Rec_Data FIFO에서 읽은 바이트
+ * @param len 바이트 수. 끝의 불완전한 프레임은 무시한다.
+ * @param Accum 누적 상태 (sum, count 갱신)
+ * @retval 누적한 프레임 수
+ */
+uint16_t MPU6050_FIFO_Parse(const uint8_t *Rec_Data, uint16_t len, MPU6050_FifoAccum_t *Accum);
+
+#endif /* INC_MPU6050_FIFO_H_ */
@@ -1,14 +1,17 @@
 #include "main.h"
 #include "cmsis_os.h"
 #include <string.h>
+#include <stdbool.h>
 #include "app_logic.h"
 #include "comm_handler.h"
 #include "input_handler.h"
 #include "mpu6050.h"
+#include "timebase.h"
 
 // Private variables from freertos.c that are needed here
 extern I2C_HandleTypeDef hi2c2;
 extern osMutexId_t g_displayDataMutexHandle;
+extern osThreadId_t sensorTaskHandle;
 
 // The MPU6050 instance is now local to this file
 static MPU6050_t MPU6050;
@@ -16,11 +19,142 @@ static MPU6050_t MPU6050;
 // The display data struct is also managed here now
 DisplayData_t g_displayData = {0};
 
+volatile ImuStats_t g_imuStats = {0};
 
-float App_GetRollAngle(void) // roll 데이터 수집 함수
+#if MPU6050_ACQ_MODE == MPU6050_ACQ_DMA
+static volatile uint32_t imu_drdy_time_us = 0; // 마지막 Data Ready 인터럽트 시각 (us, EXTI에서 기록)
+static volatile uint32_t imu_burst_seq = 0;    // 마지막으로 시작한 버스트 번호 (sensorTask만 쓴다)
+static volatile uint32_t imu_cplt_seq = 0;     // 마지막으로 완료된 버스트 번호 (DMA 완료 콜백에서 기록)
+static uint32_t imu_last_time_us = 0;          // 마지막으로 처리한 샘플의 Data Ready 시각 (us)
+
+/**
+ * @brief MPU6050 INT(Data Ready) 핀 EXTI 콜백 (ISR 컨텍스트)
+ * @note 샘플 시각만 기록하고 sensorTask를 깨운다. I2C 전송은 태스크에서 시작한다.
+ * F1 HAL의 메모리 읽기는 주소 단계를 HAL_GetTick 기반 타임아웃으로 폴링하는데,
+ * 이 ISR(우선순위 5)에서는 HAL 틱(우선순위 15)이 멈춰 있어 버스가 걸리면 빠져나오지 못하기 때문이다.
+ */
+void App_ImuDataReadyCallback(void)
+{
+    if (osKernelGetState() != osKernelRunning)
+    {
+        return; // 스케줄러 시작 전에는 수신 태스크가 없으므로 무시
+    }
+
+    g_imuStats.drdy_count++;
+    imu_drdy_time_us = Timebase_GetMicros();
+    osThreadFlagsSet(sensorTaskHandle, IMU_FLAG_DRDY);
+}
+
+/**
+ * @brief I2C2 DMA 수신 완료 콜백 (ISR 컨텍스트)
+ * @note 완료된 버스트 번호를 기록하고 sensorTask를 스레드 플래그로 깨운다.
+ */
+void App_ImuReadCpltCallback(void)
+{
+    imu_cplt_seq = imu_burst_seq;
+    osThreadFlagsSet(sensorTaskHandle, IMU_FLAG_SAMPLE_READY);
+}
+
+/**
+ * @brief I2C2 오류 콜백 (ISR 컨텍스트)
+ * @note 오류 횟수를 기록하고, 완료를 기다리는 sensorTask가 타임아웃까지 기다리지 않도록 깨운다.
+ */
+void App_ImuErrorCallback(void)
 {
+    g_imuStats.error_count++;
+    osThreadFlagsSet(sensorTaskHandle, IMU_FLAG_BURST_ERROR);
+}
+
+/**
+ * @brief IMU 버스트 읽기(DMA)를 시작하고 완료를 기다린다. (sensorTask 컨텍스트)
+ * @retval true: 이번 버스트의 14바이트가 DMA 버퍼에 모두 들어옴
+ * @note 다음 버스트는 이 함수가 반환되어 파싱이 끝난 뒤에만 시작되므로, 파싱 중에 DMA 버퍼가 덮어써지지 않는다.
+ * 완료 플래그가 이번 버스트의 것인지 번호로 확인하여, 이전에 타임아웃된 버스트의 늦은 완료를 걸러낸다.
+ */
+static bool App_ReadImuBurst(void)
+{
+    osThreadFlagsClear(IMU_FLAG_SAMPLE_READY | IMU_FLAG_BURST_ERROR);
+
+    // DMA를 시작하기 전에 번호를 올린다. 시작 직후 선점되어 완료 콜백이 먼저 실행되어도 이번 번호가 기록된다.
+    uint32_t prev_seq = imu_burst_seq;
+    uint32_t seq = prev_seq + 1U;
+    imu_burst_seq = seq;
+
+    if (MPU6050_Read_All_DMA(&hi2c2) != HAL_OK)
+    {
+        imu_burst_seq = prev_seq; // 시작하지 못한 버스트는 번호를 되돌린다
+        g_imuStats.busy_count++; // 이전 버스트가 아직 진행 중이거나 버스 오류
+        return false;
+    }
+
+    for (;;)
+    {
+        uint32_t flags = osThreadFlagsWait(IMU_FLAG_SAMPLE_READY | IMU_FLAG_BURST_ERROR, osFlagsWaitAny,
+                                           IMU_BURST_TIMEOUT_MS);
+
+        if ((flags & osFlagsError) != 0U)
+        {
+            g_imuStats.timeout_count++;
+            return false;
+        }
+        if ((flags & IMU_FLAG_BURST_ERROR) != 0U)
+        {
+            return false;
+        }
+        if (imu_cplt_seq == seq)
+        {
+            return true;
+        }
+    }
+}
+#else
+void App_ImuDataReadyCallback(void) {}
+void App_ImuReadCpltCallback(void) {}
+void App_ImuErrorCallback(void) {}
+#endif
+
+
+/**
+ * @brief roll 데이터 수집 함수
+ * @note MPU6050_ACQ_POLL 모드에서는 블로킹 I2C 읽기를 수행한다.
+ * MPU6050_ACQ_FIFO 모드에서는 센서 FIFO에 쌓인 1kHz 샘플을 한 번에 읽어 평균(데시메이션)한 뒤 필터에 반영한다.
+ * MPU6050_ACQ_DMA 모드에서는 Data Ready 알림을 기다린 뒤 이 태스크에서 DMA 버스트를 시작하고 완료를 기다려 변환하므로,
+ * 호출 주기가 센서 샘플 클럭(MPU6050_DRDY_PERIOD_MS)에 맞춰진다.
+ * 알림이 IMU_DRDY_TIMEOUT_MS 동안 없으면 현재 시각으로 버스트를 직접 읽는다. (INT 핀 누락 복구)
+ */
+float App_GetRollAngle(void)
+{
+#if MPU6050_ACQ_MODE == MPU6050_ACQ_DMA
+    uint32_t flags = osThreadFlagsWait(IMU_FLAG_DRDY, osFlagsWaitAny, IMU_DRDY_TIMEOUT_MS);
+    uint32_t t_us;
+
+    if ((flags & osFlagsError) != 0U)
+    {
+        g_imuStats.timeout_count++;
+        t_us = Timebase_GetMicros();
+    }
+    else
+    {
+        t_us = imu_drdy_time_us; // 이번 버스트의 샘플 시각을 시작 전에 고정한다
+    }
+
+    if (App_ReadImuBurst())
+    {
+        uint32_t dt_us = t_us - imu_last_time_us;
+        imu_last_time_us = t_us;
+
+        MPU6050_Process_All(&MPU6050, dt_us);
+    }
+#elif MPU6050_ACQ_MODE == MPU6050_ACQ_FIFO
+    MPU6050_Read_FIFO(&hi2c2, &MPU6050); // 새 샘플이 없으면 직전 값 유지
+#else
     MPU6050_Read_All(&hi2c2, &MPU6050);
+#endif
+#if MPU6050_USE_FIXED_POINT
+    return (float)MPU6050.KalmanAngleX_Q16 * (1.0f / Q16_ONE); // Q16 -> float 변환 1회
+#else
     return MPU6050.KalmanAngleX;
+#endif
 }
 
 void App_BuildPacket(uint8_t* packet_buffer, float roll_angle) // 데이터 패키징 함수
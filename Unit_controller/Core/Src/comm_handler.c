@@ -4,7 +4,9 @@
  * @author GeonKim
  * @date 2025-09-02
  * @note 이 핸들러는 데이터 패킷을 송신하고, 수신측으로부터 ACK 페이로드를 받는 역할을 담당한다.
- * 인터럽트 처리는 세마포어 대신 플래그(flag) 방식을 사용한다.
+ * 인터럽트 처리는 세마포어 대신 스레드 플래그(ackHandlerTask 알림) 방식을 사용한다.
+ * 송신(commTask)과 상태 확인(ackHandlerTask)은 서로 다른 태스크에서 같은 SPI1/CSN과 레지스터 섀도우를 쓰므로,
+ * 커널 시작 후의 모든 NRF24 트랜잭션은 `g_nrf24MutexHandle`로 직렬화한다.
  */
 
 #include "comm_handler.h"
@@ -39,16 +41,57 @@
  */
 static uint8_t tx_addr[5] = {0x45, 0x55, 0x67, 0x10, 0x21};
 
+#define STATUS_IRQ_MASK ((1 << RX_DR) | (1 << TX_DS) | (1 << MAX_RT))
+
+extern osThreadId_t ackHandlerTaskHandle;
+
+/**
+ * @brief 송신(Tx) 모드 레지스터 설정 테이블
+ * @note nrf24_apply_config()로 한 번에 적용한다. 레지스터 섀도우와 값이 같은 항목은 쓰지 않는다.
+ */
+static const nrf24_reg_cfg_t tx_config[] = {
+    { CONFIG,     (1 << EN_CRC) | (1 << PWR_UP) },  // 1바이트 CRC 활성화, 송신 모드(PRIM_RX=0)
+    { EN_AA,      0x3F },                           // 모든 파이프에 대해 자동 ACK 활성화
+    { FEATURE,    (1 << EN_ACK_PAY) },              // ACK 페이로드 기능 활성화, 동적 페이로드 길이 비활성화
+    { RF_SETUP,   (1 << RF_DR_HIGH) | (_0dbm << RF_PWR) }, // 데이터 속도 2Mbps, 송신 출력 0dBm (수신기와 동일하게)
+    { RF_CH,      90 },                             // RF 채널 90번 설정
+    { SETUP_AW,   5 - 2 },                          // 주소 폭 5바이트 설정
+    { SETUP_RETR, (4 << ARD) | (10 << ARC) },       // 자동 재전송 딜레이 1000us (250 * (4+1)), 횟수 10회로 제한
+    { RX_PW_P0,   ACK_PAYLOAD_SIZE },               // 파이프 0번의 페이로드 크기 설정
+};
+
+volatile CommStats_t g_commStats = {0};
+
 /**
- * @brief NRF24 IRQ 발생을 알리는 플래그 변수
- * @note volatile 키워드를 사용하여 컴파일러 최적화로 인한 문제를 방지한다.
- * IRQ 콜백에서 1로 설정되고, CheckStatus 함수에서 0으로 클리어된다.
+ * @brief NRF24 SPI 뮤텍스를 얻는다.
+ * @retval 1 획득 성공 (또는 뮤텍스 생성 전 초기화 단계), 0 타임아웃
  */
-static volatile uint8_t nrf_irq_flag = 0;
+static uint8_t CommHandler_Lock(void)
+{
+    if (g_nrf24MutexHandle == NULL)
+    {
+        return 1; // 커널 시작 전(CommHandler_Init)에는 경쟁 태스크가 없다.
+    }
+    if (osMutexAcquire(g_nrf24MutexHandle, COMM_SPI_LOCK_TIMEOUT_MS) != osOK)
+    {
+        g_commStats.spi_lock_timeout_count++;
+        return 0;
+    }
+    return 1;
+}
+
+static void CommHandler_Unlock(void)
+{
+    if (g_nrf24MutexHandle != NULL)
+    {
+        osMutexRelease(g_nrf24MutexHandle);
+    }
+}
 
 /**
  * @brief NRF24 모듈을 송신(Tx) 모드로 초기화한다.
  * @note 주소, 채널, 데이터 속도, 자동 재전송 등 통신 파라미터를 설정한다.
+ * 단일 바이트 레지스터는 `tx_config` 테이블로 일괄 적용하므로 읽기-수정-쓰기 SPI 트랜잭션이 없다.
  * ACK 페이로드를 수신하기 위해 Rx 파이프 0번도 함께 설정한다.
  */
 void CommHandler_Init(void)
@@ -57,86 +100,125 @@ void CommHandler_Init(void)
     HAL_Delay(5);
     ce_low();
 
-    nrf24_init();
-    nrf24_stop_listen();                // 송신 모드로 설정
-    nrf24_auto_ack_all(auto_ack);       // 모든 파이프에 대해 자동 ACK 활성화
-    nrf24_en_ack_pld(enable);           // ACK 페이로드 기능 활성화
-    nrf24_dpl(disable);                 // 동적 페이로드 길이 비활성화
-    nrf24_set_crc(enable, _1byte);      // 1바이트 CRC 활성화
-    nrf24_tx_pwr(_0dbm);                // 송신 출력 0dBm 설정
-    nrf24_data_rate(_2mbps);            // 데이터 속도 2Mbps 설정 (수신기와 동일하게)
-    nrf24_set_channel(90);              // RF 채널 90번 설정
-    nrf24_set_addr_width(5);            // 주소 폭 5바이트 설정
-    nrf24_auto_retr_delay(4);           // 자동 재전송 딜레이 1000us (250 * (4+1))
-    nrf24_auto_retr_limit(10);          // 자동 재전송 횟수 10회로 제한
+    nrf24_init();                       // 레지스터 섀도우 동기화, 전원 ON, FIFO/플래그 초기화
+    nrf24_apply_config(tx_config, sizeof(tx_config) / sizeof(tx_config[0])); // 통신 파라미터 일괄 적용
     nrf24_open_tx_pipe(tx_addr);        // 송신 파이프 열기
     nrf24_open_rx_pipe(0, tx_addr);     // ACK 페이로드 수신을 위한 Rx 파이프 0번 열기
-    nrf24_pipe_pld_size(0, ACK_PAYLOAD_SIZE); // 파이프 0번의 페이로드 크기 설정
 }
 
 /**
  * @brief NRF24 모듈의 IRQ 핀 외부 인터럽트(EXTI) 발생 시 호출되는 콜백 함수
  * @note 이 함수는 ISR 컨텍스트에서 실행된다.
- * 송신 완료 또는 실패 이벤트를 메인 로직에 알리기 위해 `nrf_irq_flag`를 1로 설정한다.
+ * SPI 접근 없이 ackHandlerTask에 스레드 플래그만 전달하고, 상태 확인은 태스크에서 수행한다.
  */
 void CommHandler_IrqCallback(void)
 {
-    nrf_irq_flag = 1;
+    if (osKernelGetState() != osKernelRunning)
+    {
+        return; // 스케줄러 시작 전에는 처리할 태스크가 없으므로 무시
+    }
+
+    osThreadFlagsSet(ackHandlerTaskHandle, COMM_FLAG_IRQ);
 }
 
 /**
  * @brief 지정된 페이로드를 비동기 방식으로 송신한다.
  * @param payload 전송할 데이터가 담긴 버퍼의 포인터
  * @param len 전송할 데이터의 길이
- * @note 이 함수는 전송을 시작만 할 뿐, 완료를 기다리지 않는다.
+ * @retval COMM_OK 페이로드를 TX FIFO에 적재하고 전송을 시작함.
+ * @retval COMM_TX_BUSY TX FIFO가 가득 차 이번 패킷을 건너뜀.
+ * @note 이 함수는 전송을 시작만 할 뿐, 완료를 기다리지 않는다. (CE 펄스 약 10us)
  * 전송 결과는 IRQ 발생 후 `CommHandler_CheckStatus`를 통해 확인해야 한다.
+ * 재전송 중인 이전 패킷 뒤에 오래된 명령이 쌓이지 않도록, FIFO가 가득 차면 새 패킷을 버린다.
+ * SPI 뮤텍스를 얻지 못한 경우에도 이번 패킷을 건너뛴다. (다음 샘플이 최신 값으로 다시 전송됨)
  */
-void CommHandler_Transmit(uint8_t* payload, uint8_t len)
+CommStatus_t CommHandler_Transmit(uint8_t* payload, uint8_t len)
 {
-    nrf24_transmit(payload, len);
+    if (!CommHandler_Lock())
+    {
+        return COMM_TX_BUSY;
+    }
+
+    uint8_t full = nrf24_transmit_async(payload, len);
+    CommHandler_Unlock();
+
+    if (full != 0)
+    {
+        g_commStats.tx_busy_count++;
+        return COMM_TX_BUSY;
+    }
+    return COMM_OK;
 }
 
 /**
  * @brief IRQ 발생 후 통신 상태를 확인하고 결과를 반환한다.
  * @param ack_payload 수신된 ACK 페이로드를 저장할 버퍼의 포인터
  * @param len `ack_payload` 버퍼의 크기
- * @retval COMM_TX_SUCCESS 송신 성공 및 ACK 페이로드 수신 완료.
+ * @retval COMM_TX_ACK_PAYLOAD 송신 성공 및 ACK 페이로드 수신 완료.
+ * @retval COMM_TX_SUCCESS 송신 성공, ACK 페이로드 없음.
  * @retval COMM_TX_FAIL 최대 재전송 횟수 초과로 송신 실패.
- * @retval COMM_OK IRQ 이벤트가 발생하지 않은 상태.
- * @note NRF24 상태 레지스터를 읽어 TX_DS(송신 성공) 또는 MAX_RT(송신 실패) 비트를 확인한다.
- * 확인 후에는 해당 플래그를 클리어하여 다음 인터럽트를 준비한다.
+ * @retval COMM_OK 처리할 이벤트가 없는 상태.
+ * @note 별도의 상태 레지스터 읽기 없이, R_RX_PAYLOAD 명령 바이트와 함께 출력되는 STATUS를 사용한다.
+ * RX_P_NO로 ACK 페이로드 유무를 판단하여 같은 SPI 트랜잭션에서 페이로드까지 읽고,
+ * 관찰한 인터럽트 비트만 1을 써서 한 번에 클리어한다. (이벤트당 SPI 트랜잭션 2회)
+ * 읽기부터 클리어까지 SPI 뮤텍스를 쥐고 있으므로 그 사이에 commTask의 송신이 끼어들지 않는다.
+ * 뮤텍스를 얻지 못하면 COMM_OK를 반환하고, 다음 `COMM_IRQ_TIMEOUT_MS` 폴링에서 다시 확인한다.
  */
 CommStatus_t CommHandler_CheckStatus(uint8_t* ack_payload, uint8_t len)
 {
-    // IRQ 플래그가 설정되지 않았으면 확인할 이벤트가 없으므로 종료한다.
-    if (nrf_irq_flag == 0)
+    CommStatus_t result = COMM_OK;
+
+    if (!CommHandler_Lock())
     {
         return COMM_OK;
     }
 
-    nrf_irq_flag = 0; // 플래그를 다시 클리어한다.
+    // R_RX_PAYLOAD 명령 바이트 전송 중 STATUS가 함께 수신된다.
+    csn_low();
+    nrf24_w_spec_cmd(R_RX_PAYLOAD);
+    uint8_t status = nrf24_last_status();
+    uint8_t ack_received = (((status >> RX_P_NO) & RX_P_NO_MASK) != RX_P_NO_EMPTY);
+    if (ack_received)
+    {
+        nrf24_r_spec_reg(ack_payload, len); // ACK 페이로드 읽기
+    }
+    csn_high();
 
-    uint8_t status = nrf24_r_status();
-    CommStatus_t result = COMM_OK;
+    uint8_t irq = status & STATUS_IRQ_MASK;
+    if (irq == 0 && !ack_received)
+    {
+        CommHandler_Unlock();
+        return COMM_OK;
+    }
 
     // TX_DS 비트가 1이면: 송신 성공 및 ACK 수신
     if (status & (1 << TX_DS))
     {
-        // 수신 FIFO에 ACK 페이로드가 있는지 확인
-        if (nrf24_data_available())
-        {
-            nrf24_receive(ack_payload, len); // ACK 페이로드 읽기
-        }
-        nrf24_clear_tx_ds(); // TX_DS 플래그 클리어
+        g_commStats.tx_ds_count++;
         result = COMM_TX_SUCCESS;
     }
     // MAX_RT 비트가 1이면: 최대 재전송 횟수 초과로 송신 실패
     else if (status & (1 << MAX_RT))
     {
-        nrf24_flush_tx();      // TX FIFO를 비운다.
-        nrf24_clear_max_rt();  // MAX_RT 플래그 클리어
+        nrf24_flush_tx(); // TX FIFO를 비운다.
+        g_commStats.max_rt_count++;
         result = COMM_TX_FAIL;
     }
 
+    if (ack_received)
+    {
+        g_commStats.ack_payload_count++;
+        if (result == COMM_TX_SUCCESS)
+        {
+            result = COMM_TX_ACK_PAYLOAD;
+        }
+    }
+
+    if (irq != 0)
+    {
+        nrf24_w_reg(STATUS, &irq, 1); // 관찰한 인터럽트 비트만 클리어 (write-1-to-clear)
+    }
+    CommHandler_Unlock();
+
     return result;
 }
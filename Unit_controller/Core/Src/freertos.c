@@ -32,6 +32,7 @@
 #include "ssd1306.h"
 #include "fonts.h"
 #include "app_logic.h" // Use the new application logic header
+#include "mailbox.h"
 
 /* USER CODE END Includes */
 
@@ -42,6 +43,7 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define SENSOR_FLAG_NEW_ROLL 0x0001U // commTask 스레드 플래그: 새 roll 값이 메일박스에 게시됨
 
 /* USER CODE END PD */
 
@@ -58,6 +60,20 @@
    const osMutexAttr_t g_displayDataMutex_attributes = {
      .name = "displayDataMutex"
    };
+
+// NRF24 SPI(SPI1/CSN) mutex: commTask(송신)와 ackHandlerTask(상태 확인)가 공유
+   osMutexId_t g_nrf24MutexHandle;
+   const osMutexAttr_t g_nrf24Mutex_attributes = {
+     .name = "nrf24Mutex",
+     .attr_bits = osMutexPrioInherit
+   };
+
+/**
+ * @brief sensorTask(생산자) → commTask(소비자)로 최신 roll 값을 전달하는 메일박스
+ * @note commTask가 전송 중일 때 들어온 값은 덮어써지므로, 다음 전송에는 항상 최신 자세가 실린다.
+ */
+static uint8_t sensor_mailbox_storage[MAILBOX_STORAGE_SIZE(sizeof(float))];
+static Mailbox_t sensorMailbox = MAILBOX_INITIALIZER(sensor_mailbox_storage, sizeof(float));
 /* USER CODE END Variables */
 /* Definitions for commTask */
 osThreadId_t commTaskHandle;
@@ -87,16 +103,6 @@ const osThreadAttr_t DisplayTask_attributes = {
   .stack_size = 256 * 4,
   .priority = (osPriority_t) osPriorityNormal,
 };
-/* Definitions for sensorQueue */
-osMessageQueueId_t sensorQueueHandle;
-const osMessageQueueAttr_t sensorQueue_attributes = {
-  .name = "sensorQueue"
-};
-/* Definitions for ackSem */
-osSemaphoreId_t ackSemHandle;
-const osSemaphoreAttr_t ackSem_attributes = {
-  .name = "ackSem"
-};
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN FunctionPrototypes */
@@ -123,12 +129,9 @@ void MX_FREERTOS_Init(void) {
   /* USER CODE BEGIN RTOS_MUTEX */
   /* add mutexes, ... */
   g_displayDataMutexHandle = osMutexNew(&g_displayDataMutex_attributes);
+  g_nrf24MutexHandle = osMutexNew(&g_nrf24Mutex_attributes);
   /* USER CODE END RTOS_MUTEX */
 
-  /* Create the semaphores(s) */
-  /* creation of ackSem */
-  ackSemHandle = osSemaphoreNew(1, 0, &ackSem_attributes);
-
   /* USER CODE BEGIN RTOS_SEMAPHORES */
   /* add semaphores, ... */
   /* USER CODE END RTOS_SEMAPHORES */
@@ -137,10 +140,6 @@ void MX_FREERTOS_Init(void) {
   /* start timers, add new ones, ... */
   /* USER CODE END RTOS_TIMERS */
 
-  /* Create the queue(s) */
-  /* creation of sensorQueue */
-  sensorQueueHandle = osMessageQueueNew (1, sizeof(float), &sensorQueue_attributes);
-
   /* USER CODE BEGIN RTOS_QUEUES */
   /* add queues, ... */
   /* USER CODE END RTOS_QUEUES */
@@ -176,9 +175,11 @@ void MX_FREERTOS_Init(void) {
 * @retval None
 * @note 이 태스크는 다음과 같은 순서로 동작한다:
 * 1. `App_GetRollAngle` 함수를 호출하여 현재 차량의 롤 각도를 얻음.
-* 2. `osMessageQueuePut`을 사용하여 측정된 롤 각도 값을 `sensorQueueHandle` 메시지 큐에 전송한다.
-* 이를 통해 commTask가 이 값을 사용할 수 있다.
-* 3. `osDelay`를 사용하여 `SENSOR_TASK_PERIOD_MS` (5ms) 만큼 대기하며, 일정한 주기로 센서 값을 측정하도록 보장한다.
+*    DMA 모드에서는 MPU6050 Data Ready → I2C DMA 완료 알림이 올 때까지 블로킹된다.
+* 2. `Mailbox_Put`으로 측정된 롤 각도 값을 메일박스에 게시하고, 스레드 플래그로 commTask를 깨운다.
+* commTask가 아직 읽지 않은 이전 값은 덮어써지므로 commTask는 항상 최신 값을 사용한다.
+* 3. POLL/FIFO 모드에서는 `osDelay`를 사용하여 `SENSOR_TASK_PERIOD_MS` (5ms) 만큼 대기한다.
+*    DMA 모드에서는 센서 샘플 클럭이 주기를 결정하므로 지연을 두지 않는다.
 */
 /* USER CODE END Header_StartsensorTask */
 void StartsensorTask(void *argument)
@@ -189,9 +190,12 @@ void StartsensorTask(void *argument)
   {
     float roll = App_GetRollAngle(); // IMU 센서로부터 roll값 갱신
 
-    osMessageQueuePut(sensorQueueHandle, &roll, 0U, 0U); // 큐를 통해 송신 태스크(commTask)로 전송
+    Mailbox_Put(&sensorMailbox, &roll); // 메일박스를 통해 송신 태스크(commTask)로 전송
+    osThreadFlagsSet(commTaskHandle, SENSOR_FLAG_NEW_ROLL);
 
-    osDelay(SENSOR_TASK_PERIOD_MS); // 5ms 주기 대기
+#if MPU6050_ACQ_MODE != MPU6050_ACQ_DMA
+    osDelay(SENSOR_TASK_PERIOD_MS); // 5ms 주기 대기 (DMA 모드에서는 센서 Data Ready가 주기를 결정)
+#endif
   }
   /* USER CODE END StartsensorTask */
 }
@@ -202,9 +206,9 @@ void StartsensorTask(void *argument)
   * @param  argument: None
   * @retval None
   * @note   이 태스크는 다음과 같은 순서로 동작한다:
-  * 1. `sensorQueueHandle` 메시지 큐에 새로운 데이터가 들어올 때까지 무한 대기한다.
-  * 2. 큐에서 롤 각도 값을 성공적으로 수신하면, 이 값을 이용해 전송용 패킷을 만든다.
-  * 3. 완성된 패킷을 통신 핸들러를 통해 외부로 전송한다.
+  * 1. sensorTask가 보내는 `SENSOR_FLAG_NEW_ROLL` 스레드 플래그가 올 때까지 무한 대기한다.
+  * 2. 메일박스에서 최신 롤 각도 값을 꺼내면, 이 값을 이용해 전송용 패킷을 만든다.
+  * 3. 완성된 패킷을 통신 핸들러를 통해 외부로 전송한다. (NRF24 SPI 뮤텍스로 ackHandlerTask와 직렬화)
   * 4. 위 과정을 무한 반복한다.
   */
 /* USER CODE END Header_StartcommTask */
@@ -217,11 +221,15 @@ void StartcommTask(void *argument)
   /* Infinite loop */
   for(;;)
   {
-     osMessageQueueGet(sensorQueueHandle, &roll, NULL, osWaitForever); // 블로킹 상태로 대기 및 roll 값 수신
+     osThreadFlagsWait(SENSOR_FLAG_NEW_ROLL, osFlagsWaitAny, osWaitForever); // 블로킹 상태로 대기
+     if (!Mailbox_Get(&sensorMailbox, &roll)) // 최신 roll 값 수신
+     {
+         continue; // 이전 알림에서 이미 최신 값을 처리함
+     }
 
      App_BuildPacket(tx_packet, roll); // 데이터 패키징
 
-     CommHandler_Transmit(tx_packet, PAYLOAD_SIZE); // 차량부로 패킷 전송
+     CommHandler_Transmit(tx_packet, PAYLOAD_SIZE); // 차량부로 패킷 전송 (비동기, 결과는 IRQ로 확인)
   }
   /* USER CODE END StartcommTask */
 }
@@ -232,9 +240,12 @@ void StartcommTask(void *argument)
 * @param  argument: 사용되지 않는다.
 * @retval None
 * @note   이 태스크는 통신 인터럽트가 발생할 때마다 동작하며, 다음과 같은 순서로 실행된다:
-* 1. `ackSemHandle` 세마포어를 통해 통신 모듈의 전송 완료(TX DR) 또는 최대 재전송 실패(MAX_RT) 인터럽트가 발생하기를 기다린다.
-* 2. 인터럽트가 발생하면 `CommHandler_CheckStatus`를 호출하여 통신 상태(성공/실패)를 확인하고, 수신된 ACK 페이로드를 `ack_packet` 버퍼에 저장한다.
-* 3. 통신이 성공했다면(COMM_TX_SUCCESS), `App_HandleAckPayload`를 호출하여 ACK 페이로드 데이터를 처리하고, 뮤텍스를 사용하여 공유 변수 `g_displayData.comm_ok`를 1(성공)로 업데이트한다.
+* 1. IRQ 콜백이 보내는 스레드 플래그(`COMM_FLAG_IRQ`)로 통신 모듈의 전송 완료(TX_DS) 또는 최대 재전송 실패(MAX_RT) 인터럽트를 기다린다.
+*    IRQ 에지를 놓쳐도 멈추지 않도록 `COMM_IRQ_TIMEOUT_MS`마다 상태를 직접 확인한다.
+*    상태 확인 SPI 트랜잭션은 `g_nrf24MutexHandle`로 commTask의 송신과 직렬화된다.
+* 2. `CommHandler_CheckStatus`가 상태 레지스터를 한 번 읽어 결과(성공/실패/ACK 페이로드)를 판별하고, ACK 페이로드를 `ack_packet` 버퍼에 저장한다.
+* 3. 통신이 성공했다면, 뮤텍스를 사용하여 공유 변수 `g_displayData.comm_ok`를 1(성공)로 업데이트하고,
+*    ACK 페이로드가 수신된 경우(COMM_TX_ACK_PAYLOAD) `App_HandleAckPayload`로 햅틱/RPM 데이터를 처리한다.
 * 4. 통신이 실패했다면(COMM_TX_FAIL), 뮤텍스를 사용하여 `g_displayData.comm_ok`를 0(실패)으로 업데이트한다.
 */
 /* USER CODE END Header_StartackHandlerTask */
@@ -246,15 +257,22 @@ void StartackHandlerTask(void *argument)
   /* Infinite loop */
   for(;;)
   {
-      // ACK 관련 인터럽트(TX DR 또는 MAX_RT)가 발생할 때까지 세마포어를 기다린다.
-      osSemaphoreAcquire(ackSemHandle, osWaitForever); // ACK 응답 신호 인터럽트 발생 대기
+      // ACK 관련 인터럽트(TX_DS 또는 MAX_RT)가 발생할 때까지 스레드 플래그를 기다린다.
+      uint32_t flags = osThreadFlagsWait(COMM_FLAG_IRQ, osFlagsWaitAny, COMM_IRQ_TIMEOUT_MS);
+      if ((flags & osFlagsError) != 0U)
+      {
+          g_commStats.irq_timeout_count++; // IRQ 누락 대비: 상태 레지스터를 직접 확인
+      }
 
       CommStatus_t status = CommHandler_CheckStatus(ack_packet, ACK_PAYLOAD_SIZE); // 통신 상태 확인 및 응답 패킷 복제
 
 
-      if (status == COMM_TX_SUCCESS)
+      if (status == COMM_TX_SUCCESS || status == COMM_TX_ACK_PAYLOAD)
       {
-          App_HandleAckPayload(ack_packet); // 진동 동작 판단
+          if (status == COMM_TX_ACK_PAYLOAD)
+          {
+              App_HandleAckPayload(ack_packet); // 진동 동작 판단 및 RPM 갱신
+          }
 
           if (osMutexAcquire(g_displayDataMutexHandle, 10) == osOK) // 뮤택스를 통해 공유변수 접근
           {
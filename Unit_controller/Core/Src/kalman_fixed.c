@@ -0,0 +1,193 @@
+/**
+ * @file kalman_fixed.c
+ * @brief MPU6050 자세(roll/pitch) 추정을 위한 고정소수점 칼만 필터 및 정수 삼각함수를 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note Cortex-M3(STM32F103)에는 FPU가 없어 double 연산이 소프트웨어 에뮬레이션으로 처리된다.
+ * 이 모듈은 atan/sqrt/칼만 갱신을 모두 정수 연산(Q16/Q31)으로 대체하여 sensorTask의 CPU 점유를 줄인다.
+ *
+ * 오차 한계 (double 구현 대비):
+ * - Fixed_Atan2Deg : CORDIC 16회 반복, 잔여 각도 < atan(2^-15) ≈ 0.0018°, 테이블 양자화 포함 |오차| ≤ 0.003°
+ * - Fixed_Sqrt     : 정수 제곱근(내림), 1g(≈16384 LSB) 입력 기준 상대오차 < 1e-4 → roll 환산 ≤ 0.004°
+ * - KalmanQ_getAngle : 상태 Q16(1.5e-5°), 공분산/이득 Q31(4.7e-10) 양자화. 필터가 안정하므로 누적되지 않는다.
+ * → 최종 roll 추정값은 double 구현 대비 |오차| ≤ 0.01° 이내를 설계 목표로 한다.
+ *   (전송 패킷의 roll 분해능 0.01°(x100 인코딩)와 같은 수준)
+ */
+
+#include "kalman_fixed.h"
+
+#define CORDIC_ITERATIONS 16
+#define DEG_180_Q16       ((q16_t)180 << Q16_SHIFT)
+
+/**
+ * @brief atan(2^-i)를 Q16 도(°) 단위로 나타낸 CORDIC 각도 테이블
+ */
+static const q16_t cordic_atan_table[CORDIC_ITERATIONS] = {
+    2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+    14668,   7334,    3667,   1833,   917,    458,    229,   115
+};
+
+/**
+ * @brief 두 Q31 값을 곱해 Q31 결과를 반올림하여 반환한다.
+ */
+static inline q31_t mul_q31(q31_t a, q31_t b)
+{
+    return (q31_t)(((int64_t)a * b + ((int64_t)1 << (Q31_SHIFT - 1))) >> Q31_SHIFT);
+}
+
+/**
+ * @brief Q31 계수와 Q16 값을 곱해 Q16 결과를 반올림하여 반환한다.
+ */
+static inline q16_t mul_q31_q16(q31_t a, q16_t b)
+{
+    return (q16_t)(((int64_t)a * b + ((int64_t)1 << (Q31_SHIFT - 1))) >> Q31_SHIFT);
+}
+
+/**
+ * @brief Q31 나눗셈 (num / den). 결과는 [-1, 1) 범위로 포화된다.
+ * @note den은 항상 양수(P00 + R_measure)로 호출된다.
+ */
+static inline q31_t div_q31(q31_t num, q31_t den)
+{
+    int64_t q = ((int64_t)num << Q31_SHIFT) / den;
+
+    if (q > INT32_MAX) q = INT32_MAX;
+    if (q < INT32_MIN) q = INT32_MIN;
+    return (q31_t)q;
+}
+
+/**
+ * @brief 칼만 필터로 새 각도를 추정한다. (Kalman_getAngle의 고정소수점 버전)
+ * @param Kalman 필터 상태 구조체
+ * @param newAngle 가속도계 기반 측정 각도 (Q16, °)
+ * @param newRate 자이로 각속도 (Q16, °/s)
+ * @param dt 샘플 간격 (Q31, s). 1초 미만이어야 한다.
+ * @retval 추정 각도 (Q16, °)
+ * @note 연산 순서는 double 구현과 동일하며, 곱셈은 64비트 중간값으로 수행하여 오버플로우를 방지한다.
+ */
+q16_t KalmanQ_getAngle(KalmanQ_t *Kalman, q16_t newAngle, q16_t newRate, q31_t dt)
+{
+    q16_t rate = newRate - Kalman->bias;
+    Kalman->angle += mul_q31_q16(dt, rate);
+
+    Kalman->P[0][0] += mul_q31(dt, mul_q31(dt, Kalman->P[1][1]) - Kalman->P[0][1] - Kalman->P[1][0] + Kalman->Q_angle);
+    Kalman->P[0][1] -= mul_q31(dt, Kalman->P[1][1]);
+    Kalman->P[1][0] -= mul_q31(dt, Kalman->P[1][1]);
+    Kalman->P[1][1] += mul_q31(Kalman->Q_bias, dt);
+
+    q31_t S = Kalman->P[0][0] + Kalman->R_measure;
+    q31_t K[2];
+    K[0] = div_q31(Kalman->P[0][0], S);
+    K[1] = div_q31(Kalman->P[1][0], S);
+
+    q16_t y = newAngle - Kalman->angle;
+    Kalman->angle += mul_q31_q16(K[0], y);
+    Kalman->bias += mul_q31_q16(K[1], y);
+
+    q31_t P00_temp = Kalman->P[0][0];
+    q31_t P01_temp = Kalman->P[0][1];
+
+    Kalman->P[0][0] -= mul_q31(K[0], P00_temp);
+    Kalman->P[0][1] -= mul_q31(K[0], P01_temp);
+    Kalman->P[1][0] -= mul_q31(K[1], P00_temp);
+    Kalman->P[1][1] -= mul_q31(K[1], P01_temp);
+
+    return Kalman->angle;
+}
+
+/**
+ * @brief CORDIC 벡터링 모드로 atan2(y, x)를 계산한다.
+ * @param y, x 정수 입력 (센서 RAW 값 범위)
+ * @retval 각도 (Q16, °), 범위 (-180°, 180°]
+ * @note 입력은 정밀도 확보를 위해 최상위 비트가 2^28 근처가 되도록 정규화한 뒤 회전한다.
+ * CORDIC 이득(≈1.647)을 고려해도 |x|,|y| < 2^31 범위를 벗어나지 않는다.
+ */
+q16_t Fixed_Atan2Deg(int32_t y, int32_t x)
+{
+    q16_t z = 0;
+
+    if (x == 0 && y == 0)
+    {
+        return 0;
+    }
+
+    // 좌반면 입력은 180° 회전하여 CORDIC 수렴 범위(±99.7°) 안으로 가져온다.
+    if (x < 0)
+    {
+        z = (y >= 0) ? DEG_180_Q16 : -DEG_180_Q16;
+        x = -x;
+        y = -y;
+    }
+
+    uint32_t ax = (uint32_t)x;
+    uint32_t ay = (uint32_t)((y < 0) ? -y : y);
+    uint32_t max = (ax > ay) ? ax : ay;
+    int shift = __builtin_clz(max) - 3; // 최상위 비트를 bit28로 정렬
+
+    if (shift > 0)
+    {
+        x = (int32_t)((uint32_t)x << shift);
+        y = (y < 0) ? -(int32_t)(ay << shift) : (int32_t)(ay << shift);
+    }
+    else if (shift < 0)
+    {
+        x >>= -shift;
+        y >>= -shift;
+    }
+
+    for (int i = 0; i < CORDIC_ITERATIONS; i++)
+    {
+        int32_t x_shift = x >> i;
+        int32_t y_shift = y >> i;
+
+        if (y > 0)
+        {
+            x += y_shift;
+            y -= x_shift;
+            z += cordic_atan_table[i];
+        }
+        else
+        {
+            x -= y_shift;
+            y += x_shift;
+            z -= cordic_atan_table[i];
+        }
+    }
+
+    if (z > DEG_180_Q16) z -= 2 * DEG_180_Q16;
+    if (z <= -DEG_180_Q16) z += 2 * DEG_180_Q16;
+
+    return z;
+}
+
+/**
+ * @brief 32비트 정수 제곱근 (비트 단위 계산, 내림)
+ * @param x 입력값
+ * @retval floor(sqrt(x))
+ */
+uint32_t Fixed_Sqrt(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > x)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (x >= res + bit)
+        {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return res;
+}
@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "cmsis_os.h"
+#include "dma.h"
 #include "i2c.h"
 #include "spi.h"
 #include "tim.h"
@@ -31,6 +32,8 @@
 #include "input_handler.h"
 #include "comm_handler.h"
 #include "ssd1306.h"
+#include "app_logic.h"
+#include "timebase.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -93,11 +96,13 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_I2C2_Init();
   MX_TIM2_Init();
   MX_SPI1_Init();
   MX_I2C1_Init();
   /* USER CODE BEGIN 2 */
+  Timebase_Init(); // IMU dt 계산용 µs 타임베이스
   InputHandler_Init();
   CommHandler_Init();
 
@@ -179,17 +184,34 @@ void SystemClock_Config(void)
 // --- 콜백 함수들은 각 핸들러에게 작업을 위임 ---
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
-    // USER CODE BEGIN Callback 0
-    extern osSemaphoreId_t ackSemHandle; // CubeMX가 생성한 세마포어 핸들
-    // USER CODE END Callback 0
-
-    if (GPIO_Pin == GPIO_PIN_3)
+    if (GPIO_Pin == IRQ_Pin)
+    {
+        CommHandler_IrqCallback(); // NRF24 IRQ(TX_DS/MAX_RT) -> ackHandlerTask 알림
+        return;
+    }
+    if (GPIO_Pin == MPU_INT_Pin)
     {
-        osSemaphoreRelease(ackSemHandle); // 세마포어를 해제하여 ackHandlerTask를 깨움
+        App_ImuDataReadyCallback(); // MPU6050 Data Ready -> I2C DMA 버스트 시작
         return;
     }
     InputHandler_GpioCallback(GPIO_Pin);
 }
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C2)
+    {
+        App_ImuReadCpltCallback(); // sensorTask 깨움
+    }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C2)
+    {
+        App_ImuErrorCallback();
+    }
+}
 /* USER CODE END 4 */
 
 /**
@@ -33,6 +33,7 @@
 
 #include <math.h>
 #include <mpu6050.h>
+#include "timebase.h"
 
 #define RAD_TO_DEG 57.295779513082320876798154814105
 
@@ -44,13 +45,33 @@
 #define TEMP_OUT_H_REG 0x41
 #define GYRO_CONFIG_REG 0x1B
 #define GYRO_XOUT_H_REG 0x43
+#define CONFIG_REG 0x1A
+#define INT_PIN_CFG_REG 0x37
+#define INT_ENABLE_REG 0x38
+#define FIFO_EN_REG 0x23
+#define USER_CTRL_REG 0x6A
+#define FIFO_COUNTH_REG 0x72
+#define FIFO_R_W_REG 0x74
+
+#define FIFO_EN_ACCEL_GYRO 0x78 // XG_FIFO_EN | YG_FIFO_EN | ZG_FIFO_EN | ACCEL_FIFO_EN
+#define USER_CTRL_FIFO_EN 0x40
+#define USER_CTRL_FIFO_RESET 0x04
 
 // Setup MPU6050
 #define MPU6050_ADDR 0xD0
 const uint16_t i2c_timeout = 100;
 const double Accel_Z_corrector = 14418.0;
 
-uint32_t timer;
+uint32_t timer; // last sample timestamp (us, Timebase)
+
+#if MPU6050_ACQ_MODE == MPU6050_ACQ_FIFO
+MPU6050_FifoStats_t MPU6050_FifoStats;
+
+static uint8_t fifo_rx_data[MPU6050_FIFO_MAX_BURST * MPU6050_FIFO_FRAME_LEN];
+#endif
+
+// I2C DMA burst buffer (filled by MPU6050_Read_All_DMA, parsed by MPU6050_Process_All)
+static uint8_t dma_rx_data[MPU6050_BURST_LEN];
 
 Kalman_t KalmanX = {
     .Q_angle = 0.001f,
@@ -63,6 +84,27 @@ Kalman_t KalmanY = {
     .R_measure = 0.03f,
 };
 
+static void MPU6050_Parse_All(const uint8_t *Rec_Data, MPU6050_t *DataStruct, uint32_t dt_us);
+static void MPU6050_Solve(MPU6050_t *DataStruct, uint32_t dt_us);
+
+#if MPU6050_USE_FIXED_POINT
+#define DT_MAX_US 500000 // Q31 dt 표현 범위(<1s) 보호용 상한
+#define DEG_90_Q16 ((q16_t)90 << Q16_SHIFT)
+
+KalmanQ_t KalmanQX = {
+    .Q_angle = Q31_FROM_DOUBLE(0.001),
+    .Q_bias = Q31_FROM_DOUBLE(0.003),
+    .R_measure = Q31_FROM_DOUBLE(0.03)};
+
+KalmanQ_t KalmanQY = {
+    .Q_angle = Q31_FROM_DOUBLE(0.001),
+    .Q_bias = Q31_FROM_DOUBLE(0.003),
+    .R_measure = Q31_FROM_DOUBLE(0.03),
+};
+
+static void MPU6050_Solve_Fixed(MPU6050_t *DataStruct, uint32_t dt_us);
+#endif
+
 uint8_t MPU6050_Init(I2C_HandleTypeDef *I2Cx)
 {
     uint8_t check;
@@ -91,6 +133,30 @@ uint8_t MPU6050_Init(I2C_HandleTypeDef *I2Cx)
         // XG_ST=0,YG_ST=0,ZG_ST=0, FS_SEL=0 -> � 250 �/s
         Data = 0x00;
         HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, GYRO_CONFIG_REG, 1, &Data, 1, i2c_timeout);
+
+#if MPU6050_ACQ_MODE == MPU6050_ACQ_DMA
+        // DLPF on -> gyro output rate 1kHz, SMPLRT_DIV -> data ready every MPU6050_DRDY_PERIOD_MS
+        Data = MPU6050_DRDY_DLPF_CFG;
+        HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, CONFIG_REG, 1, &Data, 1, i2c_timeout);
+
+        Data = MPU6050_DRDY_SMPLRT_DIV;
+        HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, SMPLRT_DIV_REG, 1, &Data, 1, i2c_timeout);
+
+        // INT pin: active high, push-pull, 50us pulse, status cleared by any read
+        Data = 0x10;
+        HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, INT_PIN_CFG_REG, 1, &Data, 1, i2c_timeout);
+
+        // DATA_RDY_EN
+        Data = 0x01;
+        HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, INT_ENABLE_REG, 1, &Data, 1, i2c_timeout);
+#elif MPU6050_ACQ_MODE == MPU6050_ACQ_FIFO
+        // FIFO keeps every 1kHz accel+gyro sample (12 bytes, temperature excluded)
+        Data = FIFO_EN_ACCEL_GYRO;
+        HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, FIFO_EN_REG, 1, &Data, 1, i2c_timeout);
+
+        Data = USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RESET;
+        HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, USER_CTRL_REG, 1, &Data, 1, i2c_timeout);
+#endif
         return 0;
     }
     return 1;
@@ -155,12 +221,96 @@ void MPU6050_Read_Temp(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct)
 
 void MPU6050_Read_All(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct)
 {
-    uint8_t Rec_Data[14];
-    int16_t temp;
+    uint8_t Rec_Data[MPU6050_BURST_LEN];
 
     // Read 14 BYTES of data starting from ACCEL_XOUT_H register
 
-    HAL_I2C_Mem_Read(I2Cx, MPU6050_ADDR, ACCEL_XOUT_H_REG, 1, Rec_Data, 14, i2c_timeout);
+    HAL_I2C_Mem_Read(I2Cx, MPU6050_ADDR, ACCEL_XOUT_H_REG, 1, Rec_Data, MPU6050_BURST_LEN, i2c_timeout);
+
+    uint32_t now = Timebase_GetMicros();
+    uint32_t dt_us = now - timer;
+    timer = now;
+    MPU6050_Parse_All(Rec_Data, DataStruct, dt_us);
+}
+
+// Start a 14-byte burst read into the internal buffer. Completion is reported by
+// HAL_I2C_MemRxCpltCallback(); the data is then converted with MPU6050_Process_All().
+// Call from task context only: the F1 HAL polls the address phase with HAL_GetTick
+// timeouts, which cannot expire inside an ISR that preempts the tick interrupt.
+HAL_StatusTypeDef MPU6050_Read_All_DMA(I2C_HandleTypeDef *I2Cx)
+{
+    return HAL_I2C_Mem_Read_DMA(I2Cx, MPU6050_ADDR, ACCEL_XOUT_H_REG, 1, dma_rx_data, MPU6050_BURST_LEN);
+}
+
+// Convert the last DMA burst. dt_us is supplied by the caller (data-ready timestamps).
+void MPU6050_Process_All(MPU6050_t *DataStruct, uint32_t dt_us)
+{
+    MPU6050_Parse_All(dma_rx_data, DataStruct, dt_us);
+}
+
+#if MPU6050_ACQ_MODE == MPU6050_ACQ_FIFO
+// Drain the FIFO in one burst and feed the decimated (averaged) sample to the
+// attitude filter. The gyro average times the batch length is the exact
+// integral over the batch, the accel average is a boxcar low-pass.
+// Returns the number of samples consumed (0: nothing new or overflow).
+uint16_t MPU6050_Read_FIFO(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct)
+{
+    uint8_t count_data[2];
+    MPU6050_FifoAccum_t accum = {0};
+
+    if (HAL_I2C_Mem_Read(I2Cx, MPU6050_ADDR, FIFO_COUNTH_REG, 1, count_data, 2, i2c_timeout) != HAL_OK)
+    {
+        MPU6050_FifoStats.error_count++;
+        return 0;
+    }
+
+    uint16_t fifo_count = (uint16_t)(count_data[0] << 8 | count_data[1]);
+
+    // A (nearly) full FIFO overwrites old data and loses frame alignment: reset it
+    if (fifo_count >= MPU6050_FIFO_SIZE - MPU6050_FIFO_FRAME_LEN)
+    {
+        uint8_t Data = USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RESET;
+        HAL_I2C_Mem_Write(I2Cx, MPU6050_ADDR, USER_CTRL_REG, 1, &Data, 1, i2c_timeout);
+        MPU6050_FifoStats.overflow_count++;
+        return 0;
+    }
+
+    uint16_t frames = fifo_count / MPU6050_FIFO_FRAME_LEN;
+    if (frames == 0)
+    {
+        return 0;
+    }
+    if (frames > MPU6050_FIFO_MAX_BURST)
+    {
+        frames = MPU6050_FIFO_MAX_BURST; // the rest is read on the next drain
+    }
+
+    if (HAL_I2C_Mem_Read(I2Cx, MPU6050_ADDR, FIFO_R_W_REG, 1, fifo_rx_data, frames * MPU6050_FIFO_FRAME_LEN, i2c_timeout) != HAL_OK)
+    {
+        MPU6050_FifoStats.error_count++;
+        return 0;
+    }
+
+    MPU6050_FIFO_Parse(fifo_rx_data, frames * MPU6050_FIFO_FRAME_LEN, &accum);
+    MPU6050_FifoStats.sample_count += accum.count;
+    MPU6050_FifoStats.drain_count++;
+
+    DataStruct->Accel_X_RAW = (int16_t)(accum.sum[0] / accum.count);
+    DataStruct->Accel_Y_RAW = (int16_t)(accum.sum[1] / accum.count);
+    DataStruct->Accel_Z_RAW = (int16_t)(accum.sum[2] / accum.count);
+    DataStruct->Gyro_X_RAW = (int16_t)(accum.sum[3] / accum.count);
+    DataStruct->Gyro_Y_RAW = (int16_t)(accum.sum[4] / accum.count);
+    DataStruct->Gyro_Z_RAW = (int16_t)(accum.sum[5] / accum.count);
+
+    MPU6050_Solve(DataStruct, (uint32_t)accum.count * MPU6050_FIFO_SAMPLE_PERIOD_US);
+
+    return accum.count;
+}
+#endif
+
+static void MPU6050_Parse_All(const uint8_t *Rec_Data, MPU6050_t *DataStruct, uint32_t dt_us)
+{
+    int16_t temp;
 
     DataStruct->Accel_X_RAW = (int16_t)(Rec_Data[0] << 8 | Rec_Data[1]);
     DataStruct->Accel_Y_RAW = (int16_t)(Rec_Data[2] << 8 | Rec_Data[3]);
@@ -170,17 +320,54 @@ void MPU6050_Read_All(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct)
     DataStruct->Gyro_Y_RAW = (int16_t)(Rec_Data[10] << 8 | Rec_Data[11]);
     DataStruct->Gyro_Z_RAW = (int16_t)(Rec_Data[12] << 8 | Rec_Data[13]);
 
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_TEMP
+    DataStruct->Temperature = (float)((int16_t)temp / (float)340.0 + (float)36.53);
+#else
+    (void)temp;
+#endif
+
+    MPU6050_Solve(DataStruct, dt_us);
+}
+
+// Scale the RAW values stored in DataStruct and update the Kalman angles
+static void MPU6050_Solve(MPU6050_t *DataStruct, uint32_t dt_us)
+{
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_SCALED
     DataStruct->Ax = DataStruct->Accel_X_RAW / 16384.0;
     DataStruct->Ay = DataStruct->Accel_Y_RAW / 16384.0;
     DataStruct->Az = DataStruct->Accel_Z_RAW / Accel_Z_corrector;
-    DataStruct->Temperature = (float)((int16_t)temp / (float)340.0 + (float)36.53);
     DataStruct->Gx = DataStruct->Gyro_X_RAW / 131.0;
     DataStruct->Gy = DataStruct->Gyro_Y_RAW / 131.0;
     DataStruct->Gz = DataStruct->Gyro_Z_RAW / 131.0;
+#endif
 
+#if MPU6050_USE_FIXED_POINT
+    MPU6050_Solve_Fixed(DataStruct, dt_us);
+#else
     // Kalman angle solve
-    double dt = (double)(HAL_GetTick() - timer) / 1000;
-    timer = HAL_GetTick();
+    double dt = (double)dt_us / 1000000;
+    double gx = DataStruct->Gyro_X_RAW / 131.0;
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_PITCH
+    double gy = DataStruct->Gyro_Y_RAW / 131.0;
+    double pitch = atan2(-DataStruct->Accel_X_RAW, DataStruct->Accel_Z_RAW) * RAD_TO_DEG;
+    if ((pitch < -90 && DataStruct->KalmanAngleY > 90) || (pitch > 90 && DataStruct->KalmanAngleY < -90))
+    {
+        KalmanY.angle = pitch;
+        DataStruct->KalmanAngleY = pitch;
+    }
+    else
+    {
+        DataStruct->KalmanAngleY = Kalman_getAngle(&KalmanY, pitch, gy, dt);
+    }
+    if (fabs(DataStruct->KalmanAngleY) > 90)
+    {
+        gx = -gx;
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_SCALED
+        DataStruct->Gx = -DataStruct->Gx;
+#endif
+    }
+#endif
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_ROLL
     double roll;
     double roll_sqrt = sqrt(
         DataStruct->Accel_X_RAW * DataStruct->Accel_X_RAW + DataStruct->Accel_Z_RAW * DataStruct->Accel_Z_RAW);
@@ -192,20 +379,71 @@ void MPU6050_Read_All(I2C_HandleTypeDef *I2Cx, MPU6050_t *DataStruct)
     {
         roll = 0.0;
     }
-    double pitch = atan2(-DataStruct->Accel_X_RAW, DataStruct->Accel_Z_RAW) * RAD_TO_DEG;
-    if ((pitch < -90 && DataStruct->KalmanAngleY > 90) || (pitch > 90 && DataStruct->KalmanAngleY < -90))
+    DataStruct->KalmanAngleX = Kalman_getAngle(&KalmanX, roll, gx, dt);
+#else
+    (void)gx;
+    (void)dt;
+#endif
+#endif
+}
+
+#if MPU6050_USE_FIXED_POINT
+// Kalman angle solve (Q16/Q31 fixed point, same flow as the double version)
+static void MPU6050_Solve_Fixed(MPU6050_t *DataStruct, uint32_t dt_us)
+{
+    if (dt_us > DT_MAX_US)
+        dt_us = DT_MAX_US;
+    q31_t dt = (q31_t)(((int64_t)dt_us << Q31_SHIFT) / 1000000);
+
+    int32_t ax = DataStruct->Accel_X_RAW;
+    int32_t az = DataStruct->Accel_Z_RAW;
+
+    // raw / 131 LSB/(deg/s) -> Q16 deg/s
+    q16_t gx = (q16_t)((int32_t)DataStruct->Gyro_X_RAW * Q16_ONE / 131);
+
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_PITCH
+    q16_t gy = (q16_t)((int32_t)DataStruct->Gyro_Y_RAW * Q16_ONE / 131);
+    q16_t pitch = Fixed_Atan2Deg(-ax, az);
+
+    if ((pitch < -DEG_90_Q16 && DataStruct->KalmanAngleY_Q16 > DEG_90_Q16) ||
+        (pitch > DEG_90_Q16 && DataStruct->KalmanAngleY_Q16 < -DEG_90_Q16))
     {
-        KalmanY.angle = pitch;
-        DataStruct->KalmanAngleY = pitch;
+        KalmanQY.angle = pitch;
+        DataStruct->KalmanAngleY_Q16 = pitch;
     }
     else
     {
-        DataStruct->KalmanAngleY = Kalman_getAngle(&KalmanY, pitch, DataStruct->Gy, dt);
+        DataStruct->KalmanAngleY_Q16 = KalmanQ_getAngle(&KalmanQY, pitch, gy, dt);
     }
-    if (fabs(DataStruct->KalmanAngleY) > 90)
+    if (DataStruct->KalmanAngleY_Q16 > DEG_90_Q16 || DataStruct->KalmanAngleY_Q16 < -DEG_90_Q16)
+    {
+        gx = -gx;
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_SCALED
         DataStruct->Gx = -DataStruct->Gx;
-    DataStruct->KalmanAngleX = Kalman_getAngle(&KalmanX, roll, DataStruct->Gx, dt);
+#endif
+    }
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_SCALED
+    DataStruct->KalmanAngleY = DataStruct->KalmanAngleY_Q16 / 65536.0;
+#endif
+#endif
+
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_ROLL
+    int32_t ay = DataStruct->Accel_Y_RAW;
+
+    // |ax|,|az| <= 32768 -> ax^2 + az^2 <= 2^31 : uint32 fits
+    uint32_t roll_sqrt = Fixed_Sqrt((uint32_t)(ax * ax) + (uint32_t)(az * az));
+    q16_t roll = (roll_sqrt != 0) ? Fixed_Atan2Deg(ay, (int32_t)roll_sqrt) : 0;
+
+    DataStruct->KalmanAngleX_Q16 = KalmanQ_getAngle(&KalmanQX, roll, gx, dt);
+#if MPU6050_OUTPUT_MASK & MPU6050_OUT_SCALED
+    DataStruct->KalmanAngleX = DataStruct->KalmanAngleX_Q16 / 65536.0;
+#endif
+#else
+    (void)gx;
+    (void)dt;
+#endif
 }
+#endif
 
 double Kalman_getAngle(Kalman_t *Kalman, double newAngle, double newRate, double dt)
 {
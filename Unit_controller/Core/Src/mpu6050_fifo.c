@@ -0,0 +1,26 @@
+/**
+ * @file mpu6050_fifo.c
+ * @brief MPU6050 FIFO 프레임 파서를 구현한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ */
+
+#include "mpu6050_fifo.h"
+
+uint16_t MPU6050_FIFO_Parse(const uint8_t *Rec_Data, uint16_t len, MPU6050_FifoAccum_t *Accum)
+{
+    uint16_t frames = len / MPU6050_FIFO_FRAME_LEN;
+
+    for (uint16_t f = 0; f < frames; f++)
+    {
+        const uint8_t *p = &Rec_Data[f * MPU6050_FIFO_FRAME_LEN];
+
+        for (uint8_t ch = 0; ch < 6; ch++)
+        {
+            Accum->sum[ch] += (int16_t)(p[2 * ch] << 8 | p[2 * ch + 1]);
+        }
+    }
+    Accum->count += frames;
+
+    return frames;
+}
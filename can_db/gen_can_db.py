@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""
+vehicle.dbc(CAN 신호 데이터베이스)로부터 차량부 ECU가 공유하는 can_db.h를 생성한다.
+
+사용법:
+    python3 can_db/gen_can_db.py            # 모든 차량부 유닛의 Core/Inc/can_db.h 갱신
+    python3 can_db/gen_can_db.py --check    # 생성 결과가 저장소의 파일과 같은지만 확인 (다르면 종료 코드 1)
+    python3 can_db/gen_can_db.py --selftest out.c [--dbc other.dbc]
+                                            # 모든 신호의 pack/unpack 왕복 시험 C 파일 생성 (host_tests에서 빌드)
+
+지원 범위 (DBC 부분 집합):
+    - BO_ / SG_ / CM_ 구문, 11비트 표준 ID
+    - Intel(리틀 엔디안, @1) 신호, 부호 없음(+)/부호 있음(-)
+    - factor 1, offset 0 (정수 원시값만 사용. 물리값 변환은 애플리케이션 몫)
+"""
+
+import os
+import random
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DBC_PATH = os.path.join(ROOT, "can_db", "vehicle.dbc")
+TARGET_UNITS = ["Unit_car_central", "Unit_car_sensor", "Unit_car_status"]
+
+RE_BO = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)')
+RE_SG = re.compile(r'^\s*SG_\s+(\w+)\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*\(([^,]+),([^)]+)\)\s*\[([^|]*)\|([^\]]*)\]\s*"([^"]*)"\s*(.*)$')
+RE_CM_BO = re.compile(r'^CM_\s+BO_\s+(\d+)\s+"([^"]*)"\s*;')
+RE_CM_SG = re.compile(r'^CM_\s+SG_\s+(\d+)\s+(\w+)\s+"([^"]*)"\s*;')
+
+
+class Signal:
+    def __init__(self, name, start, length, signed, unit, receivers):
+        self.name = name
+        self.start = start
+        self.length = length
+        self.signed = signed
+        self.unit = unit
+        self.receivers = receivers
+        self.comment = ""
+
+    @property
+    def ctype(self):
+        for bits in (8, 16, 32):
+            if self.length <= bits:
+                return ("int%d_t" if self.signed else "uint%d_t") % bits
+        raise ValueError("signal %s longer than 32 bits" % self.name)
+
+
+class Frame:
+    def __init__(self, can_id, name, dlc, sender):
+        self.can_id = can_id
+        self.name = name
+        self.dlc = dlc
+        self.sender = sender
+        self.signals = []
+        self.comment = ""
+
+    @property
+    def camel(self):
+        return "".join(p.capitalize() for p in self.name.lower().split("_"))
+
+
+def parse(path):
+    frames = []
+    by_id = {}
+    with open(path, encoding="utf-8") as f:
+        for lineno, line in enumerate(f, 1):
+            m = RE_BO.match(line)
+            if m:
+                fr = Frame(int(m.group(1)), m.group(2), int(m.group(3)), m.group(4))
+                if fr.can_id > 0x7FF:
+                    sys.exit("%s:%d: only 11-bit standard IDs are supported" % (path, lineno))
+                if fr.dlc > 8:
+                    sys.exit("%s:%d: DLC %d > 8" % (path, lineno, fr.dlc))
+                frames.append(fr)
+                by_id[fr.can_id] = fr
+                continue
+            m = RE_SG.match(line)
+            if m:
+                if not frames:
+                    sys.exit("%s:%d: SG_ before BO_" % (path, lineno))
+                name, start, length, order, sign = m.group(1), int(m.group(2)), int(m.group(3)), m.group(4), m.group(5)
+                if order != "1":
+                    sys.exit("%s:%d: %s: only Intel (@1) byte order is supported" % (path, lineno, name))
+                if float(m.group(6)) != 1.0 or float(m.group(7)) != 0.0:
+                    sys.exit("%s:%d: %s: factor/offset must be (1,0)" % (path, lineno, name))
+                sig = Signal(name, start, length, sign == "-", m.group(10), m.group(11).strip())
+                fr = frames[-1]
+                if start + length > fr.dlc * 8:
+                    sys.exit("%s:%d: %s does not fit in DLC %d" % (path, lineno, name, fr.dlc))
+                for other in fr.signals:
+                    if start < other.start + other.length and other.start < start + length:
+                        sys.exit("%s:%d: %s overlaps %s" % (path, lineno, name, other.name))
+                fr.signals.append(sig)
+                continue
+            m = RE_CM_BO.match(line)
+            if m:
+                by_id[int(m.group(1))].comment = m.group(2)
+                continue
+            m = RE_CM_SG.match(line)
+            if m:
+                for sig in by_id[int(m.group(1))].signals:
+                    if sig.name == m.group(2):
+                        sig.comment = m.group(3)
+    return frames
+
+
+def paren(expr):
+    """이미 전체가 괄호로 감싸진 식이면 그대로, 아니면 괄호를 씌운다."""
+    if expr.startswith("(") and expr.endswith(")"):
+        depth = 0
+        for i, ch in enumerate(expr):
+            depth += (ch == "(") - (ch == ")")
+            if depth == 0 and i != len(expr) - 1:
+                break
+        else:
+            return expr
+    return "(%s)" % expr
+
+
+def byte_parts(sig):
+    """신호가 걸쳐 있는 각 바이트에 대해 (byte index, 신호 내 비트 오프셋, 바이트 내 비트 오프셋, 비트 수)를 만든다."""
+    parts = []
+    bit = sig.start
+    end = sig.start + sig.length
+    while bit < end:
+        byte = bit // 8
+        in_byte = bit % 8
+        n = min(8 - in_byte, end - bit)
+        parts.append((byte, bit - sig.start, in_byte, n))
+        bit += n
+    return parts
+
+
+def gen_frame(fr):
+    up = fr.name
+    out = []
+    out.append("/* --- 0x%03X %s (DLC %d, 송신: %s) --- */" % (fr.can_id, up, fr.dlc, fr.sender))
+    out.append("#define CANDB_%s_ID  0x%03XU" % (up, fr.can_id))
+    out.append("#define CANDB_%s_DLC %dU" % (up, fr.dlc))
+    out.append("")
+    out.append("/**")
+    out.append(" * @brief %s" % (fr.comment or up))
+    out.append(" */")
+    out.append("typedef struct {")
+    width = max(len(sig.name) for sig in fr.signals) + 1
+    for sig in fr.signals:
+        desc = sig.comment or sig.name
+        if sig.unit:
+            desc += " [%s]" % sig.unit
+        out.append("    %-9s %-*s // bit %d, %d비트. %s" % (sig.ctype, width, sig.name + ";", sig.start, sig.length, desc))
+    out.append("} CanDb_%s_t;" % fr.camel)
+    out.append("")
+    out.append("/**")
+    out.append(" * @brief CanDb_%s_t를 CAN 데이터 바이트로 인코딩한다. (분기 없음)" % fr.camel)
+    out.append(" * @param msg 인코딩할 신호 값. 각 신호는 정의된 비트 수로 잘린다.")
+    out.append(" * @param data 출력 버퍼 (CANDB_%s_DLC 바이트)" % up)
+    out.append(" */")
+    out.append("static inline void CanDb_%s_Pack(const CanDb_%s_t *msg, uint8_t *data)" % (fr.camel, fr.camel))
+    out.append("{")
+    for b in range(fr.dlc):
+        terms = []
+        for sig in fr.signals:
+            for byte, sig_off, in_byte, n in byte_parts(sig):
+                if byte != b:
+                    continue
+                mask = (1 << n) - 1
+                expr = "(uint32_t)msg->%s" % sig.name
+                if sig_off:
+                    expr = "(%s >> %d)" % (expr, sig_off)
+                expr = "(%s & 0x%02XU)" % (expr, mask)
+                if in_byte:
+                    expr = "(%s << %d)" % (expr, in_byte)
+                terms.append(expr)
+        out.append("    data[%d] = (uint8_t)%s;" % (b, paren(" | ".join(terms)) if terms else "0U"))
+    out.append("}")
+    out.append("")
+    out.append("/**")
+    out.append(" * @brief CAN 데이터 바이트를 CanDb_%s_t로 디코딩한다. (분기 없음)" % fr.camel)
+    out.append(" * @param data 수신 데이터 (CANDB_%s_DLC 바이트 이상)" % up)
+    out.append(" * @param msg 디코딩 결과")
+    out.append(" */")
+    out.append("static inline void CanDb_%s_Unpack(const uint8_t *data, CanDb_%s_t *msg)" % (fr.camel, fr.camel))
+    out.append("{")
+    for sig in fr.signals:
+        terms = []
+        for byte, sig_off, in_byte, n in byte_parts(sig):
+            mask = (1 << n) - 1
+            expr = "(uint32_t)data[%d]" % byte
+            if in_byte:
+                expr = "(%s >> %d)" % (expr, in_byte)
+            if n != 8:
+                expr = "(%s & 0x%02XU)" % (expr, mask)
+            if sig_off:
+                expr = "(%s << %d)" % (expr, sig_off)
+            terms.append(expr)
+        raw = " | ".join(terms)
+        if sig.signed and sig.length < 32:
+            # 부호 확장: 최상위 신호 비트를 int32_t의 부호 비트로 올렸다가 산술 시프트로 내린다.
+            sh = 32 - sig.length
+            out.append("    msg->%s = (%s)((int32_t)((%s) << %d) >> %d);" % (sig.name, sig.ctype, raw, sh, sh))
+        else:
+            out.append("    msg->%s = (%s)%s;" % (sig.name, sig.ctype, paren(raw)))
+    out.append("}")
+    out.append("")
+    return out
+
+
+def generate(frames):
+    out = []
+    out.append("/**")
+    out.append(" * @file can_db.h")
+    out.append(" * @brief 차량부 CAN 프레임의 신호 정의와 pack/unpack 코덱")
+    out.append(" * @note 이 파일은 can_db/gen_can_db.py가 can_db/vehicle.dbc로부터 자동 생성한다. 직접 수정하지 말 것.")
+    out.append(" * 프레임 레이아웃을 바꾸려면 vehicle.dbc를 수정하고 생성기를 다시 실행한다.")
+    out.append(" * car_central, car_sensor, car_status가 동일한 파일을 사용한다.")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef INC_CAN_DB_H_")
+    out.append("#define INC_CAN_DB_H_")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    for fr in frames:
+        out.extend(gen_frame(fr))
+    out.append("/* --- 컴파일 타임 검사 --- */")
+    for fr in frames:
+        out.append('_Static_assert(CANDB_%s_DLC <= 8U, "%s: DLC must be <= 8");' % (fr.name, fr.name))
+        for sig in fr.signals:
+            out.append('_Static_assert(%d + %d <= CANDB_%s_DLC * 8U, "%s.%s exceeds DLC");'
+                       % (sig.start, sig.length, fr.name, fr.name, sig.name))
+    out.append("")
+    out.append("#endif /* INC_CAN_DB_H_ */")
+    out.append("")
+    return "\n".join(out)
+
+
+def ref_pack(fr, values):
+    """비트 단위로 직접 채우는 기준 인코더. 생성된 시프트/마스크 코드와 독립적으로 기대 바이트를 만든다."""
+    data = [0] * fr.dlc
+    for sig in fr.signals:
+        raw = values.get(sig.name, 0) & ((1 << sig.length) - 1)
+        for i in range(sig.length):
+            if (raw >> i) & 1:
+                bit = sig.start + i
+                data[bit // 8] |= 1 << (bit % 8)
+    return data
+
+
+def sig_range(sig):
+    if sig.signed:
+        return -(1 << (sig.length - 1)), (1 << (sig.length - 1)) - 1
+    return 0, (1 << sig.length) - 1
+
+
+def c_int(v, sig):
+    if sig.signed and v == -(1 << 31):
+        return "(-2147483647 - 1)"
+    return "%d%s" % (v, "" if sig.signed else "U")
+
+
+def test_vectors(fr, rng):
+    """신호별 경계값/비트 패턴 벡터(다른 신호는 0)와 모든 신호를 함께 채운 임의 벡터를 만든다."""
+    vectors = []
+    for sig in fr.signals:
+        lo, hi = sig_range(sig)
+        mask = (1 << sig.length) - 1
+        cands = [lo, hi, 0, 1, 0x5555555555 & mask, 0xAAAAAAAAAA & mask]
+        if sig.signed:
+            cands += [-1, lo + 1, hi - 1]
+        cands += [rng.randint(lo, hi) for _ in range(4)]
+        for v in cands:
+            if sig.signed and v > hi:
+                v -= 1 << sig.length  # 비트 패턴을 부호 있는 값으로 해석
+            vectors.append({sig.name: v})
+    for _ in range(16):
+        vectors.append({sig.name: rng.randint(*sig_range(sig)) for sig in fr.signals})
+    return vectors
+
+
+def generate_selftest(frames, dbc_name):
+    rng = random.Random(1701)
+    out = []
+    out.append("/**")
+    out.append(" * @file test_can_db.c")
+    out.append(" * @brief %s 코덱의 pack/unpack 왕복 시험 (gen_can_db.py --selftest가 생성, 직접 수정하지 말 것)" % dbc_name)
+    out.append(" * @note 기대 바이트는 생성기의 비트 단위 기준 인코더(ref_pack)로 계산한 값이다.")
+    out.append(" * 각 신호의 최소/최대/0/1/비트 교대 패턴/임의 값을 단독으로, 그리고 모든 신호를 함께 채워 확인한다.")
+    out.append(" */")
+    out.append("")
+    out.append("#include <string.h>")
+    out.append('#include "host_test.h"')
+    out.append("")
+    out.append(generate(frames))
+    for fr in frames:
+        vectors = test_vectors(fr, rng)
+        out.append("static void Test_%s(void)" % fr.camel)
+        out.append("{")
+        out.append("    static const struct { CanDb_%s_t msg; uint8_t data[CANDB_%s_DLC]; } cases[] = {" % (fr.camel, fr.name))
+        for vals in vectors:
+            fields = ", ".join(".%s = %s" % (sig.name, c_int(vals.get(sig.name, 0), sig)) for sig in fr.signals)
+            data = ", ".join("0x%02X" % b for b in ref_pack(fr, vals))
+            out.append("        {{%s}, {%s}}," % (fields, data))
+        out.append("    };")
+        out.append("")
+        out.append("    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)")
+        out.append("    {")
+        out.append("        uint8_t data[CANDB_%s_DLC];" % fr.name)
+        out.append("        CanDb_%s_t msg;" % fr.camel)
+        out.append("")
+        out.append("        memset(data, 0xEE, sizeof(data));")
+        out.append("        CanDb_%s_Pack(&cases[i].msg, data);" % fr.camel)
+        out.append('        HT_CHECK(memcmp(data, cases[i].data, sizeof(data)) == 0, "%s case %%u: pack mismatch", i);' % fr.name)
+        out.append("        memset(&msg, 0xEE, sizeof(msg));")
+        out.append("        CanDb_%s_Unpack(cases[i].data, &msg);" % fr.camel)
+        for sig in fr.signals:
+            out.append('        HT_CHECK(msg.%s == cases[i].msg.%s, "%s case %%u: %s %%lld != %%lld", i, (long long)msg.%s, (long long)cases[i].msg.%s);'
+                       % (sig.name, sig.name, fr.name, sig.name, sig.name, sig.name))
+        out.append("    }")
+        out.append('    printf("%s: %%u cases\\n", (unsigned)(sizeof(cases) / sizeof(cases[0])));' % fr.name)
+        out.append("}")
+        out.append("")
+    out.append("int main(void)")
+    out.append("{")
+    for fr in frames:
+        out.append("    Test_%s();" % fr.camel)
+    out.append("    return HT_RESULT();")
+    out.append("}")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    args = sys.argv[1:]
+    if "--selftest" in args:
+        out_path = args[args.index("--selftest") + 1]
+        dbc = args[args.index("--dbc") + 1] if "--dbc" in args else DBC_PATH
+        with open(out_path, "w", encoding="utf-8") as f:
+            f.write(generate_selftest(parse(dbc), os.path.basename(dbc)))
+        return
+
+    text = generate(parse(DBC_PATH))
+    check = "--check" in sys.argv[1:]
+    stale = []
+    for unit in TARGET_UNITS:
+        path = os.path.join(ROOT, unit, "Core", "Inc", "can_db.h")
+        old = open(path, encoding="utf-8").read() if os.path.exists(path) else None
+        if old == text:
+            continue
+        if check:
+            stale.append(path)
+        else:
+            with open(path, "w", encoding="utf-8") as f:
+                f.write(text)
+            print("generated %s" % os.path.relpath(path, ROOT))
+    if stale:
+        print("out of date: " + ", ".join(os.path.relpath(p, ROOT) for p in stale))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
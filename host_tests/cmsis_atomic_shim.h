@@ -0,0 +1,36 @@
+/**
+ * @file cmsis_atomic_shim.h
+ * @brief 호스트 테스트에서 mailbox.c의 CMSIS 배타 접근 명령(LDREXB/STREXB)과 DMB를 C11 atomic으로 대체한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 컴파일 옵션 `-include`로 강제 포함한다. `__MAIN_H`를 미리 정의해 유닛의 main.h(HAL)를 비운다.
+ * __LDREXB는 읽은 값을 스레드별로 기억하고, __STREXB는 그 값과의 compare-exchange로 성공/실패를 돌려준다.
+ * 따라서 Mailbox_Exchange의 LDREX/STREX 재시도 루프는 호스트에서 atomic_compare_exchange 루프,
+ * 즉 atomic_exchange와 같은 의미가 된다. (실패 시 1을 반환해 STREX처럼 재시도)
+ */
+
+#ifndef CMSIS_ATOMIC_SHIM_H_
+#define CMSIS_ATOMIC_SHIM_H_
+
+#define __MAIN_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+static _Thread_local uint8_t shim_exclusive_value;
+
+static inline uint8_t __LDREXB(volatile uint8_t *addr)
+{
+    shim_exclusive_value = atomic_load((volatile _Atomic uint8_t *)addr);
+    return shim_exclusive_value;
+}
+
+static inline uint32_t __STREXB(uint8_t value, volatile uint8_t *addr)
+{
+    uint8_t expected = shim_exclusive_value;
+    return atomic_compare_exchange_strong((volatile _Atomic uint8_t *)addr, &expected, value) ? 0U : 1U;
+}
+
+#define __DMB() atomic_thread_fence(memory_order_seq_cst)
+
+#endif /* CMSIS_ATOMIC_SHIM_H_ */
@@ -0,0 +1,56 @@
+/**
+ * @file host_test.h
+ * @brief 호스트 PC 테스트 공용 검사 매크로와 시간 측정 함수
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 각 테스트는 단일 실행 파일이며, 실패한 검사가 있으면 종료 코드 1로 끝난다. (ctest 판정)
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+static int ht_failures = 0;
+
+// 조건이 거짓이면 위치와 메시지를 출력하고 실패로 센다. (테스트는 계속 진행)
+#define HT_CHECK(cond, ...)                                               \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);                   \
+            printf(__VA_ARGS__);                                          \
+            printf("\n");                                                 \
+            ht_failures++;                                                \
+        }                                                                 \
+    } while (0)
+
+// main의 마지막에서 결과를 출력하고 종료 코드를 반환한다.
+#define HT_RESULT()                                                       \
+    (printf("%s (%d failures)\n", ht_failures ? "FAILED" : "PASSED", ht_failures), \
+     ht_failures ? 1 : 0)
+
+/**
+ * @brief 단조 증가 시계 (ns)
+ */
+static inline uint64_t ht_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief CPU 사이클 카운터 (x86 TSC). 지원하지 않는 호스트에서는 0
+ */
+static inline uint64_t ht_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+#endif /* HOST_TEST_H_ */
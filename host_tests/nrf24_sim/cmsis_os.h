@@ -0,0 +1,44 @@
+/**
+ * @file cmsis_os.h
+ * @brief 호스트 테스트용 CMSIS-RTOS2 대체 헤더 (NRF24 핸들러가 쓰는 커널/뮤텍스/스레드 플래그 함수만 선언)
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 단일 스레드 테스트용이다. 뮤텍스는 항상 성공하고, 스레드 플래그는 전역 변수 하나로 흉내 낸다.
+ * osThreadFlagsWait()는 대기 중인 SPI DMA 전송을 먼저 완료시켜 완료 콜백이 플래그를 세우게 한다.
+ */
+
+#ifndef CMSIS_OS_H_
+#define CMSIS_OS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef void *osThreadId_t;
+typedef void *osMutexId_t;
+typedef void *osSemaphoreId_t;
+
+typedef enum {
+    osOK           = 0,
+    osError        = -1,
+    osErrorTimeout = -2
+} osStatus_t;
+
+typedef enum {
+    osKernelInactive = 0,
+    osKernelReady    = 1,
+    osKernelRunning  = 2
+} osKernelState_t;
+
+#define osFlagsWaitAny      0x00000000U
+#define osFlagsError        0x80000000U
+#define osFlagsErrorTimeout 0xFFFFFFFEU
+
+osKernelState_t osKernelGetState(void);
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t osMutexRelease(osMutexId_t mutex_id);
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+uint32_t osThreadFlagsClear(uint32_t flags);
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+
+#endif /* CMSIS_OS_H_ */
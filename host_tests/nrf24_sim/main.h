@@ -0,0 +1,14 @@
+/**
+ * @file main.h
+ * @brief 호스트 테스트용 main.h 대체 헤더
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 유닛의 main.h는 CubeMX 핀 정의와 실제 HAL을 포함하므로, NRF24 핸들러 빌드에 필요한 HAL 대체 헤더만 포함한다.
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include "stm32f1xx_hal.h"
+
+#endif /* __MAIN_H */
@@ -0,0 +1,704 @@
+/**
+ * @file nrf24_sim.c
+ * @brief 가상 nRF24L01+ 칩 모델과 대체 HAL(SPI/GPIO/지연)·CMSIS-RTOS2·timebase 함수 구현
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note CSN/CE 핀 번호는 유닛의 NRF24_conf.h를 그대로 사용한다. 단일 스레드 테스트 전용이다.
+ * 시간은 SPI 바이트, HAL_Delay(), Timebase_DelayMicros(), NrfSim_Run()만 진행시키며, 그때 무선 구간의 완료 이벤트를 처리한다.
+ */
+
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "cmsis_os.h"
+#include "timebase.h"
+#include "NRF24_conf.h"
+#include "NRF24_reg_addresses.h"
+#include "nrf24_sim.h"
+
+#define FIFO_DEPTH   3
+#define PAYLOAD_MAX  32
+#define ADDR_WIDTH   5
+
+#define STATUS_IRQ_MASK ((1 << RX_DR) | (1 << TX_DS) | (1 << MAX_RT))
+
+// SPI1: 72MHz / 프리스케일러 8 = 9Mbit/s. HAL 블로킹 호출마다 고정 오버헤드를 더한다.
+#define SPI_BYTE_NS      889
+#define HAL_CALL_NS      2000
+
+// 무선 구간 (데이터시트 6.1.7, 7.3): 대기→TX/RX 전환 130µs, 프리앰블 1B + 주소 5B + PCF 9비트 + 페이로드 + CRC 1B
+#define AIR_SETTLE_NS    130000
+#define AIR_ACK_WAIT_NS  250000  // 마지막 재전송 후 ACK를 기다리는 시간
+
+typedef struct {
+    uint8_t data[PAYLOAD_MAX];
+    uint8_t len;
+    uint8_t pipe;
+} SimPacket_t;
+
+typedef struct {
+    SimPacket_t pkt[FIFO_DEPTH];
+    uint8_t count;
+} SimFifo_t;
+
+NrfSimStats_t g_nrfSimStats;
+
+GPIO_TypeDef nrf24_sim_gpioa;
+SPI_HandleTypeDef hspi1;
+
+static uint8_t regs[NRF24_SIM_REGS];
+static uint8_t addr_regs[NRF24_SIM_REGS][ADDR_WIDTH];
+static uint8_t irq_flags;
+static SimFifo_t rx_fifo;
+static SimFifo_t tx_fifo;
+
+static uint8_t csn_level = 1;
+static uint8_t ce_level;
+
+// 진행 중인 SPI 프레임: 첫 바이트(명령)와 그 뒤 데이터 바이트
+static uint8_t frame_cmd;
+static int16_t frame_idx = -1;
+static uint8_t frame_buf[PAYLOAD_MAX];
+
+static uint64_t sim_ns;
+static uint32_t thread_flags;
+
+// 무선 구간: 진행 중인 TX FIFO 맨 앞 패킷과 그 완료 시각
+static uint8_t air_busy;
+static uint8_t air_success;
+static uint64_t air_done_ns;
+static uint16_t link_loss_permille;
+static uint8_t link_ack[PAYLOAD_MAX];
+static uint8_t link_ack_len;
+static uint32_t link_rng = 88172645u;
+static SimPacket_t last_delivered;
+
+static enum { DMA_IDLE = 0, DMA_TX, DMA_RX } dma_pending;
+
+static uint8_t Sim_IsAddrReg(uint8_t reg)
+{
+    return reg == RX_ADDR_P0 || reg == RX_ADDR_P1 || reg == TX_ADDR;
+}
+
+static void Fifo_Push(SimFifo_t *f, uint8_t pipe, const uint8_t *data, uint8_t len)
+{
+    if (len > PAYLOAD_MAX)
+    {
+        len = PAYLOAD_MAX;
+    }
+    SimPacket_t *p = &f->pkt[f->count++];
+    memcpy(p->data, data, len);
+    p->len = len;
+    p->pipe = pipe;
+}
+
+static void Fifo_Pop(SimFifo_t *f)
+{
+    memmove(&f->pkt[0], &f->pkt[1], sizeof(SimPacket_t) * (FIFO_DEPTH - 1));
+    f->count--;
+}
+
+static uint8_t Sim_Status(void)
+{
+    uint8_t rx_p_no = (rx_fifo.count == 0) ? RX_P_NO_EMPTY : rx_fifo.pkt[0].pipe;
+
+    return (uint8_t)(irq_flags | (rx_p_no << RX_P_NO) | ((tx_fifo.count == FIFO_DEPTH) << TX_FULL));
+}
+
+static uint8_t Sim_FifoStatus(void)
+{
+    return (uint8_t)(((tx_fifo.count == FIFO_DEPTH) << TX_FULL_FIFO) | ((tx_fifo.count == 0) << TX_EMPTY) |
+                     ((rx_fifo.count == FIFO_DEPTH) << RX_FULL) | ((rx_fifo.count == 0) << RX_EMPTY));
+}
+
+static uint8_t Sim_ReadReg(uint8_t reg, uint8_t idx)
+{
+    if (Sim_IsAddrReg(reg))
+    {
+        return (idx < ADDR_WIDTH) ? addr_regs[reg][idx] : 0;
+    }
+    if (idx != 0)
+    {
+        return 0;
+    }
+    return NrfSim_GetReg(reg);
+}
+
+static void Sim_WriteReg(uint8_t reg, const uint8_t *data, uint8_t len)
+{
+    if (len == 0)
+    {
+        return;
+    }
+    if (Sim_IsAddrReg(reg))
+    {
+        memcpy(addr_regs[reg], data, (len < ADDR_WIDTH) ? len : ADDR_WIDTH);
+        return;
+    }
+
+    switch (reg)
+    {
+    case STATUS:
+        irq_flags &= (uint8_t)~(data[0] & STATUS_IRQ_MASK); // 1을 쓴 비트만 클리어
+        break;
+    case OBSERVE_TX:
+    case RPD:
+    case FIFO_STATUS:
+        break; // 읽기 전용
+    default:
+        regs[reg] = data[0];
+        break;
+    }
+}
+
+static uint32_t Link_Rand(void)
+{
+    link_rng ^= link_rng << 13; link_rng ^= link_rng >> 17; link_rng ^= link_rng << 5;
+    return link_rng;
+}
+
+/* RF_SETUP 데이터 속도로 패킷 하나의 전송 시간을 구한다. */
+static uint64_t Air_PacketNs(uint8_t payload_len)
+{
+    uint32_t bits = 8U * (1U + ADDR_WIDTH + payload_len + 1U) + 9U;
+    uint32_t kbps = (regs[RF_SETUP] & (1 << RF_DR_LOW)) ? 250U : (regs[RF_SETUP] & (1 << RF_DR_HIGH)) ? 2000U : 1000U;
+
+    return (uint64_t)bits * 1000000U / kbps;
+}
+
+/* PTX: CE가 High였고 TX FIFO에 패킷이 있으면 송신을 시작한다. 결과(ACK 또는 재전송 소진)는 미리 정한다. */
+static void Air_TryStart(void)
+{
+    if (air_busy || tx_fifo.count == 0 || (irq_flags & (1 << MAX_RT)) ||
+        !(regs[CONFIG] & (1 << PWR_UP)) || (regs[CONFIG] & (1 << PRIM_RX)))
+    {
+        return;
+    }
+
+    uint8_t arc = regs[SETUP_RETR] & 0x0F;
+    uint64_t ard_ns = (uint64_t)((regs[SETUP_RETR] >> ARD) + 1U) * 250000U;
+    uint64_t tx_ns = Air_PacketNs(tx_fifo.pkt[0].len);
+    uint64_t t = AIR_SETTLE_NS + tx_ns;
+
+    air_busy = 1;
+    air_success = 0;
+    g_nrfSimStats.air_packets++;
+    for (uint8_t attempt = 0; attempt <= arc; attempt++)
+    {
+        g_nrfSimStats.air_attempts++;
+        if (Link_Rand() % 1000U >= link_loss_permille)
+        {
+            air_success = 1;
+            t += AIR_SETTLE_NS + Air_PacketNs(link_ack_len);
+            break;
+        }
+        t += (attempt < arc) ? ard_ns + tx_ns : AIR_ACK_WAIT_NS;
+    }
+    regs[OBSERVE_TX] = (uint8_t)((regs[OBSERVE_TX] & 0xF0) | (g_nrfSimStats.air_attempts - 1U) % 16U);
+    air_done_ns = sim_ns + t;
+}
+
+/* 송신 완료: ACK를 받으면 패킷을 지우고 ACK 페이로드를 파이프 0에 넣는다. 재전송 소진이면 패킷은 FIFO에 남는다. */
+static void Air_Finish(void)
+{
+    air_busy = 0;
+    if (tx_fifo.count == 0)
+    {
+        return; // 송신 중에 FLUSH_TX로 지워짐
+    }
+    if (air_success)
+    {
+        last_delivered = tx_fifo.pkt[0];
+        Fifo_Pop(&tx_fifo);
+        irq_flags |= (1 << TX_DS);
+        g_nrfSimStats.air_delivered++;
+        if (link_ack_len != 0 && rx_fifo.count < FIFO_DEPTH)
+        {
+            Fifo_Push(&rx_fifo, 0, link_ack, link_ack_len);
+            irq_flags |= (1 << RX_DR);
+        }
+    }
+    else
+    {
+        irq_flags |= (1 << MAX_RT);
+        g_nrfSimStats.air_lost++;
+    }
+
+    if (ce_level)
+    {
+        Air_TryStart(); // CE를 High로 유지하면 FIFO의 다음 패킷을 이어서 보낸다
+    }
+}
+
+/* 가상 시계를 진행시키며 그 사이에 끝나는 무선 이벤트를 처리한다. */
+static void Sim_Advance(uint64_t ns)
+{
+    uint64_t end = sim_ns + ns;
+
+    while (air_busy && air_done_ns <= end)
+    {
+        sim_ns = air_done_ns;
+        Air_Finish();
+    }
+    sim_ns = end;
+}
+
+/* 프레임 안의 바이트 하나를 처리하고 MISO 바이트를 돌려준다. */
+static uint8_t Sim_SpiByte(uint8_t mosi)
+{
+    if (csn_level)
+    {
+        g_nrfSimStats.stray_bytes++;
+        return 0xFF;
+    }
+
+    g_nrfSimStats.bytes++;
+    Sim_Advance(SPI_BYTE_NS);
+
+    if (frame_idx < 0)
+    {
+        frame_cmd = mosi;
+        frame_idx = 0;
+        if ((mosi & 0xE0) == R_REGISTER)
+        {
+            g_nrfSimStats.reg_reads[mosi & 0x1F]++;
+        }
+        else if ((mosi & 0xE0) == W_REGISTER)
+        {
+            g_nrfSimStats.reg_writes[mosi & 0x1F]++;
+        }
+        return Sim_Status();
+    }
+
+    uint8_t idx = (uint8_t)frame_idx;
+    uint8_t miso = 0xFF;
+
+    if ((frame_cmd & 0xE0) == R_REGISTER)
+    {
+        miso = Sim_ReadReg(frame_cmd & 0x1F, idx);
+    }
+    else if (frame_cmd == R_RX_PAYLOAD)
+    {
+        miso = (rx_fifo.count != 0 && idx < rx_fifo.pkt[0].len) ? rx_fifo.pkt[0].data[idx] : 0;
+    }
+    else if (frame_cmd == R_RX_PL_WID)
+    {
+        miso = (rx_fifo.count != 0) ? rx_fifo.pkt[0].len : 0;
+    }
+    else if (idx < PAYLOAD_MAX)
+    {
+        frame_buf[idx] = mosi; // W_REGISTER, W_TX_PAYLOAD(_NOACK), W_ACK_PAYLOAD
+    }
+
+    if (frame_idx < PAYLOAD_MAX)
+    {
+        frame_idx++;
+    }
+    return miso;
+}
+
+/* CSN 상승: 쓰기 명령을 반영하고 읽은 RX 페이로드를 FIFO에서 지운다. */
+static void Sim_FrameEnd(void)
+{
+    if (frame_idx < 0)
+    {
+        return; // 바이트 없이 CSN만 토글됨
+    }
+
+    uint8_t len = (uint8_t)frame_idx;
+
+    g_nrfSimStats.transactions++;
+
+    if ((frame_cmd & 0xE0) == W_REGISTER)
+    {
+        Sim_WriteReg(frame_cmd & 0x1F, frame_buf, len);
+    }
+    else if (frame_cmd == R_RX_PAYLOAD)
+    {
+        if (len != 0 && rx_fifo.count != 0)
+        {
+            Fifo_Pop(&rx_fifo);
+        }
+    }
+    else if (frame_cmd == W_TX_PAYLOAD || frame_cmd == W_TX_PAYLOAD_NOACK || (frame_cmd & 0xF8) == W_ACK_PAYLOAD)
+    {
+        if (len != 0 && tx_fifo.count < FIFO_DEPTH)
+        {
+            Fifo_Push(&tx_fifo, frame_cmd & 0x07, frame_buf, len);
+        }
+        if (ce_level)
+        {
+            Air_TryStart();
+        }
+    }
+    else if (frame_cmd == FLUSH_TX)
+    {
+        tx_fifo.count = 0;
+        air_busy = 0;
+    }
+    else if (frame_cmd == FLUSH_RX)
+    {
+        rx_fifo.count = 0;
+    }
+
+    frame_idx = -1;
+}
+
+void NrfSim_Reset(void)
+{
+    static const uint8_t reset_regs[NRF24_SIM_REGS] = {
+        [CONFIG] = 0x08, [EN_AA] = 0x3F, [EN_RXADDR] = 0x03, [SETUP_AW] = 0x03,
+        [SETUP_RETR] = 0x03, [RF_CH] = 0x02, [RF_SETUP] = 0x0E,
+        [RX_ADDR_P2] = 0xC3, [RX_ADDR_P3] = 0xC4, [RX_ADDR_P4] = 0xC5, [RX_ADDR_P5] = 0xC6,
+    };
+
+    memcpy(regs, reset_regs, sizeof(regs));
+    memset(addr_regs[RX_ADDR_P0], 0xE7, ADDR_WIDTH);
+    memset(addr_regs[RX_ADDR_P1], 0xC2, ADDR_WIDTH);
+    memset(addr_regs[TX_ADDR], 0xE7, ADDR_WIDTH);
+    irq_flags = 0;
+    rx_fifo.count = 0;
+    tx_fifo.count = 0;
+    frame_idx = -1;
+    dma_pending = DMA_IDLE;
+    thread_flags = 0;
+    air_busy = 0;
+    last_delivered.len = 0;
+    link_loss_permille = 0;
+    link_ack_len = 0;
+    link_rng = 88172645u;
+    NrfSim_ClearStats();
+}
+
+void NrfSim_ClearStats(void)
+{
+    memset(&g_nrfSimStats, 0, sizeof(g_nrfSimStats));
+}
+
+uint8_t NrfSim_GetReg(uint8_t reg)
+{
+    if (reg == STATUS)
+    {
+        return Sim_Status();
+    }
+    if (reg == FIFO_STATUS)
+    {
+        return Sim_FifoStatus();
+    }
+    if (Sim_IsAddrReg(reg))
+    {
+        return addr_regs[reg][0];
+    }
+    return (reg < NRF24_SIM_REGS) ? regs[reg] : 0;
+}
+
+void NrfSim_SetReg(uint8_t reg, uint8_t val)
+{
+    if (reg < NRF24_SIM_REGS && reg != STATUS && reg != FIFO_STATUS && !Sim_IsAddrReg(reg))
+    {
+        regs[reg] = val;
+    }
+}
+
+void NrfSim_SetIrqFlags(uint8_t mask)
+{
+    irq_flags |= (uint8_t)(mask & STATUS_IRQ_MASK);
+}
+
+uint8_t NrfSim_RxPush(uint8_t pipe, const uint8_t *data, uint8_t len)
+{
+    if (rx_fifo.count == FIFO_DEPTH)
+    {
+        return 0;
+    }
+    Fifo_Push(&rx_fifo, pipe, data, len);
+    irq_flags |= (1 << RX_DR);
+    return 1;
+}
+
+uint8_t NrfSim_TxPop(uint8_t *data)
+{
+    if (tx_fifo.count == 0)
+    {
+        return 0;
+    }
+    uint8_t len = tx_fifo.pkt[0].len;
+    if (data != NULL)
+    {
+        memcpy(data, tx_fifo.pkt[0].data, len);
+    }
+    Fifo_Pop(&tx_fifo);
+    return len;
+}
+
+uint8_t NrfSim_TxCount(void)
+{
+    return tx_fifo.count;
+}
+
+uint8_t NrfSim_RxCount(void)
+{
+    return rx_fifo.count;
+}
+
+uint8_t NrfSim_Ce(void)
+{
+    return ce_level;
+}
+
+uint64_t NrfSim_Micros(void)
+{
+    return sim_ns / 1000U;
+}
+
+uint64_t NrfSim_Nanos(void)
+{
+    return sim_ns;
+}
+
+void NrfSim_SetLink(uint16_t loss_permille, const uint8_t *ack, uint8_t ack_len)
+{
+    link_loss_permille = loss_permille;
+    link_ack_len = (ack_len > PAYLOAD_MAX) ? PAYLOAD_MAX : ack_len;
+    if (link_ack_len != 0)
+    {
+        memcpy(link_ack, ack, link_ack_len);
+    }
+}
+
+uint8_t NrfSim_LastDelivered(uint8_t *data)
+{
+    if (data != NULL)
+    {
+        memcpy(data, last_delivered.data, last_delivered.len);
+    }
+    return last_delivered.len;
+}
+
+uint8_t NrfSim_Irq(void)
+{
+    // CONFIG의 MASK_* 비트가 1인 인터럽트는 IRQ 핀에 나타나지 않는다. (MASK_RX_DR..MASK_MAX_RT = RX_DR..MAX_RT)
+    return (irq_flags & (uint8_t)~regs[CONFIG] & STATUS_IRQ_MASK) != 0;
+}
+
+void NrfSim_Run(uint32_t us)
+{
+    Sim_Advance((uint64_t)us * 1000U);
+}
+
+uint8_t NrfSim_RunUntilIrq(uint32_t timeout_us)
+{
+    uint64_t end = sim_ns + (uint64_t)timeout_us * 1000U;
+
+    while (!NrfSim_Irq() && air_busy && air_done_ns <= end)
+    {
+        Sim_Advance(air_done_ns - sim_ns);
+    }
+    if (!NrfSim_Irq())
+    {
+        Sim_Advance(end - sim_ns);
+    }
+    return NrfSim_Irq();
+}
+
+void NrfSim_DmaComplete(void)
+{
+    if (dma_pending == DMA_TX)
+    {
+        dma_pending = DMA_IDLE;
+        HAL_SPI_TxCpltCallback(&hspi1);
+    }
+    else if (dma_pending == DMA_RX)
+    {
+        dma_pending = DMA_IDLE;
+        HAL_SPI_RxCpltCallback(&hspi1);
+    }
+}
+
+/* --- 대체 HAL --- */
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    uint8_t level = (PinState != GPIO_PIN_RESET);
+
+    if (GPIOx == csn_gpio_port && GPIO_Pin == csn_gpio_pin)
+    {
+        if (level && !csn_level)
+        {
+            Sim_FrameEnd();
+        }
+        csn_level = level;
+    }
+    else if (GPIOx == ce_gpio_port && GPIO_Pin == ce_gpio_pin)
+    {
+        uint8_t rising = (level && !ce_level);
+
+        ce_level = level;
+        if (rising)
+        {
+            g_nrfSimStats.ce_pulses++;
+            Air_TryStart();
+        }
+    }
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    // HAL과 같이 대기 틱 수에 1을 더하므로, 다음 1ms 틱 경계까지 남은 시간만큼 Delay보다 길게 기다린다.
+    uint64_t tickstart = sim_ns / 1000000U;
+
+    Sim_Advance((tickstart + Delay + 1U) * 1000000U - sim_ns);
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(sim_ns / 1000000U);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)hspi;
+    (void)Timeout;
+    Sim_Advance(HAL_CALL_NS);
+    for (uint16_t i = 0; i < Size; i++)
+    {
+        (void)Sim_SpiByte(pData[i]);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)hspi;
+    (void)Timeout;
+    Sim_Advance(HAL_CALL_NS);
+    for (uint16_t i = 0; i < Size; i++)
+    {
+        pData[i] = Sim_SpiByte(NOP_CMD);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                          uint16_t Size, uint32_t Timeout)
+{
+    (void)hspi;
+    (void)Timeout;
+    Sim_Advance(HAL_CALL_NS);
+    for (uint16_t i = 0; i < Size; i++)
+    {
+        pRxData[i] = Sim_SpiByte(pTxData[i]);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+    if (dma_pending != DMA_IDLE)
+    {
+        return HAL_BUSY;
+    }
+    (void)HAL_SPI_Transmit(hspi, pData, Size, 0);
+    dma_pending = DMA_TX;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+    if (dma_pending != DMA_IDLE)
+    {
+        return HAL_BUSY;
+    }
+    (void)HAL_SPI_Receive(hspi, pData, Size, 0);
+    dma_pending = DMA_RX;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+    dma_pending = DMA_IDLE;
+    return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+}
+
+__attribute__((weak)) void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+}
+
+/* --- 대체 timebase (72MHz 사이클로 환산) --- */
+
+uint32_t Timebase_GetCycles(void)
+{
+    return (uint32_t)(sim_ns * 72U / 1000U);
+}
+
+uint32_t Timebase_GetMicros(void)
+{
+    return (uint32_t)(sim_ns / 1000U);
+}
+
+void Timebase_DelayMicros(uint32_t us)
+{
+    Sim_Advance((uint64_t)us * 1000U);
+}
+
+/* --- 대체 CMSIS-RTOS2 (단일 스레드) --- */
+
+osKernelState_t osKernelGetState(void)
+{
+    return osKernelRunning;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
+{
+    (void)mutex_id;
+    (void)timeout;
+    return osOK;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id)
+{
+    (void)mutex_id;
+    return osOK;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id)
+{
+    (void)semaphore_id;
+    return osOK;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+    (void)thread_id;
+    thread_flags |= flags;
+    return thread_flags;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags)
+{
+    uint32_t prev = thread_flags;
+    thread_flags &= ~flags;
+    return prev;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    (void)options;
+
+    NrfSim_DmaComplete();
+
+    uint32_t got = thread_flags & flags;
+    if (got == 0U)
+    {
+        Sim_Advance((uint64_t)timeout * 1000000U);
+        return osFlagsErrorTimeout;
+    }
+    thread_flags &= ~got;
+    return got;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file nrf24_sim.h
+ * @brief 호스트 테스트용 가상 nRF24L01+ 칩 모델과 SPI 트랜잭션 카운터
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 대체 HAL(stm32f1xx_hal.h)의 SPI/GPIO 함수가 이 모델을 구동한다. CSN이 Low인 동안의 바이트를
+ * 하나의 트랜잭션으로 보고, 첫 바이트를 명령으로 해석해 STATUS를 돌려준다. (데이터시트 8.3.1 명령 집합)
+ * - 레지스터 파일: 단일 바이트 레지스터, 5바이트 주소 레지스터(RX_ADDR_P0/P1, TX_ADDR), 쓰기 1로 클리어되는 STATUS
+ * - STATUS/FIFO_STATUS는 RX/TX FIFO(각 3단)와 인터럽트 플래그로부터 매번 계산한다
+ * - OBSERVE_TX/RPD는 칩이 스스로 바꾸는 읽기 전용 레지스터로, 테스트가 NrfSim_SetReg()로 값을 바꾼다
+ * - 송신측(PTX) 무선 구간: CE 상승 에지(또는 CE High 중 페이로드 적재)에 TX FIFO 맨 앞 패킷을 보내고,
+ *   RF_SETUP 속도·SETUP_RETR(ARD/ARC)·NrfSim_SetLink()의 손실률로 완료 시각과 결과(TX_DS + ACK 페이로드 / MAX_RT)를 정한다.
+ *   가상 시계가 그 시각을 지나면 플래그를 세우고 IRQ 핀(NrfSim_Irq)을 활성화한다.
+ * 수신측 무선 구간은 모델링하지 않는다. 수신 패킷은 NrfSim_RxPush()로, 송신 패킷은 NrfSim_TxPop()으로 직접 넣고 꺼낼 수 있다.
+ */
+
+#ifndef NRF24_SIM_H_
+#define NRF24_SIM_H_
+
+#include <stdint.h>
+
+#define NRF24_SIM_REGS 0x20
+
+typedef struct {
+    uint32_t transactions;                 // CSN Low→High 프레임 수
+    uint32_t bytes;                        // 프레임 안에서 주고받은 SPI 바이트 수
+    uint32_t stray_bytes;                  // CSN이 High인 동안 보낸 바이트 (드라이버 오류)
+    uint32_t reg_reads[NRF24_SIM_REGS];    // R_REGISTER 명령 수 (레지스터별)
+    uint32_t reg_writes[NRF24_SIM_REGS];   // W_REGISTER 명령 수 (레지스터별)
+    uint32_t ce_pulses;                    // CE Low→High 전환 수
+    uint32_t air_packets;                  // 무선 송신을 시작한 패킷 수
+    uint32_t air_attempts;                 // 재전송을 포함한 송신 시도 수
+    uint32_t air_delivered;                // ACK를 받은 패킷 수 (수신측 도착)
+    uint32_t air_lost;                     // 재전송 소진(MAX_RT) 패킷 수
+} NrfSimStats_t;
+
+extern NrfSimStats_t g_nrfSimStats;
+
+/**
+ * @brief 전원 인가 상태로 되돌린다. (레지스터 리셋 값, FIFO 비움, 카운터 0)
+ */
+void NrfSim_Reset(void);
+
+/**
+ * @brief 레지스터와 FIFO는 그대로 두고 카운터만 0으로 만든다.
+ */
+void NrfSim_ClearStats(void);
+
+/**
+ * @brief 칩 쪽 레지스터 값을 SPI 트랜잭션 없이 읽는다. (STATUS/FIFO_STATUS는 계산 값)
+ */
+uint8_t NrfSim_GetReg(uint8_t reg);
+
+/**
+ * @brief 칩이 스스로 레지스터를 바꾼 것처럼 값을 넣는다. (OBSERVE_TX, RPD 등)
+ */
+void NrfSim_SetReg(uint8_t reg, uint8_t val);
+
+/**
+ * @brief STATUS의 인터럽트 플래그(RX_DR/TX_DS/MAX_RT 비트 마스크)를 세운다.
+ */
+void NrfSim_SetIrqFlags(uint8_t mask);
+
+/**
+ * @brief 무선으로 받은 패킷을 RX FIFO에 넣고 RX_DR을 세운다.
+ * @retval 1 성공, 0 RX FIFO가 가득 참
+ */
+uint8_t NrfSim_RxPush(uint8_t pipe, const uint8_t *data, uint8_t len);
+
+/**
+ * @brief TX FIFO의 맨 앞 패킷을 꺼낸다. (무선 송신 완료에 해당)
+ * @retval 꺼낸 패킷 길이, FIFO가 비어 있으면 0
+ */
+uint8_t NrfSim_TxPop(uint8_t *data);
+
+/**
+ * @brief TX/RX FIFO에 들어 있는 패킷 수
+ */
+uint8_t NrfSim_TxCount(void);
+uint8_t NrfSim_RxCount(void);
+
+/**
+ * @brief 현재 CE 핀 레벨
+ */
+uint8_t NrfSim_Ce(void);
+
+/**
+ * @brief 가상 시계 (µs / ns). SPI 바이트, HAL_Delay(), Timebase_DelayMicros(), NrfSim_Run()이 시계를 진행시킨다.
+ */
+uint64_t NrfSim_Micros(void);
+uint64_t NrfSim_Nanos(void);
+
+/**
+ * @brief 무선 링크를 설정한다.
+ * @param loss_permille 송신 시도 하나가 ACK를 받지 못할 확률 (‰)
+ * @param ack, ack_len 수신측이 ACK에 실어 보내는 페이로드 (ack_len 0이면 빈 ACK)
+ */
+void NrfSim_SetLink(uint16_t loss_permille, const uint8_t *ack, uint8_t ack_len);
+
+/**
+ * @brief 무선으로 마지막에 전달된(ACK를 받은) 패킷을 복사한다.
+ * @retval 패킷 길이, 아직 없으면 0
+ */
+uint8_t NrfSim_LastDelivered(uint8_t *data);
+
+/**
+ * @brief IRQ 핀이 활성(Low)인지 반환한다. (CONFIG의 MASK 비트가 꺼진 인터럽트 플래그가 있으면 1)
+ */
+uint8_t NrfSim_Irq(void);
+
+/**
+ * @brief MCU가 칩에 접근하지 않는 동안 시간만 흐르게 한다.
+ */
+void NrfSim_Run(uint32_t us);
+
+/**
+ * @brief IRQ 핀이 활성화되거나 timeout_us가 지날 때까지 시간을 진행시킨다.
+ * @retval IRQ 핀 상태
+ */
+uint8_t NrfSim_RunUntilIrq(uint32_t timeout_us);
+
+/**
+ * @brief 시작된 SPI DMA 전송을 완료시키고 HAL 완료 콜백을 부른다. (osThreadFlagsWait()가 호출)
+ */
+void NrfSim_DmaComplete(void);
+
+#endif /* NRF24_SIM_H_ */
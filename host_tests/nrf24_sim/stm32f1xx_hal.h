@@ -0,0 +1,59 @@
+/**
+ * @file stm32f1xx_hal.h
+ * @brief 호스트 테스트용 STM32F1 HAL 대체 헤더 (NRF24 드라이버가 쓰는 GPIO/SPI/지연 함수만 선언)
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 구현은 nrf24_sim.c에 있으며, SPI 바이트와 CSN/CE 핀 출력을 가상 nRF24L01+ 칩 모델로 보낸다.
+ * 유닛의 Core/Inc보다 먼저 포함 경로에 넣어 main.h/timebase.h/cmsis_os.h와 함께 실제 헤더를 대체한다.
+ */
+
+#ifndef STM32F1XX_HAL_H_
+#define STM32F1XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct {
+    uint32_t Instance;
+} SPI_HandleTypeDef;
+
+extern GPIO_TypeDef nrf24_sim_gpioa;
+
+#define GPIOA      (&nrf24_sim_gpioa)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetTick(void);
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                          uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi);
+
+// DMA 완료 콜백: HAL과 같이 약한 심볼로 기본 구현을 두고, 테스트가 main.c처럼 재정의한다.
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi);
+
+#endif /* STM32F1XX_HAL_H_ */
@@ -0,0 +1,18 @@
+/**
+ * @file timebase.h
+ * @brief 호스트 테스트용 timebase.h 대체 헤더
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note DWT 대신 nrf24_sim.c의 가상 시계(µs)를 사용한다. Timebase_DelayMicros()는 가상 시계만 진행시킨다.
+ */
+
+#ifndef INC_TIMEBASE_H_
+#define INC_TIMEBASE_H_
+
+#include "main.h"
+
+uint32_t Timebase_GetCycles(void);
+uint32_t Timebase_GetMicros(void);
+void Timebase_DelayMicros(uint32_t us);
+
+#endif /* INC_TIMEBASE_H_ */
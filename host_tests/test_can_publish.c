@@ -0,0 +1,119 @@
+/**
+ * @file test_can_publish.c
+ * @brief SENSOR_STATUS(0x6A5) 변화 기반 송신 정책(can_publish)을 주행 시나리오로 시뮬레이션해 버스 부하와 수신 품질을 측정한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 10ms마다 샘플을 평가하고, 송신된 프레임만 수신측 상태에 반영한다. 시나리오마다 다음을 확인한다.
+ * - 송신 간격이 수신측 타임아웃보다 짧은지 (정지 200ms, 회전 중 50ms 하트비트)
+ * - 이산 신호(장애물/유효/조도) 변화가 같은 주기에 송신되는지
+ * - 수신측 RPM이 데드밴드 이상 틀린 상태가 최소 간격 + 1주기보다 오래 가지 않는지
+ * - 초당 프레임 수가 정책 상한(정지: 하트비트, 회전: 최소 간격) + 이산 신호 변화 수 이내인지
+ * 매 10ms 송신(초당 100프레임) 기준 버스 부하와 함께 출력한다.
+ */
+
+#include <stdlib.h>
+#include "host_test.h"
+#include "can_publish.h"
+
+#define SAMPLE_MS  10
+#define RUN_MS     60000
+#define BITRATE    500000.0
+
+typedef int (*RpmProfile_t)(int t_ms);
+
+static int Rpm_Parked(int t)   { (void)t; return 0; }
+static int Rpm_Cruise(int t)   { (void)t; return 120 + (rand() % 3) - 1; }         // ±1 rpm 노이즈
+static int Rpm_Accel(int t)    { return ((t % 10000) < 5000) ? (t % 10000) * 200 / 5000 : 200; }
+static int Rpm_StopGo(int t)   { return ((t / 2000) % 2) ? 150 + (rand() % 3) - 1 : 0; }
+static int Rpm_Reverse(int t)  { return ((t / 3000) % 2) ? -80 + (rand() % 5) - 2 : 80 + (rand() % 5) - 2; }
+
+typedef struct
+{
+    const char *name;
+    RpmProfile_t rpm;
+    int obstacle_period_ms; // 0: 장애물 없음
+} Scenario_t;
+
+static void Run(const Scenario_t *sc)
+{
+    CanPublish_t pub;
+    CanDb_SensorStatus_t rx = {0};
+    uint32_t last_rx_ms = 0, max_gap_ms = 0, max_active_gap_ms = 0;
+    uint32_t stale_ms = 0, max_stale_ms = 0, frames = 0;
+    int missed_urgent = 0;
+
+    srand(1);
+    CanPublish_Init(&pub);
+
+    for (uint32_t t = 0; t < RUN_MS; t += SAMPLE_MS)
+    {
+        CanDb_SensorStatus_t m = {0};
+        m.front_valid = 1;
+        m.rear_valid = 1;
+        m.light_dark = (t / 7000) % 2;
+        m.motor_rpm = (int16_t)sc->rpm((int)t);
+        if (sc->obstacle_period_ms) m.obstacle_front = (t / sc->obstacle_period_ms) % 2;
+
+        bool discrete_changed = (m.obstacle_front != rx.obstacle_front) || (m.light_dark != rx.light_dark);
+        CanPublishReason_t reason = CanPublish_Evaluate(&pub, &m, t);
+
+        if (reason != CAN_PUB_NONE)
+        {
+            uint32_t gap = t - last_rx_ms;
+            if (frames > 0 && gap > max_gap_ms) max_gap_ms = gap;
+            if (frames > 0 && rx.motor_rpm != 0 && gap > max_active_gap_ms) max_active_gap_ms = gap;
+            rx = m;
+            last_rx_ms = t;
+            frames++;
+        }
+        else if (discrete_changed)
+        {
+            missed_urgent++;
+        }
+
+        int drpm = abs(m.motor_rpm - rx.motor_rpm);
+        stale_ms = (drpm >= CAN_PUB_RPM_DEADBAND) ? stale_ms + SAMPLE_MS : 0;
+        if (stale_ms > max_stale_ms) max_stale_ms = stale_ms;
+    }
+
+    double secs = RUN_MS / 1000.0;
+    double fps = frames / secs;
+    double load = pub.tx_bits / secs / BITRATE * 100.0;
+    double base = 1000.0 / SAMPLE_MS * CanPublish_FrameBits(CANDB_SENSOR_STATUS_DLC) / BITRATE * 100.0;
+
+    printf("%-24s %6.1f fr/s (urgent %5u change %5u hb %5u)  load %.2f%% (10ms 주기 %.2f%%)  gap max %3u ms, active %3u ms, rpm stale max %2u ms\n",
+           sc->name, fps, pub.sent_count[CAN_PUB_URGENT], pub.sent_count[CAN_PUB_CHANGE],
+           pub.sent_count[CAN_PUB_HEARTBEAT], load, base, max_gap_ms, max_active_gap_ms, max_stale_ms);
+
+    HT_CHECK(max_gap_ms <= CAN_PUB_HEARTBEAT_MS, "%s: gap %u ms > heartbeat", sc->name, max_gap_ms);
+    HT_CHECK(max_active_gap_ms <= CAN_PUB_ACTIVE_HEARTBEAT_MS, "%s: gap while rotating %u ms", sc->name, max_active_gap_ms);
+    HT_CHECK(missed_urgent == 0, "%s: %d discrete changes not sent immediately", sc->name, missed_urgent);
+    HT_CHECK(max_stale_ms <= CAN_PUB_MIN_INTERVAL_MS + SAMPLE_MS, "%s: rpm stale for %u ms", sc->name, max_stale_ms);
+    // 상한: RPM 변화는 최소 간격마다 한 번, 정지 중에는 하트비트만 + 이산 신호 변화
+    double max_fps = ((sc->rpm == Rpm_Parked) ? 1000.0 / CAN_PUB_HEARTBEAT_MS : 1000.0 / CAN_PUB_MIN_INTERVAL_MS)
+                   + pub.sent_count[CAN_PUB_URGENT] / secs;
+    HT_CHECK(fps <= max_fps, "%s: %.1f fr/s > %.1f", sc->name, fps, max_fps);
+}
+
+int main(void)
+{
+    static const Scenario_t scenarios[] = {
+        {"parked",                  Rpm_Parked,  0},
+        {"cruise 120rpm +-1",       Rpm_Cruise,  0},
+        {"accel 0->200 in 5s",      Rpm_Accel,   0},
+        {"stop-go 2s",              Rpm_StopGo,  0},
+        {"forward/reverse 80rpm",   Rpm_Reverse, 0},
+        {"cruise + obstacle 300ms", Rpm_Cruise,  300},
+    };
+
+    for (unsigned i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        Run(&scenarios[i]);
+    }
+
+    // 프레임 비트 수: DLC 0 최악 55비트, DLC 8 최악 135비트 (CAN 2.0A, 스터핑 + IFS 포함)
+    HT_CHECK(CanPublish_FrameBits(0) == 55 && CanPublish_FrameBits(8) == 135, "frame bits %u / %u",
+             CanPublish_FrameBits(0), CanPublish_FrameBits(8));
+
+    return HT_RESULT();
+}
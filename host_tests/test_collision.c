@@ -0,0 +1,232 @@
+/**
+ * @file test_collision.c
+ * @brief 주행 방향 명령으로 엔코더 RPM 부호 → 전진 방향을 학습하는 Collision_SignUpdate를 검증한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 모터 배선(+1/-1)과 관성(시정수 100~400ms)을 바꿔 가며 10ms 주기로 방향 명령과 RPM을 넣는다.
+ * 명령은 전진/후진/브레이크와 RF 끊김 구간이 임의로 섞이며, 방향이 바뀐 직후에는 모터가 이전 방향으로 관성 회전한다.
+ * - 학습된 부호 × 배선 = +1 (바퀴 속도가 전진일 때 전방 센서 쪽 양수)
+ * - 방향이 바뀌는 관성 구간에서도 잘못 확정하거나 불일치를 세지 않는다
+ * - 명령이 무효이거나 정지 중이면 확정하지 않는다
+ * - 배선이 반대여도 후방 센서가 멀어지는 물체에 오정지하지 않는다 (고정 부호 +1이면 오정지)
+ * - 에코 타임아웃(무효) 직후 튀는 짧은 에코 하나로 정지하지 않고, 실제 근접 물체는 다음 측정에서 정지한다
+ */
+
+#include <math.h>
+#include "host_test.h"
+#include "collision.h"
+
+#define STEP_MS     10
+#define MOTOR_RPM_X10 1000 // 구동 중 정상 상태 회전 속도 (100 RPM)
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t Rand_Next(void)
+{
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/* 1. 임의 주행: 0.2~2초마다 명령을 바꾸고, 모터는 1차 지연으로 목표 회전 속도를 따라간다. */
+static void Test_Drive(int wiring, double tau_ms)
+{
+    CollisionWheelSign_t ws;
+    double rpm = 0.0;
+    bool forward = true, brake = true, rf_ok = true;
+    uint32_t next_cmd_ms = 0, learned_ms = 0;
+    int bad = 0;
+
+    Collision_SignInit(&ws);
+    for (uint32_t now = 0; now < 600000; now += STEP_MS)
+    {
+        if (now >= next_cmd_ms)
+        {
+            uint32_t r = Rand_Next() % 10;
+            forward = (r < 4) ? true : (r < 8) ? false : forward;
+            brake = (r == 8);
+            rf_ok = (r != 9);
+            next_cmd_ms = now + 200 + Rand_Next() % 1800;
+        }
+
+        // RF가 끊기거나 브레이크면 모터는 0으로 감속한다.
+        double target = (rf_ok && !brake) ? (forward ? MOTOR_RPM_X10 : -MOTOR_RPM_X10) : 0.0;
+        rpm += (target - rpm) * (1.0 - exp(-STEP_MS / tau_ms));
+
+        int32_t rpm_x10 = (int32_t)lround(wiring * rpm) + (int32_t)(Rand_Next() % 31) - 15; // ±1.5 RPM 노이즈
+        int8_t sign = Collision_SignUpdate(&ws, rf_ok && !brake, forward, rpm_x10, now);
+
+        if (sign != 0 && learned_ms == 0)
+        {
+            learned_ms = now;
+        }
+        if (sign != 0 && sign != wiring)
+        {
+            bad++;
+        }
+    }
+
+    printf("wiring %+d tau %3.0f ms: learned at %u ms, mismatch %u\n",
+           wiring, tau_ms, learned_ms, ws.mismatch_count);
+    HT_CHECK(ws.sign == wiring, "wiring %d tau %.0f: sign %d", wiring, tau_ms, ws.sign);
+    HT_CHECK(bad == 0, "wiring %d tau %.0f: %d samples with wrong sign", wiring, tau_ms, bad);
+    HT_CHECK(ws.mismatch_count == 0, "wiring %d tau %.0f: mismatch %u", wiring, tau_ms, ws.mismatch_count);
+}
+
+/* 2. 확정 시간: 정지 상태에서 전진 명령 후 SETTLE + CONFIRM 주기 안에 확정한다. */
+static void Test_LearnTime(int wiring, bool forward)
+{
+    CollisionWheelSign_t ws;
+    double rpm = 0.0;
+    uint32_t now;
+
+    Collision_SignInit(&ws);
+    for (now = 0; now < 5000 && ws.sign == 0; now += STEP_MS)
+    {
+        rpm += ((forward ? MOTOR_RPM_X10 : -MOTOR_RPM_X10) - rpm) * (1.0 - exp(-STEP_MS / 100.0));
+        Collision_SignUpdate(&ws, true, forward, (int32_t)lround(wiring * rpm), now);
+    }
+
+    uint32_t limit = COLL_SIGN_SETTLE_MS + COLL_SIGN_CONFIRM_COUNT * STEP_MS;
+    HT_CHECK(ws.sign == wiring, "wiring %d forward %d: sign %d", wiring, forward, ws.sign);
+    HT_CHECK(now <= limit, "wiring %d forward %d: learned after %u ms > %u ms", wiring, forward, now, limit);
+}
+
+/* 3. 명령이 무효(수신 없음/RF 끊김/브레이크)이거나 회전이 느리면 확정하지 않고, 무효 구간은 연속 횟수를 끊는다. */
+static void Test_NoCommand(void)
+{
+    CollisionWheelSign_t ws;
+
+    Collision_SignInit(&ws);
+    for (uint32_t now = 0; now < 10000; now += STEP_MS)
+    {
+        HT_CHECK(Collision_SignUpdate(&ws, false, true, 1000, now) == 0, "learned without command");
+    }
+    for (uint32_t now = 10000; now < 20000; now += STEP_MS)
+    {
+        HT_CHECK(Collision_SignUpdate(&ws, true, true, COLL_SIGN_MIN_RPM_X10 - 1, now) == 0, "learned below min rpm");
+    }
+
+    // 연속 확정 횟수 직전에 명령이 끊기면 처음부터 다시 센다.
+    Collision_SignInit(&ws);
+    uint32_t now = COLL_SIGN_SETTLE_MS;
+    Collision_SignUpdate(&ws, true, true, 1000, 0);
+    for (int i = 0; i < COLL_SIGN_CONFIRM_COUNT - 1; i++, now += STEP_MS)
+    {
+        Collision_SignUpdate(&ws, true, true, 1000, now);
+    }
+    Collision_SignUpdate(&ws, false, true, 1000, now);
+    now += STEP_MS;
+    HT_CHECK(Collision_SignUpdate(&ws, true, true, 1000, now) == 0, "run not reset by invalid command");
+}
+
+/* 4. 후방 센서: 전진하며 뒤쪽 물체(벽)에서 멀어지는 중에 오정지하지 않는다.
+ *    배선 -1에서 예전처럼 부호를 +1로 고정하면 후방 바퀴 항이 접근(+300mm/s)으로 뒤집혀 오정지한다. */
+static bool Run_RearMovingAway(int8_t (*sign_of)(CollisionWheelSign_t *, uint32_t), uint32_t *stop_ms)
+{
+    CollisionTrack_t trk;
+    CollisionWheelSign_t ws;
+    const int wiring = -1;
+
+    Collision_Init(&trk);
+    Collision_SignInit(&ws);
+    *stop_ms = 0;
+    for (uint32_t now = 0; now < 2000; now += STEP_MS)
+    {
+        int32_t rpm_x10 = wiring * MOTOR_RPM_X10;
+        int32_t wheel_raw_mm_s = wiring * 300; // 엔코더 부호 그대로의 선속도 (실제 전진 300mm/s)
+        uint32_t meas_ms = now - now % 60;     // 60ms마다 측정
+        uint16_t rear_mm = (uint16_t)(120 + (300 * meas_ms) / 1000);
+
+        Collision_SignUpdate(&ws, true, true, rpm_x10, now);
+        int32_t wheel_mm_s = sign_of(&ws, now) * wheel_raw_mm_s;
+        if (Collision_Update(&trk, rear_mm, (uint16_t)(now - meas_ms), true, -wheel_mm_s, now) && *stop_ms == 0)
+        {
+            *stop_ms = now;
+        }
+    }
+    return *stop_ms != 0;
+}
+
+static int8_t Sign_Learned(CollisionWheelSign_t *ws, uint32_t now)
+{
+    (void)now;
+    return ws->sign;
+}
+
+static int8_t Sign_FixedPlusOne(CollisionWheelSign_t *ws, uint32_t now)
+{
+    (void)ws;
+    (void)now;
+    return 1;
+}
+
+static void Test_RearMovingAway(void)
+{
+    uint32_t stop_ms;
+
+    HT_CHECK(!Run_RearMovingAway(Sign_Learned, &stop_ms), "learned sign: false rear stop at %u ms", stop_ms);
+    HT_CHECK(Run_RearMovingAway(Sign_FixedPlusOne, &stop_ms), "fixed +1 sign should give a false rear stop");
+    printf("rear moving away (wiring -1): learned sign no stop, fixed +1 false stop at %u ms\n", stop_ms);
+}
+
+/* 5. 무효 → 짧은 헛 에코 하나 → 실제 거리. 새 추적은 일관된 두 번째 측정 전에는 정지하지 않는다.
+ *    near_mm 뒤에 far_mm가 이어지면 정지가 없어야 하고, near_mm가 계속되면 다음 측정에서 정지해야 한다. */
+static uint32_t Run_AfterTimeout(uint16_t near_mm, uint16_t far_mm, int32_t wheel_mm_s, uint32_t *stop_ticks)
+{
+    CollisionTrack_t trk;
+    uint32_t first_stop = 0;
+
+    Collision_Init(&trk);
+    *stop_ticks = 0;
+    // 0~300ms: 타임아웃으로 무효, 300ms에 near_mm, 이후 60ms마다 far_mm
+    for (uint32_t now = 0; now < 1000; now += STEP_MS)
+    {
+        uint32_t meas_ms = now - now % 60;
+        bool valid = (meas_ms >= 300);
+        uint16_t mm = (meas_ms == 300) ? near_mm : far_mm;
+
+        if (Collision_Update(&trk, mm, (uint16_t)(now - meas_ms), valid, wheel_mm_s, now))
+        {
+            if (first_stop == 0) first_stop = now;
+            (*stop_ticks)++;
+        }
+    }
+    return first_stop;
+}
+
+static void Test_SpuriousAfterTimeout(void)
+{
+    static const int32_t wheels[] = {0, 300};
+    uint32_t ticks;
+
+    for (unsigned w = 0; w < sizeof(wheels) / sizeof(wheels[0]); w++)
+    {
+        // 헛 에코 60mm 하나 뒤에 실제 2000mm: 정지하지 않는다.
+        Run_AfterTimeout(60, 2000, wheels[w], &ticks);
+        HT_CHECK(ticks == 0, "wheel %d: spurious 60mm after timeout stopped for %u ms", wheels[w], ticks * STEP_MS);
+
+        // 실제 80mm 물체: 두 번째 측정(360ms)에서 정지한다.
+        uint32_t first = Run_AfterTimeout(80, 80, wheels[w], &ticks);
+        HT_CHECK(first == 360, "wheel %d: real 80mm after timeout first stop at %u ms (expected 360)", wheels[w], first);
+    }
+}
+
+int main(void)
+{
+    static const double taus[] = {100.0, 200.0, 400.0};
+
+    for (int w = -1; w <= 1; w += 2)
+    {
+        for (unsigned t = 0; t < sizeof(taus) / sizeof(taus[0]); t++)
+        {
+            Test_Drive(w, taus[t]);
+        }
+        Test_LearnTime(w, true);
+        Test_LearnTime(w, false);
+    }
+    Test_NoCommand();
+    Test_RearMovingAway();
+    Test_SpuriousAfterTimeout();
+
+    return HT_RESULT();
+}
@@ -0,0 +1,242 @@
+/**
+ * @file test_hampel_filter.c
+ * @brief 증분 중앙값/Hampel 필터(hampel_filter)를 정렬 기준 구현과 비교하고, 합성 에코 트레이스로 효과를 측정한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 1. 기준 구현은 매 샘플마다 윈도우를 복사해 정렬하고 중앙값, MAD, 신뢰도, 출력을 다시 계산한다.
+ * 2. 기록된 에코 트레이스가 없으므로 HC-SR04 유사 합성 트레이스를 쓴다. (60ms 측정, 노이즈 σ 3mm,
+ *    3% 짧은 헛 에코 20~300mm, 2% 긴 헛 에코 3~4m) 세 필터 출력(필터 없음 / 중앙값 5 / Hampel + 신뢰도 게이트)을
+ *    같은 입력으로 비교해 오검출(실제 거리 > 150mm인데 장애물 비트) 샘플 수와 실제 ≤ 100mm 이후 검출 지연을 잰다.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "hampel_filter.h"
+
+#define MEAS_MS        60   // Ultrasonic US_MEAS_PERIOD_MS
+#define OBSTACLE_MM    100  // CANTask 장애물 판단 거리
+#define MIN_CONFIDENCE 60   // US_MIN_CONFIDENCE
+#define RUN_SAMPLES    200  // 시나리오 한 번 = 12초, 시작마다 필터를 비운다
+#define TRACE_SAMPLES  100000
+
+static uint32_t rng_state = 314159265u;
+
+static uint32_t Rand_Next(void)
+{
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static double Rand_Gauss(void)
+{
+    double u = (Rand_Next() + 1.0) / 4294967297.0;
+    double v = (Rand_Next() + 1.0) / 4294967297.0;
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+static int Cmp_Int(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+/* 1. 정렬 기준 구현과 비교: 좁은/보통/넓은 분포에 10% 임의 이상값을 섞는다. */
+static void Test_Reference(void)
+{
+    long bad = 0;
+
+    for (int trial = 0; trial < 2000; trial++)
+    {
+        HampelFilter_t f;
+        int hist[500];
+        int range = (trial % 3 == 0) ? 5 : (trial % 3 == 1) ? 100 : 5000;
+
+        HampelFilter_Init(&f);
+        for (int n = 0; n < 500; n++)
+        {
+            int x = 1000 + (int)(Rand_Next() % range);
+            if (Rand_Next() % 10 == 0) x = (int)(Rand_Next() % 4000);
+            hist[n] = x;
+
+            uint16_t out = HampelFilter_Push(&f, (uint16_t)x);
+
+            int c = (n + 1 < HAMPEL_WINDOW) ? n + 1 : HAMPEL_WINDOW;
+            int w[HAMPEL_WINDOW], d[HAMPEL_WINDOW];
+            for (int i = 0; i < c; i++) w[i] = hist[n + 1 - c + i];
+            qsort(w, c, sizeof(int), Cmp_Int);
+            int med = w[(c - 1) / 2];
+            for (int i = 0; i < c; i++) d[i] = abs(w[i] - med);
+            qsort(d, c, sizeof(int), Cmp_Int);
+            int mad = d[(c - 1) / 2];
+            int thr = mad * HAMPEL_K_X10 * HAMPEL_MAD_TO_SIGMA_X1000 / 10000;
+            if (thr < HAMPEL_MIN_THRESHOLD_MM) thr = HAMPEL_MIN_THRESHOLD_MM;
+            int in = 0;
+            for (int i = 0; i < c; i++) if (abs(w[i] - med) <= thr) in++;
+            int o = (c >= HAMPEL_MIN_SAMPLES && abs(x - med) > thr) ? med : x;
+
+            bool ok = (med == f.median_mm) && (mad == f.mad_mm) && (o == out) &&
+                      (in * 100 / HAMPEL_WINDOW == f.confidence);
+            for (int i = 1; i < c; i++) ok = ok && (f.sorted[i - 1] <= f.sorted[i]);
+            if (!ok && bad++ < 5)
+            {
+                HT_CHECK(0, "trial %d n %d: med %d/%u mad %d/%u out %d/%u conf %d/%u", trial, n,
+                         med, f.median_mm, mad, f.mad_mm, o, out, in * 100 / HAMPEL_WINDOW, f.confidence);
+            }
+        }
+    }
+    printf("reference: 2000 x 500 samples, %ld mismatches\n", bad);
+}
+
+/* 2. 합성 트레이스 시나리오별 실제 거리 (mm) */
+typedef enum { SC_WALL, SC_APPROACH, SC_APPEAR, SC_COUNT } Scenario_t;
+
+static double Truth_Mm(Scenario_t sc, double t)
+{
+    switch (sc)
+    {
+    case SC_WALL:     return 400.0;
+    case SC_APPROACH: return (1500.0 - 300.0 * t < 40.0) ? 40.0 : 1500.0 - 300.0 * t;
+    default:          return (t < 3.0) ? 1200.0 : 80.0;
+    }
+}
+
+typedef struct {
+    long   false_obstacle;  // 실제 > 150mm인데 장애물 비트
+    long   gross_err;       // |출력 - 실제| > 50mm 샘플 수
+    double lag_sum_ms;      // 실제 ≤ 100mm 이후 첫 장애물 비트까지 지연 합
+    long   lag_n;
+} TraceStat_t;
+
+enum { OUT_RAW, OUT_MEDIAN5, OUT_HAMPEL, OUT_COUNT };
+
+static void Run_Trace(Scenario_t sc, TraceStat_t st[OUT_COUNT])
+{
+    HampelFilter_t f;
+    uint16_t win[5];
+    int wc = 0;
+    double cross = -1.0;
+    bool got[OUT_COUNT] = {0};
+
+    memset(st, 0, sizeof(TraceStat_t) * OUT_COUNT);
+    for (int k = 0; k < TRACE_SAMPLES; k++)
+    {
+        double t = (k % RUN_SAMPLES) * (MEAS_MS / 1000.0);
+        if (k % RUN_SAMPLES == 0)
+        {
+            HampelFilter_Init(&f);
+            wc = 0;
+            cross = -1.0;
+            memset(got, 0, sizeof(got));
+        }
+
+        double tr = Truth_Mm(sc, t);
+        if (tr <= OBSTACLE_MM && cross < 0.0) cross = t;
+
+        int meas = (int)lround(tr + 3.0 * Rand_Gauss());
+        uint32_t r = Rand_Next() % 1000;
+        if (r < 30) meas = 20 + (int)(Rand_Next() % 280);          // 짧은 헛 에코 (다른 물체/다중 경로)
+        else if (r < 50) meas = 3000 + (int)(Rand_Next() % 1000);  // 긴 헛 에코 (에코 놓침)
+        uint16_t raw = (uint16_t)meas;
+
+        uint16_t hp = HampelFilter_Push(&f, raw);
+
+        // 비교용 단순 중앙값 5 (지연 있음)
+        if (wc < 5) win[wc++] = raw;
+        else { memmove(win, win + 1, sizeof(win) - sizeof(win[0])); win[4] = raw; }
+        int s[5];
+        for (int i = 0; i < wc; i++) s[i] = win[i];
+        qsort(s, wc, sizeof(int), Cmp_Int);
+
+        uint16_t out[OUT_COUNT] = {raw, (uint16_t)s[(wc - 1) / 2], hp};
+        for (int m = 0; m < OUT_COUNT; m++)
+        {
+            bool ob = (out[m] <= OBSTACLE_MM) && ((m != OUT_HAMPEL) || (f.confidence >= MIN_CONFIDENCE));
+            if (tr > 150.0 && ob) st[m].false_obstacle++;
+            if (fabs(out[m] - tr) > 50.0) st[m].gross_err++;
+            if (cross >= 0.0 && !got[m] && ob)
+            {
+                got[m] = true;
+                st[m].lag_sum_ms += (t - cross) * 1000.0;
+                st[m].lag_n++;
+            }
+        }
+    }
+}
+
+static double Lag_Ms(const TraceStat_t *st)
+{
+    return st->lag_n ? st->lag_sum_ms / st->lag_n : -1.0;
+}
+
+static void Test_Traces(void)
+{
+    static const char *const names[SC_COUNT] = {"static wall 400mm", "approach 300mm/s", "object appears 80mm"};
+
+    for (int sc = 0; sc < SC_COUNT; sc++)
+    {
+        TraceStat_t st[OUT_COUNT];
+
+        Run_Trace((Scenario_t)sc, st);
+        printf("%-20s false obstacle raw %4ld median5 %3ld hampel %3ld | err>50mm raw %5ld median5 %5ld hampel %5ld"
+               " | lag raw %4.0f median5 %4.0f hampel %4.0f ms\n",
+               names[sc], st[OUT_RAW].false_obstacle, st[OUT_MEDIAN5].false_obstacle, st[OUT_HAMPEL].false_obstacle,
+               st[OUT_RAW].gross_err, st[OUT_MEDIAN5].gross_err, st[OUT_HAMPEL].gross_err,
+               Lag_Ms(&st[OUT_RAW]), Lag_Ms(&st[OUT_MEDIAN5]), Lag_Ms(&st[OUT_HAMPEL]));
+
+        // 오검출은 필터 없음의 1/10 이하, 50mm 넘게 틀린 샘플은 1/3 이하 (중앙값 5와 같은 수준, 아래 지연 조건은 더 좋다)
+        HT_CHECK(st[OUT_HAMPEL].false_obstacle * 10 <= st[OUT_RAW].false_obstacle,
+                 "%s: hampel false obstacle %ld vs raw %ld", names[sc],
+                 st[OUT_HAMPEL].false_obstacle, st[OUT_RAW].false_obstacle);
+        HT_CHECK(st[OUT_HAMPEL].gross_err * 3 <= st[OUT_RAW].gross_err,
+                 "%s: hampel gross error %ld vs raw %ld", names[sc],
+                 st[OUT_HAMPEL].gross_err, st[OUT_RAW].gross_err);
+
+        if (sc == SC_APPROACH)
+        {
+            // 천천히 다가오면 이상값이 아니므로 필터 없음과 같은 시점에 검출한다. (1측정 여유, 중앙값 5는 2측정 늦다)
+            HT_CHECK(Lag_Ms(&st[OUT_HAMPEL]) <= Lag_Ms(&st[OUT_RAW]) + MEAS_MS,
+                     "approach: hampel lag %.0f ms vs raw %.0f ms", Lag_Ms(&st[OUT_HAMPEL]), Lag_Ms(&st[OUT_RAW]));
+            HT_CHECK(Lag_Ms(&st[OUT_HAMPEL]) + MEAS_MS <= Lag_Ms(&st[OUT_MEDIAN5]),
+                     "approach: hampel lag %.0f ms vs median5 %.0f ms", Lag_Ms(&st[OUT_HAMPEL]), Lag_Ms(&st[OUT_MEDIAN5]));
+        }
+        else if (sc == SC_APPEAR)
+        {
+            // 거리 급변은 세 번째 측정에서 받아들인다. (헛 에코가 겹치면 한 측정 더)
+            HT_CHECK(Lag_Ms(&st[OUT_HAMPEL]) <= 3 * MEAS_MS,
+                     "appear: hampel lag %.0f ms > %d ms", Lag_Ms(&st[OUT_HAMPEL]), 3 * MEAS_MS);
+        }
+    }
+}
+
+/* 3. 비용: 샘플 하나 넣는 평균 시간 (호스트). 보드에서는 센서당 60ms에 한 번이다. */
+static void Bench_Push(void)
+{
+    enum { N = 1000000 };
+    uint16_t *buf = malloc(sizeof(uint16_t) * N);
+    HampelFilter_t f;
+    volatile uint32_t sink = 0;
+
+    for (int i = 0; i < N; i++)
+    {
+        buf[i] = (uint16_t)(400.0 + 3.0 * Rand_Gauss() + ((Rand_Next() % 100 < 5) ? Rand_Next() % 3000 : 0));
+    }
+    HampelFilter_Init(&f);
+    uint64_t t0 = ht_now_ns(), c0 = ht_cycles();
+    for (int i = 0; i < N; i++) sink += HampelFilter_Push(&f, buf[i]);
+    uint64_t t1 = ht_now_ns(), c1 = ht_cycles();
+    (void)sink;
+
+    printf("host cost per push: %.1f ns (%.0f cycles), outliers replaced %u / %u\n",
+           (double)(t1 - t0) / N, (double)(c1 - c0) / N, f.outlier_count, f.sample_count);
+    free(buf);
+}
+
+int main(void)
+{
+    Test_Reference();
+    Test_Traces();
+    Bench_Push();
+
+    return HT_RESULT();
+}
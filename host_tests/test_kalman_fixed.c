@@ -0,0 +1,197 @@
+/**
+ * @file test_kalman_fixed.c
+ * @brief 고정소수점 칼만 roll 추정(kalman_fixed)을 double 구현과 비교하고 갱신 비용을 측정한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note double 기준 구현은 mpu6050.c의 Kalman_getAngle과 MPU6050_Solve(roll 경로)를 그대로 옮긴 것이다.
+ * 합성 IMU 샘플(±60° 사인 + 계단 + 노이즈 + 자이로 바이어스, 200Hz)을 두 경로에 같은 순서로 넣는다.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "kalman_fixed.h"
+
+#define RAD_TO_DEG   57.295779513082320876798154814105
+#define SAMPLE_US    5000   // MPU6050_ACQ_DMA 기본 200Hz
+#define SAMPLE_COUNT 200000 // 1000초
+#define MAX_ERR_DEG  0.01   // kalman_fixed.c 설계 목표 (전송 분해능 0.01°)
+
+typedef struct
+{
+    double Q_angle;
+    double Q_bias;
+    double R_measure;
+    double angle;
+    double bias;
+    double P[2][2];
+} Kalman_t;
+
+typedef struct
+{
+    int16_t ax, ay, az, gx;
+} ImuSample_t;
+
+/* mpu6050.c Kalman_getAngle 복사본 */
+static double Kalman_getAngle(Kalman_t *Kalman, double newAngle, double newRate, double dt)
+{
+    double rate = newRate - Kalman->bias;
+    Kalman->angle += dt * rate;
+
+    Kalman->P[0][0] += dt * (dt * Kalman->P[1][1] - Kalman->P[0][1] - Kalman->P[1][0] + Kalman->Q_angle);
+    Kalman->P[0][1] -= dt * Kalman->P[1][1];
+    Kalman->P[1][0] -= dt * Kalman->P[1][1];
+    Kalman->P[1][1] += Kalman->Q_bias * dt;
+
+    double S = Kalman->P[0][0] + Kalman->R_measure;
+    double K[2];
+    K[0] = Kalman->P[0][0] / S;
+    K[1] = Kalman->P[1][0] / S;
+
+    double y = newAngle - Kalman->angle;
+    Kalman->angle += K[0] * y;
+    Kalman->bias += K[1] * y;
+
+    double P00_temp = Kalman->P[0][0];
+    double P01_temp = Kalman->P[0][1];
+
+    Kalman->P[0][0] -= K[0] * P00_temp;
+    Kalman->P[0][1] -= K[0] * P01_temp;
+    Kalman->P[1][0] -= K[1] * P00_temp;
+    Kalman->P[1][1] -= K[1] * P01_temp;
+
+    return Kalman->angle;
+}
+
+/* MPU6050_Solve의 double roll 경로 */
+static double Solve_Double(Kalman_t *k, const ImuSample_t *s)
+{
+    double dt = (double)SAMPLE_US / 1000000;
+    double gx = s->gx / 131.0;
+    double roll = 0.0;
+    double roll_sqrt = sqrt(s->ax * s->ax + s->az * s->az);
+
+    if (roll_sqrt != 0.0)
+    {
+        roll = atan(s->ay / roll_sqrt) * RAD_TO_DEG;
+    }
+    return Kalman_getAngle(k, roll, gx, dt);
+}
+
+/* MPU6050_Solve_Fixed의 roll 경로 */
+static q16_t Solve_Fixed(KalmanQ_t *k, const ImuSample_t *s)
+{
+    q31_t dt = (q31_t)(((int64_t)SAMPLE_US << Q31_SHIFT) / 1000000);
+    q16_t gx = (q16_t)((int32_t)s->gx * Q16_ONE / 131);
+    int32_t ax = s->ax, ay = s->ay, az = s->az;
+    uint32_t roll_sqrt = Fixed_Sqrt((uint32_t)(ax * ax) + (uint32_t)(az * az));
+    q16_t roll = (roll_sqrt != 0) ? Fixed_Atan2Deg(ay, (int32_t)roll_sqrt) : 0;
+
+    return KalmanQ_getAngle(k, roll, gx, dt);
+}
+
+static uint32_t rng_state = 12345;
+
+static double Rand_Gauss(void)
+{
+    double u, v;
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    u = (rng_state + 1.0) / 4294967297.0;
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    v = (rng_state + 1.0) / 4294967297.0;
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+static int16_t Clamp16(double v)
+{
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)lround(v);
+}
+
+/* 실제 roll: 0.2Hz ±60° 사인에 10초마다 ±30° 계단을 더한다. */
+static void Make_Samples(ImuSample_t *s, int n)
+{
+    double prev = 0.0;
+
+    for (int i = 0; i < n; i++)
+    {
+        double t = i * (SAMPLE_US / 1e6);
+        double roll = 60.0 * sin(6.283185307179586 * 0.2 * t) + ((((int)t / 10) % 2) ? 30.0 : -30.0);
+        double rate = (i == 0) ? 0.0 : (roll - prev) / (SAMPLE_US / 1e6);
+        double r = roll / RAD_TO_DEG;
+
+        prev = roll;
+        s[i].ax = Clamp16(300.0 + 80.0 * Rand_Gauss());
+        s[i].ay = Clamp16(16384.0 * sin(r) + 80.0 * Rand_Gauss());
+        s[i].az = Clamp16(16384.0 * cos(r) + 80.0 * Rand_Gauss());
+        s[i].gx = Clamp16((rate + 1.5) * 131.0 + 20.0 * Rand_Gauss()); // 1.5°/s 바이어스
+    }
+}
+
+int main(void)
+{
+    ImuSample_t *samples = malloc(sizeof(ImuSample_t) * SAMPLE_COUNT);
+    Kalman_t kd = {.Q_angle = 0.001f, .Q_bias = 0.003f, .R_measure = 0.03f};
+    KalmanQ_t kq = {.Q_angle = Q31_FROM_DOUBLE(0.001), .Q_bias = Q31_FROM_DOUBLE(0.003),
+                    .R_measure = Q31_FROM_DOUBLE(0.03)};
+    double max_err = 0.0, sum_err = 0.0;
+
+    Make_Samples(samples, SAMPLE_COUNT);
+
+    // 1. 정확도: 같은 샘플 순서로 두 경로를 돌려 추정 각도를 비교한다.
+    for (int i = 0; i < SAMPLE_COUNT; i++)
+    {
+        double d = Solve_Double(&kd, &samples[i]);
+        double q = Solve_Fixed(&kq, &samples[i]) / 65536.0;
+        double err = fabs(d - q);
+
+        sum_err += err;
+        if (err > max_err) max_err = err;
+    }
+    printf("roll |fixed - double|: max %.5f deg, mean %.6f deg over %d samples\n",
+           max_err, sum_err / SAMPLE_COUNT, SAMPLE_COUNT);
+    HT_CHECK(max_err <= MAX_ERR_DEG, "max error %.5f deg > %.2f deg", max_err, MAX_ERR_DEG);
+
+    // 보조 함수 단독 오차
+    double atan_err = 0.0;
+    for (int32_t y = -32768; y <= 32767; y += 7)
+    {
+        for (int32_t x = -32768; x <= 32767; x += 4099)
+        {
+            double e = fabs(Fixed_Atan2Deg(y, x) / 65536.0 - atan2(y, x) * RAD_TO_DEG);
+            if (e > 180.0) e = 360.0 - e;
+            if (e > atan_err) atan_err = e;
+        }
+    }
+    printf("Fixed_Atan2Deg max error %.5f deg\n", atan_err);
+    HT_CHECK(atan_err <= 0.003, "atan2 error %.5f deg", atan_err);
+
+    for (uint32_t x = 0; x < (1U << 31); x += 9973)
+    {
+        uint32_t r = Fixed_Sqrt(x);
+        if (!((uint64_t)r * r <= x && (uint64_t)(r + 1) * (r + 1) > x))
+        {
+            HT_CHECK(0, "Fixed_Sqrt(%u) = %u", x, r);
+            break;
+        }
+    }
+
+    // 2. 비용: 갱신 한 번(roll 측정 + 칼만)의 평균 시간. 호스트 값이며 Cortex-M3에서는 double이 소프트웨어 에뮬레이션이라 차이가 더 크다.
+    volatile double sink_d = 0.0;
+    volatile q16_t sink_q = 0;
+    uint64_t t0 = ht_now_ns(), c0 = ht_cycles();
+    for (int i = 0; i < SAMPLE_COUNT; i++) sink_d += Solve_Double(&kd, &samples[i]);
+    uint64_t t1 = ht_now_ns(), c1 = ht_cycles();
+    for (int i = 0; i < SAMPLE_COUNT; i++) sink_q += Solve_Fixed(&kq, &samples[i]);
+    uint64_t t2 = ht_now_ns(), c2 = ht_cycles();
+    (void)sink_d;
+    (void)sink_q;
+
+    printf("host cost per update: double %.1f ns (%.0f cycles), fixed %.1f ns (%.0f cycles)\n",
+           (double)(t1 - t0) / SAMPLE_COUNT, (double)(c1 - c0) / SAMPLE_COUNT,
+           (double)(t2 - t1) / SAMPLE_COUNT, (double)(c2 - c1) / SAMPLE_COUNT);
+
+    free(samples);
+    return HT_RESULT();
+}
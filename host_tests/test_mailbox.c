@@ -0,0 +1,142 @@
+/**
+ * @file test_mailbox.c
+ * @brief 최신값 메일박스(mailbox.c)를 생산자/소비자 pthread 두 개로 부하 시험한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note Mailbox_Exchange의 LDREXB/STREXB는 cmsis_atomic_shim.h에서 C11 atomic으로 대체된다.
+ * 메시지는 순번과 순번에서 유도한 워드로 채워, 소비자가 읽은 값이 찢어졌는지(torn read) 확인할 수 있게 한다.
+ * 확인 항목:
+ * - 읽은 메시지의 모든 워드가 같은 순번에서 나왔는지
+ * - 읽은 순번이 엄격히 증가하는지 (오래된 값이나 같은 값을 두 번 읽지 않음)
+ * - 종료 후 put_count == get_count + overwrite_count (모든 게시 값은 읽히거나 덮어써짐)
+ * - 마지막으로 읽은 값이 마지막 게시 값인지
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "host_test.h"
+#include "mailbox.h"
+
+#define PUT_COUNT 2000000U
+
+typedef struct
+{
+    uint32_t seq;
+    uint32_t word[15]; // 64바이트: 복사 도중 선점되면 찢어진 값이 드러나도록 큰 메시지
+} Message_t;
+
+typedef struct
+{
+    Mailbox_t *mb;
+    uint32_t seed;
+} ThreadArg_t;
+
+static atomic_bool producer_done;
+
+static uint32_t Rand_Next(uint32_t *s)
+{
+    *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5;
+    return *s;
+}
+
+static uint32_t Word_Of(uint32_t seq, int i)
+{
+    return seq * 2654435761u + (uint32_t)i * 40503u;
+}
+
+static void *Producer(void *p)
+{
+    ThreadArg_t *arg = p;
+    Message_t msg;
+
+    for (uint32_t seq = 1; seq <= PUT_COUNT; seq++)
+    {
+        msg.seq = seq;
+        for (int i = 0; i < 15; i++) msg.word[i] = Word_Of(seq, i);
+        Mailbox_Put(arg->mb, &msg);
+
+        if ((Rand_Next(&arg->seed) & 0x3FF) == 0) sched_yield(); // 가끔 양보해 교차 패턴을 바꾼다
+    }
+    atomic_store(&producer_done, true);
+    return NULL;
+}
+
+typedef struct
+{
+    uint32_t reads, torn, non_monotonic, last_seq;
+} ConsumerResult_t;
+
+static void Consume(Mailbox_t *mb, ConsumerResult_t *r)
+{
+    Message_t msg;
+
+    if (!Mailbox_Get(mb, &msg)) return;
+
+    int bad = 0;
+    for (int i = 0; i < 15; i++)
+    {
+        if (msg.word[i] != Word_Of(msg.seq, i)) bad = 1;
+    }
+    r->torn += bad;
+    if (msg.seq <= r->last_seq) r->non_monotonic++;
+    r->last_seq = msg.seq;
+    r->reads++;
+}
+
+static void *Consumer(void *p)
+{
+    ThreadArg_t *arg = p;
+    static ConsumerResult_t r;
+
+    while (!atomic_load(&producer_done))
+    {
+        Consume(arg->mb, &r);
+        if ((Rand_Next(&arg->seed) & 0x3FF) == 0) sched_yield();
+    }
+    Consume(arg->mb, &r); // 종료 후 남은 마지막 값
+    return &r;
+}
+
+int main(void)
+{
+    static uint8_t storage[MAILBOX_STORAGE_SIZE(sizeof(Message_t))];
+    Mailbox_t mb = MAILBOX_INITIALIZER(storage, sizeof(Message_t));
+    ThreadArg_t prod_arg = {&mb, 88172645u}, cons_arg = {&mb, 2463534242u};
+    pthread_t prod, cons;
+    ConsumerResult_t *r;
+
+    uint64_t t0 = ht_now_ns();
+    pthread_create(&cons, NULL, Consumer, &cons_arg);
+    pthread_create(&prod, NULL, Producer, &prod_arg);
+    pthread_join(prod, NULL);
+    pthread_join(cons, (void **)&r);
+    uint64_t t1 = ht_now_ns();
+
+    printf("puts %u, gets %u (empty %u), overwritten %u, torn %u, non-monotonic %u, %.1f ns/put\n",
+           mb.put_count, mb.get_count, mb.empty_count, mb.overwrite_count, r->torn, r->non_monotonic,
+           (double)(t1 - t0) / PUT_COUNT);
+
+    HT_CHECK(r->torn == 0, "%u torn reads", r->torn);
+    HT_CHECK(r->non_monotonic == 0, "%u stale or repeated reads", r->non_monotonic);
+    HT_CHECK(mb.put_count == PUT_COUNT, "put_count %u", mb.put_count);
+    HT_CHECK(mb.get_count == r->reads, "get_count %u != reads %u", mb.get_count, r->reads);
+    HT_CHECK(mb.put_count == mb.get_count + mb.overwrite_count, "put %u != get %u + overwrite %u",
+             mb.put_count, mb.get_count, mb.overwrite_count);
+    HT_CHECK(r->last_seq == PUT_COUNT, "last read seq %u != %u", r->last_seq, PUT_COUNT);
+    HT_CHECK(r->reads > 1000, "consumer read only %u values (no interleaving)", r->reads);
+
+    // 단일 스레드 기본 동작: 빈 메일박스, 덮어쓰기, 초기화
+    Message_t a = {.seq = 7}, b = {.seq = 8}, out = {0};
+    Mailbox_Init(&mb, storage, sizeof(Message_t));
+    HT_CHECK(!Mailbox_Get(&mb, &out) && out.seq == 0, "empty mailbox returned a value");
+    Mailbox_Put(&mb, &a);
+    Mailbox_Put(&mb, &b);
+    HT_CHECK(Mailbox_Get(&mb, &out) && out.seq == 8, "latest value not returned (%u)", out.seq);
+    HT_CHECK(!Mailbox_Get(&mb, &out), "same value returned twice");
+    HT_CHECK(mb.overwrite_count == 1 && mb.empty_count == 2, "counters overwrite %u empty %u",
+             mb.overwrite_count, mb.empty_count);
+
+    return HT_RESULT();
+}
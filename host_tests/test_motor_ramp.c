@@ -0,0 +1,206 @@
+/**
+ * @file test_motor_ramp.c
+ * @brief 중앙 ECU DC 모터 듀티 램프(DcMotor_RampStep)가 호출 주기와 무관하게 같은 경과 시간에 같은 듀티를 내는지 검증한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 가속 입력으로 시작 듀티를 만든 뒤 관성 주행/브레이크 램프를 1kHz, 100Hz, 지터(0.2~3ms, 5~15ms) 틱으로 진행하며
+ * 매 틱의 듀티를 닫힌 식 max(0, 시작 - 비율 × 경과 시간)과 비교한다.
+ * - 브레이크(100 milli-duty/µs)와 1ms/10ms 틱의 관성 주행은 정확히 같아야 한다
+ * - 지터 틱의 관성 주행(0.6 milli-duty/µs)은 틱마다 1 milli-duty 미만 절삭되므로, 닫힌 식보다 빠르지 않고 틱 수 미만으로만 늦다
+ * - MOTOR_DT_MAX_US보다 긴 틱은 MOTOR_DT_MAX_US만큼만 반영하며, 최대 dt에서도 32비트 중간값이 넘치지 않는다
+ */
+
+#include "host_test.h"
+#include "motor_ramp.h"
+
+#define RUN_US          2000000U // 램프 하나를 진행할 시간
+#define START_ACCEL_MS  500      // 시작 듀티를 만드는 가속 버튼 유지 시간 → (400 + 400) × 1000 milli-duty
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t Rand_Next(void)
+{
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+typedef enum
+{
+    TICK_1KHZ,
+    TICK_100HZ,
+    TICK_JITTER_1KHZ,   // 0.2 ~ 3ms
+    TICK_JITTER_100HZ,  // 5 ~ 15ms
+    TICK_STALL,         // 1kHz + 가끔 MOTOR_DT_MAX_US를 넘는 정지 (디버거 정지, 고우선순위 태스크 점유)
+    TICK_COUNT
+} TickMode_t;
+
+static const char *const tick_names[TICK_COUNT] = {"1 kHz", "100 Hz", "jitter 0.2-3ms", "jitter 5-15ms", "1 kHz + stalls"};
+
+static uint32_t Tick_NextDt(TickMode_t mode)
+{
+    switch (mode)
+    {
+    case TICK_1KHZ:         return 1000U;
+    case TICK_100HZ:        return 10000U;
+    case TICK_JITTER_1KHZ:  return 200U + Rand_Next() % 2801U;
+    case TICK_JITTER_100HZ: return 5000U + Rand_Next() % 10001U;
+    default:                return (Rand_Next() % 200U == 0U) ? 20001U + Rand_Next() % 200000U : 1000U;
+    }
+}
+
+typedef struct
+{
+    int32_t max_lag_m;     // 닫힌 식 대비 최대 지연 (milli-duty, 양수 = 램프가 느림)
+    int32_t min_lag_m;     // 음수면 닫힌 식보다 빠르게 감소한 적이 있음
+    uint32_t ticks;
+    uint32_t stalls;       // MOTOR_DT_MAX_US로 제한된 틱 수
+    uint32_t zero_us;      // 듀티가 0이 된 경과 시간 (µs)
+    int32_t duty_at_10ms[RUN_US / 10000U + 1U]; // 10ms 배수 시각의 듀티 (해당 시각에 틱이 없으면 -1)
+} RampResult_t;
+
+/* 시작 듀티를 가속 입력으로 만든 뒤, brake_ms(0이면 관성 주행) 입력으로 RUN_US 동안 램프를 진행한다. */
+static RampResult_t Run_Ramp(TickMode_t mode, uint16_t brake_ms)
+{
+    RampResult_t res = {0};
+    const int32_t rate = brake_ms ? BRAKE_RATE_PER_S : COAST_RATE_PER_S; // 1000µs당 milli-duty
+    int32_t duty_m = DcMotor_RampStep(0, START_ACCEL_MS, 0, 1000U);
+    const int32_t start_m = duty_m;
+    uint64_t elapsed_us = 0; // MOTOR_DT_MAX_US 제한을 반영한 경과 시간
+    uint32_t now_us = 0;
+
+    res.min_lag_m = INT32_MAX;
+    for (unsigned k = 0; k < sizeof(res.duty_at_10ms) / sizeof(res.duty_at_10ms[0]); k++)
+    {
+        res.duty_at_10ms[k] = -1;
+    }
+    res.duty_at_10ms[0] = duty_m;
+
+    while (now_us < RUN_US)
+    {
+        uint32_t dt_us = Tick_NextDt(mode);
+        now_us += dt_us;
+        duty_m = DcMotor_RampStep(duty_m, 0, brake_ms, dt_us);
+
+        elapsed_us += (dt_us > MOTOR_DT_MAX_US) ? MOTOR_DT_MAX_US : dt_us;
+        res.stalls += (dt_us > MOTOR_DT_MAX_US);
+        res.ticks++;
+
+        int64_t ideal = (int64_t)start_m - (int64_t)rate * (int64_t)elapsed_us / 1000;
+        if (ideal < 0) ideal = 0;
+        int32_t lag = (int32_t)(duty_m - ideal);
+        if (lag > res.max_lag_m) res.max_lag_m = lag;
+        if (lag < res.min_lag_m) res.min_lag_m = lag;
+
+        if (duty_m == 0 && res.zero_us == 0)
+        {
+            res.zero_us = (uint32_t)elapsed_us;
+        }
+        if (now_us % 10000U == 0U && now_us <= RUN_US)
+        {
+            res.duty_at_10ms[now_us / 10000U] = duty_m;
+        }
+    }
+    return res;
+}
+
+/* 1. 관성 주행/브레이크 램프를 틱 방식별로 닫힌 식과 비교하고, 1kHz와 100Hz의 10ms 배수 시각 듀티를 맞춘다. */
+static void Test_RampRates(uint16_t brake_ms)
+{
+    RampResult_t res[TICK_COUNT];
+    const char *name = brake_ms ? "brake" : "coast";
+
+    for (int m = 0; m < TICK_COUNT; m++)
+    {
+        res[m] = Run_Ramp((TickMode_t)m, brake_ms);
+        printf("%s %-15s ticks %7u stalls %3u  lag %d..%d milli-duty  zero at %7.2f ms\n", name, tick_names[m],
+               res[m].ticks, res[m].stalls, res[m].min_lag_m, res[m].max_lag_m, res[m].zero_us / 1000.0);
+
+        HT_CHECK(res[m].min_lag_m >= 0, "%s %s: ramp faster than elapsed time by %d milli-duty",
+                 name, tick_names[m], -res[m].min_lag_m);
+        if (brake_ms || m == TICK_1KHZ || m == TICK_100HZ || m == TICK_STALL)
+        {
+            // 비율 × dt / 1000이 정수로 나누어떨어지는 경우: 절삭 없이 정확해야 한다.
+            HT_CHECK(res[m].max_lag_m == 0, "%s %s: %d milli-duty off the closed form", name, tick_names[m], res[m].max_lag_m);
+        }
+        else
+        {
+            // 틱마다 1 milli-duty 미만 절삭: 누적해도 PWM 1카운트(1000 milli-duty) 미만
+            HT_CHECK(res[m].max_lag_m < (int32_t)res[m].ticks && res[m].max_lag_m < DUTY_SCALE,
+                     "%s %s: lag %d milli-duty over %u ticks", name, tick_names[m], res[m].max_lag_m, res[m].ticks);
+        }
+        HT_CHECK(res[m].zero_us != 0, "%s %s: duty never reached 0", name, tick_names[m]);
+    }
+
+    // 같은 시각의 듀티가 1kHz와 100Hz에서 완전히 같다.
+    int mismatch = 0;
+    for (unsigned k = 0; k < sizeof(res[0].duty_at_10ms) / sizeof(res[0].duty_at_10ms[0]); k++)
+    {
+        mismatch += (res[TICK_1KHZ].duty_at_10ms[k] != res[TICK_100HZ].duty_at_10ms[k]);
+    }
+    HT_CHECK(mismatch == 0, "%s: 1 kHz and 100 Hz differ at %d of the 10 ms points", name, mismatch);
+
+    // 0이 되는 시각: 시작 듀티 / 비율. 1kHz/100Hz는 틱 하나 안에서 같고, 지터 틱은 그 틱의 길이 안에서 같다.
+    uint32_t expect_us = (uint32_t)(((int64_t)res[TICK_1KHZ].duty_at_10ms[0] * 1000 +
+                                     (brake_ms ? BRAKE_RATE_PER_S : COAST_RATE_PER_S) - 1) /
+                                    (brake_ms ? BRAKE_RATE_PER_S : COAST_RATE_PER_S));
+    HT_CHECK(res[TICK_1KHZ].zero_us >= expect_us && res[TICK_1KHZ].zero_us < expect_us + 1000U,
+             "%s 1 kHz: zero at %u us, expected %u", name, res[TICK_1KHZ].zero_us, expect_us);
+    HT_CHECK(res[TICK_100HZ].zero_us >= expect_us && res[TICK_100HZ].zero_us < expect_us + 10000U,
+             "%s 100 Hz: zero at %u us, expected %u", name, res[TICK_100HZ].zero_us, expect_us);
+    HT_CHECK(res[TICK_JITTER_1KHZ].zero_us >= expect_us && res[TICK_JITTER_1KHZ].zero_us < expect_us + 3000U,
+             "%s jitter: zero at %u us, expected %u", name, res[TICK_JITTER_1KHZ].zero_us, expect_us);
+}
+
+/* 2. MOTOR_DT_MAX_US 제한: 긴 틱은 제한값만큼만 반영하고, 최대 dt(시계 역행 등)에서도 넘치지 않는다. */
+static void Test_DtClamp(void)
+{
+    const int32_t full = MAX_DUTY * DUTY_SCALE;
+    const uint32_t dts[] = {MOTOR_DT_MAX_US, MOTOR_DT_MAX_US + 1U, 100000U, 0x7FFFFFFFU, 0xFFFFFFFFU};
+
+    // 32비트 중간값: 비율 × MOTOR_DT_MAX_US가 uint32_t에 들어가야 한다.
+    HT_CHECK((uint64_t)BRAKE_RATE_PER_S * MOTOR_DT_MAX_US <= 0xFFFFFFFFULL, "brake rate x MOTOR_DT_MAX_US overflows");
+    HT_CHECK((uint64_t)COAST_RATE_PER_S * MOTOR_DT_MAX_US <= 0xFFFFFFFFULL, "coast rate x MOTOR_DT_MAX_US overflows");
+
+    for (unsigned k = 0; k < sizeof(dts) / sizeof(dts[0]); k++)
+    {
+        int32_t coast = DcMotor_RampStep(full, 0, 0, dts[k]);
+        int32_t brake = DcMotor_RampStep(full, 0, 1, dts[k]);
+
+        HT_CHECK(coast == full - COAST_RATE_PER_S * (int32_t)MOTOR_DT_MAX_US / 1000,
+                 "coast dt %u: %d", dts[k], coast);
+        HT_CHECK(brake == ((full > BRAKE_RATE_PER_S * (int32_t)(MOTOR_DT_MAX_US / 1000U))
+                               ? full - BRAKE_RATE_PER_S * (int32_t)(MOTOR_DT_MAX_US / 1000U) : 0),
+                 "brake dt %u: %d", dts[k], brake);
+    }
+
+    // 브레이크 10ms는 최대 듀티를 정확히 0으로 만들고, 그보다 짧으면 비례해서 남는다.
+    HT_CHECK(DcMotor_RampStep(full, 0, 1, 10000U) == 0, "brake 10 ms from full");
+    HT_CHECK(DcMotor_RampStep(full, 0, 1, 5000U) == full / 2, "brake 5 ms from full");
+    HT_CHECK(DcMotor_RampStep(0, 0, 0, 1000U) == 0 && DcMotor_RampStep(0, 0, 1, 1000U) == 0, "negative duty");
+    HT_CHECK(DcMotor_RampStep(full, 0, 0, 0U) == full, "dt 0 changes duty");
+}
+
+/* 3. 가속 입력은 dt와 무관하게 버튼 유지 시간으로 듀티를 정한다. (최대 듀티로 제한) */
+static void Test_Accel(void)
+{
+    const uint32_t dts[] = {0U, 1000U, 10000U, MOTOR_DT_MAX_US, 0xFFFFFFFFU};
+
+    for (unsigned k = 0; k < sizeof(dts) / sizeof(dts[0]); k++)
+    {
+        HT_CHECK(DcMotor_RampStep(0, 1, 0, dts[k]) == MIN_DUTY_ON_ACCEL * DUTY_SCALE, "accel 1 ms dt %u", dts[k]);
+        HT_CHECK(DcMotor_RampStep(123456, START_ACCEL_MS, 0, dts[k]) ==
+                     (MIN_DUTY_ON_ACCEL + START_ACCEL_MS * ACCEL_SENSITIVITY_PERMILLE / 1000) * DUTY_SCALE,
+                 "accel %d ms dt %u", START_ACCEL_MS, dts[k]);
+        HT_CHECK(DcMotor_RampStep(0, 0xFFFF, 0, dts[k]) == MAX_DUTY * DUTY_SCALE, "accel saturates dt %u", dts[k]);
+    }
+}
+
+int main(void)
+{
+    Test_RampRates(0);  // 관성 주행
+    Test_RampRates(50); // 브레이크
+    Test_DtClamp();
+    Test_Accel();
+
+    return HT_RESULT();
+}
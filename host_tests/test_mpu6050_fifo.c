@@ -0,0 +1,200 @@
+/**
+ * @file test_mpu6050_fifo.c
+ * @brief MPU6050 FIFO 파서(mpu6050_fifo)를 합성 바이트 스트림으로 검증한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 1kHz로 프레임을 쌓고 5ms마다 최대 MPU6050_FIFO_MAX_BURST 프레임씩 읽는 MPU6050_Read_FIFO의 흐름을 그대로 흉내 내어,
+ * 프레임 정렬, 부호 확장, 불완전 프레임 무시, 누적 합과 데시메이션 평균을 확인한다.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "mpu6050_fifo.h"
+
+#define FIFO_MAX_BURST   32    // mpu6050.h MPU6050_FIFO_MAX_BURST (HAL 헤더를 피하려고 복사)
+#define FIFO_SIZE        1024  // mpu6050.h MPU6050_FIFO_SIZE
+#define DRAIN_PERIOD_MS  5
+#define STREAM_MS        200000
+#define STALL_MS         60    // 가끔 읽기가 밀리는 시간 (60프레임 < FIFO 85프레임)
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t Rand_Next(void)
+{
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void Put_Frame(uint8_t *p, const int16_t v[6])
+{
+    for (int ch = 0; ch < 6; ch++)
+    {
+        p[2 * ch] = (uint8_t)((uint16_t)v[ch] >> 8);
+        p[2 * ch + 1] = (uint8_t)v[ch];
+    }
+}
+
+/* 1. 극값과 부호: -32768, 32767, -1, 0이 그대로 누적되는지 */
+static void Test_Extremes(void)
+{
+    static const int16_t vals[4] = {-32768, 32767, -1, 0};
+    uint8_t buf[FIFO_MAX_BURST * MPU6050_FIFO_FRAME_LEN];
+    int32_t want[6] = {0};
+    MPU6050_FifoAccum_t acc = {0};
+
+    for (int f = 0; f < FIFO_MAX_BURST; f++)
+    {
+        int16_t v[6];
+        for (int ch = 0; ch < 6; ch++)
+        {
+            v[ch] = vals[(f + ch) % 4];
+            want[ch] += v[ch];
+        }
+        Put_Frame(&buf[f * MPU6050_FIFO_FRAME_LEN], v);
+    }
+
+    uint16_t n = MPU6050_FIFO_Parse(buf, sizeof(buf), &acc);
+    HT_CHECK(n == FIFO_MAX_BURST && acc.count == FIFO_MAX_BURST, "extremes: %u frames, count %u", n, acc.count);
+    for (int ch = 0; ch < 6; ch++)
+    {
+        HT_CHECK(acc.sum[ch] == want[ch], "extremes ch%d: %ld != %ld", ch, (long)acc.sum[ch], (long)want[ch]);
+    }
+}
+
+/* 2. 끝의 불완전 프레임은 무시하고, 누적은 이전 호출 값에 더해진다. */
+static void Test_Partial(void)
+{
+    uint8_t buf[3 * MPU6050_FIFO_FRAME_LEN];
+    const int16_t a[6] = {100, -200, 300, -400, 500, -600};
+    MPU6050_FifoAccum_t acc = {0};
+
+    for (int f = 0; f < 3; f++) Put_Frame(&buf[f * MPU6050_FIFO_FRAME_LEN], a);
+
+    for (uint16_t len = 0; len < MPU6050_FIFO_FRAME_LEN; len++)
+    {
+        HT_CHECK(MPU6050_FIFO_Parse(buf, len, &acc) == 0, "partial: %u bytes parsed a frame", len);
+    }
+    HT_CHECK(acc.count == 0 && acc.sum[0] == 0, "partial: accumulator touched");
+
+    HT_CHECK(MPU6050_FIFO_Parse(buf, 2 * MPU6050_FIFO_FRAME_LEN + 11, &acc) == 2, "partial: 35 bytes != 2 frames");
+    HT_CHECK(MPU6050_FIFO_Parse(buf, MPU6050_FIFO_FRAME_LEN, &acc) == 1, "partial: 12 bytes != 1 frame");
+    HT_CHECK(acc.count == 3, "partial: count %u", acc.count);
+    for (int ch = 0; ch < 6; ch++)
+    {
+        HT_CHECK(acc.sum[ch] == 3 * a[ch], "partial ch%d: %ld", ch, (long)acc.sum[ch]);
+    }
+}
+
+/*
+ * 3. 스트림: 1kHz로 프레임을 바이트 FIFO에 쌓고 5ms(±지터, 가끔 60ms 지연)마다 MPU6050_Read_FIFO처럼 읽는다.
+ * 읽은 프레임 순서/합이 생성한 프레임과 같고, 자이로 평균 × 프레임 수가 적분과 프레임 수 이내로 맞는지 확인한다.
+ */
+static void Test_Stream(void)
+{
+    static uint8_t fifo[FIFO_SIZE];
+    static int16_t produced[STREAM_MS][6];
+    uint8_t rx[FIFO_MAX_BURST * MPU6050_FIFO_FRAME_LEN];
+    uint32_t fifo_bytes = 0, prod = 0, cons = 0, drains = 0, max_batch = 0;
+    int64_t gyro_int = 0, gyro_avg_int = 0;
+    uint32_t next_drain = DRAIN_PERIOD_MS;
+    int bad = 0;
+
+    for (uint32_t ms = 0; ms < STREAM_MS; ms++)
+    {
+        // 센서: 1ms마다 한 프레임. 가속도는 느린 램프 + 노이즈, 자이로는 임의 값
+        int16_t v[6];
+        for (int ch = 0; ch < 6; ch++)
+        {
+            v[ch] = (int16_t)((ch < 3) ? (int32_t)((ms * 7 + ch * 5000) % 60000) - 30000 + (int32_t)(Rand_Next() % 64) - 32
+                                       : (int32_t)(Rand_Next() & 0xFFFF) - 32768);
+            produced[ms][ch] = v[ch];
+        }
+        if (fifo_bytes + MPU6050_FIFO_FRAME_LEN > FIFO_SIZE)
+        {
+            HT_CHECK(0, "stream: FIFO overflow at %u ms", ms);
+            break;
+        }
+        Put_Frame(&fifo[fifo_bytes], v);
+        fifo_bytes += MPU6050_FIFO_FRAME_LEN;
+        prod++;
+
+        if (ms + 1 < next_drain) continue;
+        next_drain = ms + 1 + DRAIN_PERIOD_MS - 1 + (Rand_Next() % 3); // 4~6ms 지터
+
+        // 호스트: MPU6050_Read_FIFO와 같은 프레임 수 결정
+        uint16_t frames = (uint16_t)(fifo_bytes / MPU6050_FIFO_FRAME_LEN);
+        if (frames == 0) continue;
+        if (frames > FIFO_MAX_BURST) frames = FIFO_MAX_BURST;
+
+        uint32_t nbytes = (uint32_t)frames * MPU6050_FIFO_FRAME_LEN;
+        memcpy(rx, fifo, nbytes);
+        memmove(fifo, &fifo[nbytes], fifo_bytes - nbytes);
+        fifo_bytes -= nbytes;
+        if (((Rand_Next() % 200) == 0) && (fifo_bytes == 0))
+        {
+            next_drain += STALL_MS; // 태스크 지연: 한 번에 다 못 읽고 다음 주기로 넘어가는 경우
+        }
+
+        MPU6050_FifoAccum_t acc = {0};
+        uint16_t n = MPU6050_FIFO_Parse(rx, (uint16_t)nbytes, &acc);
+        int32_t want[6] = {0};
+
+        for (uint16_t f = 0; f < frames; f++)
+        {
+            for (int ch = 0; ch < 6; ch++) want[ch] += produced[cons + f][ch];
+        }
+        for (int ch = 0; ch < 6; ch++)
+        {
+            if (acc.sum[ch] != want[ch]) bad++;
+        }
+        if ((n != frames) || (acc.count != frames)) bad++;
+
+        gyro_int += want[3];
+        gyro_avg_int += (int64_t)(acc.sum[3] / acc.count) * acc.count; // 필터에 들어가는 평균 × dt
+        cons += frames;
+        drains++;
+        if (frames > max_batch) max_batch = frames;
+    }
+
+    int64_t drift = gyro_int - gyro_avg_int;
+    if (drift < 0) drift = -drift;
+
+    printf("stream: %u frames produced, %u consumed in %u drains (max batch %u), bad %d\n",
+           prod, cons, drains, max_batch, bad);
+    printf("gyro integral |sum - avg*count|: %lld LSB*ms over %u frames\n", (long long)drift, cons);
+    HT_CHECK(bad == 0, "stream: %d mismatched batches", bad);
+    HT_CHECK(prod - cons == fifo_bytes / MPU6050_FIFO_FRAME_LEN, "stream: frames lost");
+    HT_CHECK(max_batch == FIFO_MAX_BURST, "stream: max batch %u != burst limit", max_batch);
+    // 평균의 정수 나눗셈 절삭은 배치마다 프레임 수 미만이다.
+    HT_CHECK((uint64_t)drift < cons, "stream: gyro integral drift %lld", (long long)drift);
+}
+
+int main(void)
+{
+    Test_Extremes();
+    Test_Partial();
+    Test_Stream();
+
+    // 비용: 최대 버스트(32프레임) 한 번을 누적하는 시간
+    static uint8_t buf[FIFO_MAX_BURST * MPU6050_FIFO_FRAME_LEN];
+    for (size_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)Rand_Next();
+
+    enum { ITER = 200000 };
+    volatile int32_t sink = 0;
+    uint64_t t0 = ht_now_ns(), c0 = ht_cycles();
+    for (int i = 0; i < ITER; i++)
+    {
+        MPU6050_FifoAccum_t acc = {0};
+        buf[0] = (uint8_t)i;
+        MPU6050_FIFO_Parse(buf, sizeof(buf), &acc);
+        sink += acc.sum[0];
+    }
+    uint64_t t1 = ht_now_ns(), c1 = ht_cycles();
+    (void)sink;
+
+    printf("host cost per %d-frame burst: %.1f ns (%.0f cycles)\n", FIFO_MAX_BURST,
+           (double)(t1 - t0) / ITER, (double)(c1 - c0) / ITER);
+
+    return HT_RESULT();
+}
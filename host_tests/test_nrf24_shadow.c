@@ -0,0 +1,401 @@
+/**
+ * @file test_nrf24_shadow.c
+ * @brief NRF24.c 레지스터 섀도우의 SPI 트랜잭션 절감과, 칩이 스스로 바꾸는 레지스터를 섀도우에서 읽지 않는지 검증한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 유닛의 NRF24.c와 통신 핸들러를 그대로 빌드하고, 대체 HAL의 SPI/GPIO를 가상 nRF24L01+(nrf24_sim.c)에 연결한다.
+ * 트랜잭션은 CSN Low→High 프레임 하나다. 같은 소스를 두 번 빌드한다.
+ * - test_nrf24_shadow_controller: Unit_controller NRF24.c + comm_handler.c (송신측)
+ * - test_nrf24_shadow_central: Unit_car_central NRF24.c + rf_handler.c (수신측, NRF24_TEST_CENTRAL)
+ * 섀도우 도입 전 동작은 매 읽기-수정-쓰기 호출 직전에 nrf24_shadow_invalidate()를 불러 재현한다.
+ * - 초기화: 섀도우 도입 전의 연쇄 설정 호출과 현재 테이블 초기화의 트랜잭션 수, 결과 레지스터 값이 같은지
+ * - 패킷당 경로: 섀도우 유무와 관계없이 트랜잭션 수가 같고 레지스터 읽기가 없는지
+ * - STATUS, FIFO_STATUS, OBSERVE_TX, RPD: 칩 값을 바꿀 때마다 모든 접근 함수가 칩을 다시 읽는지
+ * - 섀도우 레지스터: 읽기-수정-쓰기 helper가 칩을 읽지 않고도 칩을 읽는 경우와 같은 값을 쓰는지
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#ifdef NRF24_TEST_CENTRAL
+#include "rf_handler.h"
+#include "cmsis_os.h"
+#else
+#include "comm_handler.h"
+#endif
+#include "NRF24.h"
+#include "NRF24_reg_addresses.h"
+#include "host_test.h"
+#include "nrf24_sim.h"
+
+#define PACKETS 200
+
+#ifdef NRF24_TEST_CENTRAL
+#define UNIT_NAME "central"
+osSemaphoreId_t RFSemHandle;
+osThreadId_t RFTaskHandle;
+
+// main.c와 같이 SPI DMA 완료를 RF 핸들러로 넘긴다.
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+    RFHandler_SpiDmaCpltCallback();
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+    RFHandler_SpiDmaCpltCallback();
+}
+
+static void Handler_Init(void)
+{
+    RFHandler_Init();
+}
+#else
+#define UNIT_NAME "controller"
+osMutexId_t g_nrf24MutexHandle = NULL;
+osThreadId_t ackHandlerTaskHandle;
+
+static void Handler_Init(void)
+{
+    CommHandler_Init();
+}
+#endif
+
+// 칩이 스스로 바꾸므로 섀도우에 두면 안 되는 레지스터
+static const uint8_t volatile_regs[] = { STATUS, FIFO_STATUS, OBSERVE_TX, RPD };
+
+// 초기화 결과를 비교할 설정 레지스터
+static const uint8_t config_regs[] = {
+    CONFIG, EN_AA, EN_RXADDR, SETUP_AW, SETUP_RETR, RF_CH, RF_SETUP,
+    RX_ADDR_P0, RX_ADDR_P1, TX_ADDR, RX_PW_P0, RX_PW_P1, DYNPD, FEATURE,
+};
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t Rand_Next(void)
+{
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static uint32_t Sim_RegReads(void)
+{
+    uint32_t n = 0;
+    for (unsigned r = 0; r < NRF24_SIM_REGS; r++)
+    {
+        n += g_nrfSimStats.reg_reads[r];
+    }
+    return n;
+}
+
+// 섀도우 도입 전 라이브러리: 읽기-수정-쓰기 helper가 항상 칩을 먼저 읽는다.
+#define RMW(call) do { nrf24_shadow_invalidate(); call; } while (0)
+
+/* 섀도우 도입 전의 연쇄 설정 호출 (각 유닛의 이전 CommHandler_Init/RFHandler_Init, nrf24_init) */
+static void OldInit(void)
+{
+    static uint8_t addr[5] = {0x45, 0x55, 0x67, 0x10, 0x21};
+
+    csn_high();
+    HAL_Delay(5);
+    ce_low();
+
+    // 이전 nrf24_init(): 섀도우 동기화 없음
+    RMW(nrf24_pwr_up());
+    nrf24_flush_tx();
+    nrf24_flush_rx();
+    nrf24_clear_rx_dr();
+    nrf24_clear_tx_ds();
+    nrf24_clear_max_rt();
+
+#ifndef NRF24_TEST_CENTRAL
+    RMW(nrf24_stop_listen());
+#endif
+    nrf24_auto_ack_all(auto_ack);
+    RMW(nrf24_en_ack_pld(enable));
+    RMW(nrf24_dpl(disable));
+    RMW(nrf24_set_crc(enable, _1byte));
+    RMW(nrf24_tx_pwr(_0dbm));
+    RMW(nrf24_data_rate(_2mbps));
+    nrf24_set_channel(90);
+    nrf24_set_addr_width(5);
+#ifdef NRF24_TEST_CENTRAL
+    RMW(nrf24_open_rx_pipe(1, addr));
+    nrf24_pipe_pld_size(1, 8);
+    RMW(nrf24_listen());
+#else
+    RMW(nrf24_auto_retr_delay(4));
+    RMW(nrf24_auto_retr_limit(10));
+    nrf24_open_tx_pipe(addr);
+    RMW(nrf24_open_rx_pipe(0, addr));
+    nrf24_pipe_pld_size(0, ACK_PAYLOAD_SIZE);
+#endif
+}
+
+static void Snapshot(uint8_t *out)
+{
+    for (unsigned i = 0; i < sizeof(config_regs); i++)
+    {
+        out[i] = NrfSim_GetReg(config_regs[i]);
+    }
+}
+
+/* 1. 초기화: 이전 연쇄 호출 vs 테이블 (전원 인가 직후, MCU만 리셋되어 칩 설정이 남은 경우) */
+static void Test_Init(void)
+{
+    uint8_t old_regs[sizeof(config_regs)], new_regs[sizeof(config_regs)];
+
+    NrfSim_Reset();
+    OldInit();
+    uint32_t old_tr = g_nrfSimStats.transactions, old_rd = Sim_RegReads();
+    Snapshot(old_regs);
+
+    NrfSim_Reset();
+    Handler_Init();
+    uint32_t new_tr = g_nrfSimStats.transactions, new_rd = Sim_RegReads();
+    Snapshot(new_regs);
+
+    // MCU 리셋: 칩 레지스터는 유지된 채 다시 초기화
+    NrfSim_ClearStats();
+    Handler_Init();
+    uint32_t warm_tr = g_nrfSimStats.transactions, warm_rd = Sim_RegReads();
+
+    printf("%-10s init SPI transactions: chained calls %u (%u reads), table %u (%u reads), warm re-init %u (%u reads)\n",
+           UNIT_NAME, old_tr, old_rd, new_tr, new_rd, warm_tr, warm_rd);
+
+    for (unsigned i = 0; i < sizeof(config_regs); i++)
+    {
+        HT_CHECK(old_regs[i] == new_regs[i], "reg 0x%02X: chained 0x%02X table 0x%02X",
+                 config_regs[i], old_regs[i], new_regs[i]);
+    }
+    HT_CHECK(new_tr < old_tr, "table init %u transactions, chained %u", new_tr, old_tr);
+    HT_CHECK(warm_tr <= new_tr, "warm re-init %u > cold %u", warm_tr, new_tr);
+    // 테이블 초기화의 읽기는 nrf24_shadow_sync()의 7개 레지스터뿐이다.
+    HT_CHECK(new_rd == 7 && warm_rd == 7, "init reads: cold %u warm %u (expected 7)", new_rd, warm_rd);
+    HT_CHECK(g_nrfSimStats.stray_bytes == 0, "%u SPI bytes outside CSN", g_nrfSimStats.stray_bytes);
+}
+
+/* 2. 패킷당 경로: 섀도우를 매 패킷 무효화해도 트랜잭션 수가 같고, 레지스터 읽기가 없다. */
+#ifdef NRF24_TEST_CENTRAL
+static uint32_t Run_Packets(bool invalidate, uint32_t *max_tr)
+{
+    uint32_t total = 0;
+
+    NrfSim_Reset();
+    Handler_Init();
+    *max_tr = 0;
+
+    for (int i = 0; i < PACKETS; i++)
+    {
+        uint8_t pkt[8] = {1};
+        uint8_t ack[3] = {(uint8_t)i, 0x34, 0x12};
+        VehicleCommand_t cmd;
+
+        pkt[3] = (uint8_t)i;
+        pkt[7] = (uint8_t)(i & 1);
+        RFHandler_SetAckPayload(ack, sizeof(ack));
+        NrfSim_RxPush(1, pkt, sizeof(pkt));
+        if (invalidate)
+        {
+            nrf24_shadow_invalidate();
+        }
+
+        NrfSim_ClearStats();
+        bool ok = RFHandler_GetNewCommand(&cmd);
+        uint32_t tr = g_nrfSimStats.transactions;
+
+        HT_CHECK(ok && cmd.accel_ms == (uint16_t)i && cmd.direction == (i & 1), "packet %d not parsed", i);
+        HT_CHECK(Sim_RegReads() == 0, "packet %d: %u register reads", i, Sim_RegReads());
+        HT_CHECK(NrfSim_RxCount() == 0 && !(NrfSim_GetReg(STATUS) & (1 << RX_DR)), "packet %d: RX not drained", i);
+
+        uint8_t sent[32];
+        HT_CHECK(NrfSim_TxPop(sent) == sizeof(ack) && memcmp(sent, ack, sizeof(ack)) == 0, "packet %d: ACK payload", i);
+
+        // FIFO가 빈 뒤의 호출은 명령 바이트 한 번으로 끝난다.
+        NrfSim_ClearStats();
+        HT_CHECK(!RFHandler_GetNewCommand(&cmd), "packet %d: empty FIFO returned a command", i);
+        HT_CHECK(g_nrfSimStats.transactions == 1, "packet %d: empty check %u transactions", i, g_nrfSimStats.transactions);
+
+        total += tr;
+        if (tr > *max_tr) *max_tr = tr;
+    }
+    return total;
+}
+#else
+static uint32_t Run_Packets(bool invalidate, uint32_t *max_tr)
+{
+    uint32_t total = 0;
+
+    NrfSim_Reset();
+    Handler_Init();
+    *max_tr = 0;
+
+    for (int i = 0; i < PACKETS; i++)
+    {
+        uint8_t pkt[PAYLOAD_SIZE] = {1, 0, 0, (uint8_t)i};
+        uint8_t ack[ACK_PAYLOAD_SIZE] = {(uint8_t)i, 0x34, 0x12};
+        uint8_t ack_rx[ACK_PAYLOAD_SIZE] = {0};
+        bool lost = (i % 10 == 9); // 10번째마다 MAX_RT
+        CommStatus_t expected = lost ? COMM_TX_FAIL : COMM_TX_ACK_PAYLOAD;
+
+        if (invalidate)
+        {
+            nrf24_shadow_invalidate();
+        }
+
+        // 무선 구간: 성공이면 ACK 페이로드와 TX_DS, 실패면 재전송 소진 후 MAX_RT (패킷은 FIFO에 남음)
+        NrfSim_SetLink(lost ? 1000 : 0, ack, sizeof(ack));
+
+        NrfSim_ClearStats();
+        HT_CHECK(CommHandler_Transmit(pkt, PAYLOAD_SIZE) == COMM_OK, "packet %d: transmit busy", i);
+        HT_CHECK(g_nrfSimStats.ce_pulses == 1, "packet %d: %u CE pulses", i, g_nrfSimStats.ce_pulses);
+        HT_CHECK(NrfSim_RunUntilIrq(COMM_IRQ_TIMEOUT_MS * 1000U), "packet %d: no IRQ", i);
+
+        uint8_t sent[32];
+        HT_CHECK(lost || (NrfSim_LastDelivered(sent) == PAYLOAD_SIZE && sent[3] == (uint8_t)i), "packet %d: payload", i);
+
+        CommStatus_t st = CommHandler_CheckStatus(ack_rx, sizeof(ack_rx));
+        uint32_t tr = g_nrfSimStats.transactions;
+
+        HT_CHECK(st == expected, "packet %d: status %d expected %d", i, st, expected);
+        HT_CHECK(lost || memcmp(ack_rx, ack, sizeof(ack)) == 0, "packet %d: ACK payload", i);
+        HT_CHECK(Sim_RegReads() == 0, "packet %d: %u register reads", i, Sim_RegReads());
+        HT_CHECK((NrfSim_GetReg(STATUS) & ((1 << TX_DS) | (1 << MAX_RT) | (1 << RX_DR))) == 0 &&
+                 NrfSim_TxCount() == 0, "packet %d: flags/FIFO not cleared", i);
+        // 송신 2 (STATUS NOP, W_TX_PAYLOAD) + 상태 확인 2 (R_RX_PAYLOAD, STATUS 클리어) + MAX_RT 시 FLUSH_TX
+        HT_CHECK(tr == (lost ? 5u : 4u), "packet %d: %u transactions", i, tr);
+
+        total += tr;
+        if (tr > *max_tr) *max_tr = tr;
+    }
+    return total;
+}
+#endif
+
+static void Test_PerPacket(void)
+{
+    uint32_t max_shadow, max_plain;
+    uint32_t with_shadow = Run_Packets(false, &max_shadow);
+    uint32_t without_shadow = Run_Packets(true, &max_plain);
+
+    printf("%-10s per-packet SPI transactions (%d packets): shadow %.2f avg / %u max, invalidated %.2f avg / %u max\n",
+           UNIT_NAME, PACKETS, (double)with_shadow / PACKETS, max_shadow, (double)without_shadow / PACKETS, max_plain);
+    HT_CHECK(with_shadow == without_shadow, "per-packet path depends on the shadow: %u vs %u", with_shadow, without_shadow);
+}
+
+/* 3. STATUS, FIFO_STATUS, OBSERVE_TX, RPD: 칩 값을 바꿀 때마다 모든 접근 함수가 칩을 다시 읽는다. */
+static void Test_VolatileRegs(void)
+{
+    NrfSim_Reset();
+    Handler_Init();
+    while (NrfSim_TxPop(NULL) != 0) {}
+
+    for (int i = 0; i < 1000; i++)
+    {
+        uint8_t obs = (uint8_t)Rand_Next();
+        uint8_t pkt[8] = {0};
+
+        // 칩 쪽 변화: 재전송 카운터, 반송파 검출, RX FIFO 점유, 인터럽트 플래그
+        NrfSim_SetReg(OBSERVE_TX, obs);
+        NrfSim_SetReg(RPD, (uint8_t)(Rand_Next() & 1));
+        if ((Rand_Next() & 1) && NrfSim_RxCount() < 3)
+        {
+            NrfSim_RxPush((uint8_t)(Rand_Next() % 6), pkt, sizeof(pkt));
+        }
+        else if (NrfSim_RxCount() != 0)
+        {
+            csn_low();
+            nrf24_w_spec_cmd(R_RX_PAYLOAD);
+            nrf24_r_spec_reg(pkt, sizeof(pkt));
+            csn_high();
+        }
+        NrfSim_SetIrqFlags((uint8_t)(Rand_Next() & ((1 << RX_DR) | (1 << TX_DS) | (1 << MAX_RT))));
+
+        for (unsigned v = 0; v < sizeof(volatile_regs); v++)
+        {
+            uint8_t reg = volatile_regs[v];
+            uint8_t chip = NrfSim_GetReg(reg);
+            uint8_t bit = (uint8_t)(Rand_Next() % 8);
+            uint32_t reads = g_nrfSimStats.reg_reads[reg];
+
+            HT_CHECK(nrf24_r_reg(reg, 1) == chip, "reg 0x%02X: read stale value", reg);
+            HT_CHECK(nrf24_read_bit(reg, bit) == ((chip >> bit) & 1), "reg 0x%02X bit %u: stale", reg, bit);
+
+            // set_bit의 읽기-수정-쓰기도 칩을 읽어야 한다. (STATUS에 쓰면 해당 플래그가 클리어됨)
+            nrf24_set_bit(reg, bit, 1);
+            HT_CHECK(g_nrfSimStats.reg_reads[reg] == reads + 3, "reg 0x%02X: %u chip reads for 3 accesses",
+                     reg, g_nrfSimStats.reg_reads[reg] - reads);
+        }
+
+        uint8_t status = NrfSim_GetReg(STATUS);
+        HT_CHECK(nrf24_r_status() == status && nrf24_last_status() == status, "STATUS: stale value");
+        HT_CHECK(nrf24_data_available() == (NrfSim_RxCount() != 0), "FIFO_STATUS: stale RX_EMPTY");
+        HT_CHECK(nrf24_carrier_detect() == NrfSim_GetReg(RPD), "RPD: stale value");
+    }
+}
+
+/* 4. 섀도우 레지스터: 임의의 helper 호출 순서를 칩 읽기 없이 수행한 결과가 매번 칩을 읽는 경우와 같다. */
+static void Run_Helpers(bool invalidate, uint32_t seed, uint8_t *regs_out, uint32_t *reads)
+{
+    rng_state = seed;
+    NrfSim_Reset();
+    Handler_Init();
+    NrfSim_ClearStats();
+
+    for (int i = 0; i < 2000; i++)
+    {
+        uint32_t r = Rand_Next();
+        uint8_t a = (uint8_t)((r >> 8) % 6), b = (uint8_t)((r >> 16) & 1);
+
+        if (invalidate)
+        {
+            nrf24_shadow_invalidate();
+        }
+        switch (r % 12)
+        {
+        case 0:  if (b) nrf24_pwr_up(); else nrf24_pwr_dwn(); break;
+        case 1:  nrf24_tx_pwr((uint8_t)(a & 3)); break;
+        case 2:  nrf24_data_rate((uint8_t)(a % 3)); break;
+        case 3:  nrf24_set_crc(b, (uint8_t)(a & 1)); break;
+        case 4:  nrf24_auto_ack(a, b); break;
+        case 5:  nrf24_set_rx_dpl(a, b); break;
+        case 6:  nrf24_dpl(b); break;
+        case 7:  nrf24_en_ack_pld(b); break;
+        case 8:  nrf24_en_dyn_ack(b); break;
+        case 9:  if (b) nrf24_auto_retr_delay(a); else nrf24_auto_retr_limit(a); break;
+        case 10: if (b) nrf24_cls_rx_pipe(a); else nrf24_set_bit(EN_RXADDR, a, 1); break;
+        default: if (b) nrf24_listen(); else nrf24_stop_listen(); break;
+        }
+    }
+    Snapshot(regs_out);
+    *reads = Sim_RegReads();
+}
+
+static void Test_ShadowCoherent(void)
+{
+    uint8_t shadow_regs[sizeof(config_regs)], chip_regs[sizeof(config_regs)];
+    uint32_t shadow_reads, chip_reads;
+
+    Run_Helpers(false, 12345u, shadow_regs, &shadow_reads);
+    Run_Helpers(true, 12345u, chip_regs, &chip_reads);
+
+    printf("%-10s 2000 read-modify-write helper calls: %u chip reads with shadow, %u without\n",
+           UNIT_NAME, shadow_reads, chip_reads);
+    HT_CHECK(shadow_reads == 0, "helpers read the chip %u times", shadow_reads);
+    for (unsigned i = 0; i < sizeof(config_regs); i++)
+    {
+        HT_CHECK(shadow_regs[i] == chip_regs[i], "reg 0x%02X: shadow path 0x%02X, chip path 0x%02X",
+                 config_regs[i], shadow_regs[i], chip_regs[i]);
+    }
+}
+
+int main(void)
+{
+    Test_Init();
+    Test_PerPacket();
+    Test_VolatileRegs();
+    Test_ShadowCoherent();
+
+    return HT_RESULT();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_nrf24_tx_rate.c
+ * @brief 조종기 송신 경로의 최대 패킷 속도를 이전 블로킹 송신(nrf24_transmit)과 비동기 송신(CommHandler_Transmit)으로 비교한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note Unit_controller의 NRF24.c와 comm_handler.c를 그대로 빌드하고, 가상 nRF24L01+(nrf24_sim.c)의 무선 구간 모델로
+ * CE 펄스 → 송신(2Mbps, 8바이트) → ACK 페이로드(3바이트) 또는 재전송(ARD 1250µs, ARC 10) → IRQ 핀을 재현한다.
+ * SPI는 9Mbit/s + HAL 호출당 2µs, HAL_Delay(1)은 실제 HAL처럼 다음 틱 경계 + 1ms(1~2ms)를 기다린다.
+ * 두 경로 모두 이전 패킷의 결과를 처리한 직후 다음 패킷을 보내는 포화 상태에서 2초(가상 시간)씩 돌린다.
+ * - 블로킹: commTask가 nrf24_transmit()(CE High + HAL_Delay(1) + STATUS 확인)에 묶이고, 반환 후 IRQ가 있으면 상태를 확인
+ * - 비동기: CommHandler_Transmit()(약 10µs CE 펄스) 후 ackHandlerTask가 IRQ를 기다려 CommHandler_CheckStatus() 호출
+ * 시도당 손실률 0%, 10%, 30%에서 초당 전달 패킷 수와 송신 호출 1회당 commTask 점유 시간을 출력하고,
+ * 비동기 경로가 수백 패킷/초(≥ 300)를 넘고 블로킹 경로보다 빠른지, 송신 호출이 100µs 안에 끝나는지 확인한다.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "comm_handler.h"
+#include "NRF24.h"
+#include "NRF24_reg_addresses.h"
+#include "host_test.h"
+#include "nrf24_sim.h"
+
+#define RUN_US 2000000U
+
+osMutexId_t g_nrf24MutexHandle = NULL;
+osThreadId_t ackHandlerTaskHandle;
+
+typedef struct {
+    uint32_t calls;         // 송신 함수 호출 수
+    uint32_t delivered;     // 수신측에 도착한 패킷 수
+    uint32_t lost;          // 재전송 소진 패킷 수
+    uint32_t ack_payloads;  // 읽어 온 ACK 페이로드 수
+    uint64_t call_ns;       // 송신 함수 안에서 보낸 시간 합
+    uint64_t call_max_ns;
+} RateResult_t;
+
+static void Rate_Start(uint16_t loss_permille)
+{
+    static const uint8_t ack[ACK_PAYLOAD_SIZE] = {0, 0x34, 0x12};
+
+    NrfSim_Reset();
+    CommHandler_Init();
+    NrfSim_SetLink(loss_permille, ack, sizeof(ack));
+    NrfSim_ClearStats();
+}
+
+static void Rate_Call(RateResult_t *r, uint64_t t0)
+{
+    uint64_t dt = NrfSim_Nanos() - t0;
+
+    r->calls++;
+    r->call_ns += dt;
+    if (dt > r->call_max_ns) r->call_max_ns = dt;
+}
+
+static void Rate_Finish(RateResult_t *r)
+{
+    r->delivered = g_nrfSimStats.air_delivered;
+    r->lost = g_nrfSimStats.air_lost;
+}
+
+/* 이전 경로: commTask가 블로킹 nrf24_transmit()을 호출하고, 반환 후 IRQ가 남아 있으면 ackHandlerTask가 상태를 확인한다. */
+static void Run_Blocking(uint16_t loss_permille, RateResult_t *r)
+{
+    uint8_t pkt[PAYLOAD_SIZE] = {1};
+    uint8_t ack_rx[ACK_PAYLOAD_SIZE];
+
+    memset(r, 0, sizeof(*r));
+    Rate_Start(loss_permille);
+    uint64_t end = NrfSim_Nanos() + (uint64_t)RUN_US * 1000U;
+
+    while (NrfSim_Nanos() < end)
+    {
+        pkt[3]++;
+        uint64_t t0 = NrfSim_Nanos();
+        (void)nrf24_transmit(pkt, PAYLOAD_SIZE);
+        Rate_Call(r, t0);
+
+        if (NrfSim_Irq() && CommHandler_CheckStatus(ack_rx, sizeof(ack_rx)) == COMM_TX_ACK_PAYLOAD)
+        {
+            r->ack_payloads++;
+        }
+    }
+    Rate_Finish(r);
+}
+
+/* 현재 경로: 비동기 송신 후 IRQ(또는 COMM_IRQ_TIMEOUT_MS)까지 기다려 상태를 확인하고 다음 패킷을 보낸다. */
+static void Run_Async(uint16_t loss_permille, RateResult_t *r)
+{
+    uint8_t pkt[PAYLOAD_SIZE] = {1};
+    uint8_t ack_rx[ACK_PAYLOAD_SIZE];
+
+    memset(r, 0, sizeof(*r));
+    Rate_Start(loss_permille);
+    uint64_t end = NrfSim_Nanos() + (uint64_t)RUN_US * 1000U;
+
+    while (NrfSim_Nanos() < end)
+    {
+        pkt[3]++;
+        uint64_t t0 = NrfSim_Nanos();
+        CommStatus_t st = CommHandler_Transmit(pkt, PAYLOAD_SIZE);
+        Rate_Call(r, t0);
+        HT_CHECK(st == COMM_OK, "async transmit returned %d", st);
+
+        (void)NrfSim_RunUntilIrq(COMM_IRQ_TIMEOUT_MS * 1000U);
+        if (CommHandler_CheckStatus(ack_rx, sizeof(ack_rx)) == COMM_TX_ACK_PAYLOAD)
+        {
+            r->ack_payloads++;
+        }
+    }
+    Rate_Finish(r);
+}
+
+static double Rate_PerSecond(const RateResult_t *r)
+{
+    return (double)r->delivered * 1e6 / RUN_US;
+}
+
+static void Print(const char *name, uint16_t loss_permille, const RateResult_t *r)
+{
+    printf("loss %4.1f%% %-8s: %7.1f packets/s delivered (%u lost), %6.1f us avg / %6.1f us max in transmit call, "
+           "commTask busy %5.1f%%\n",
+           loss_permille / 10.0, name, Rate_PerSecond(r), r->lost,
+           (double)r->call_ns / r->calls / 1000.0, r->call_max_ns / 1000.0,
+           100.0 * (double)r->call_ns / ((double)RUN_US * 1000.0));
+}
+
+int main(void)
+{
+    static const uint16_t losses[] = {0, 100, 300};
+
+    for (unsigned i = 0; i < sizeof(losses) / sizeof(losses[0]); i++)
+    {
+        RateResult_t blocking, async;
+
+        Run_Blocking(losses[i], &blocking);
+        Run_Async(losses[i], &async);
+        Print("blocking", losses[i], &blocking);
+        Print("async", losses[i], &async);
+
+        HT_CHECK(Rate_PerSecond(&async) > Rate_PerSecond(&blocking), "loss %u: async %.1f/s <= blocking %.1f/s",
+                 losses[i], Rate_PerSecond(&async), Rate_PerSecond(&blocking));
+        HT_CHECK(Rate_PerSecond(&async) >= 300.0, "loss %u: async %.1f packets/s", losses[i], Rate_PerSecond(&async));
+        HT_CHECK(async.call_max_ns < 100000U, "loss %u: async transmit call %.1f us", losses[i], async.call_max_ns / 1000.0);
+        HT_CHECK(blocking.call_ns / blocking.calls >= 1000000U, "loss %u: blocking call shorter than 1 ms", losses[i]);
+        HT_CHECK(async.ack_payloads == async.delivered, "loss %u: %u ACK payloads for %u packets",
+                 losses[i], async.ack_payloads, async.delivered);
+    }
+
+    return HT_RESULT();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file test_odometry.c
+ * @brief 16비트 엔코더 카운터 확장과 주행 거리 적산(odometry)의 랩어라운드 처리를 검증한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 참값(64비트 정수)을 따로 적산하면서 16비트로 잘린 카운터만 Odometry_Update에 넣는다.
+ * - 호출 간 변화량 ±32767 경계값과 0xFFFF ↔ 0x0000 양방향 통과
+ * - int32 범위를 넘는 누적 위치 (한 방향으로 오래 주행)
+ * - 틱 → mm, RPM → mm/s 변환의 반올림 오차와 단조성
+ * - CAN ODOMETRY 프레임의 32비트 travel_mm가 랩어라운드해도 수신측 차분이 맞는지
+ */
+
+#include <math.h>
+#include "host_test.h"
+#include "odometry.h"
+#include "rpm_calc.h"
+
+#define TICKS_PER_REV (RPM_TICKS_PER_REV_X10 / 10.0)
+
+static uint32_t rng_state = 88172645u;
+
+static uint32_t Rand_Next(void)
+{
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/* 1. 임의 보행: 경계값(±32767)과 작은 값이 섞인 변화량으로 카운터를 양방향으로 여러 번 랩어라운드시킨다. */
+static void Test_RandomWalk(void)
+{
+    static const int32_t edge_steps[] = {32767, -32767, 1, -1, 0, 2, 30000, -30000};
+    Odometry_t od;
+    uint16_t raw = 65500; // 시작 직후 0xFFFF → 0x0000 통과
+    int64_t truth = 0;
+    uint64_t travel = 0;
+    int bad = 0, wraps = 0;
+
+    Odometry_Init(&od, raw);
+    for (int i = 0; i < 200000; i++)
+    {
+        int32_t d = (i % 4 == 0) ? edge_steps[(i / 4) % 8] : (int32_t)(Rand_Next() % 65535) - 32767;
+        uint16_t next = (uint16_t)(raw + d);
+
+        if ((d > 0 && next < raw) || (d < 0 && next > raw)) wraps++;
+        raw = next;
+        truth += d;
+        travel += (uint64_t)((d < 0) ? -d : d);
+
+        int16_t ret = Odometry_Update(&od, raw);
+        if (ret != d || od.position_ticks != truth || od.travel_ticks != travel) bad++;
+    }
+    printf("random walk: 200000 updates, %d counter wraps, bad %d\n", wraps, bad);
+    HT_CHECK(bad == 0, "random walk: %d mismatches", bad);
+    HT_CHECK(wraps > 1000, "random walk did not wrap (%d)", wraps);
+}
+
+/* 2. 한 방향 장거리: 누적 위치가 int32/uint32 범위를 넘어도 손실이 없는지 */
+static void Test_LongRun(void)
+{
+    Odometry_t od;
+    uint16_t raw = 0;
+    int64_t truth = 0;
+
+    Odometry_Init(&od, raw);
+    for (int i = 0; i < 300000; i++) // 300000 × 32767 ≈ 9.8e9틱 (2^33 이상)
+    {
+        raw = (uint16_t)(raw + 32767);
+        truth += 32767;
+        Odometry_Update(&od, raw);
+    }
+    printf("long run: position %lld ticks (%.1f km)\n", (long long)od.position_ticks,
+           Odometry_TicksToMm(od.position_ticks) / 1e6);
+    HT_CHECK(od.position_ticks == truth && (int64_t)od.travel_ticks == truth, "long run: %lld != %lld",
+             (long long)od.position_ticks, (long long)truth);
+
+    // 후진으로 되돌아오기
+    for (int i = 0; i < 300000; i++)
+    {
+        raw = (uint16_t)(raw - 32767);
+        Odometry_Update(&od, raw);
+    }
+    HT_CHECK(od.position_ticks == 0 && (int64_t)od.travel_ticks == 2 * truth, "return: pos %lld travel %llu",
+             (long long)od.position_ticks, (unsigned long long)od.travel_ticks);
+}
+
+/* 3. 단위 변환: double 기준과 반올림 오차 0.5 이내, 이동량 mm는 틱에 대해 단조 증가 */
+static void Test_Conversions(void)
+{
+    double max_mm_err = 0.0, max_speed_err = 0.0;
+    int64_t prev_mm = -1;
+    int non_monotonic = 0;
+
+    for (int64_t ticks = -2000000; ticks <= 2000000; ticks += 7)
+    {
+        int64_t mm = Odometry_TicksToMm(ticks);
+        double ref = ticks / TICKS_PER_REV * (ODOM_WHEEL_CIRC_UM / 1000.0);
+        double e = fabs(mm - ref);
+
+        if (e > max_mm_err) max_mm_err = e;
+        if (ticks >= 0)
+        {
+            if (mm < prev_mm) non_monotonic++;
+            prev_mm = mm;
+        }
+    }
+    for (int64_t ticks = (int64_t)1 << 40; ticks < ((int64_t)1 << 40) + 100000; ticks += 13) // 먼 거리에서도 오버플로 없음
+    {
+        double e = fabs(Odometry_TicksToMm(ticks) - ticks / TICKS_PER_REV * (ODOM_WHEEL_CIRC_UM / 1000.0));
+        if (e > max_mm_err) max_mm_err = e;
+    }
+    for (int32_t rpm_x10 = -3000; rpm_x10 <= 3000; rpm_x10++)
+    {
+        double ref = rpm_x10 / 10.0 * (ODOM_WHEEL_CIRC_UM / 1000.0) / 60.0;
+        double e = fabs(Odometry_RpmX10ToMmPerS(rpm_x10) - ref);
+        if (e > max_speed_err) max_speed_err = e;
+    }
+
+    printf("conversion max error: %.3f mm, %.3f mm/s\n", max_mm_err, max_speed_err);
+    HT_CHECK(max_mm_err <= 0.5 + 1e-6, "ticks to mm error %.3f", max_mm_err);
+    HT_CHECK(max_speed_err <= 0.5 + 1e-6, "rpm to mm/s error %.3f", max_speed_err);
+    HT_CHECK(non_monotonic == 0, "travel mm not monotonic (%d)", non_monotonic);
+    HT_CHECK(Odometry_TicksToMm(-681) == -Odometry_TicksToMm(681), "rounding not symmetric");
+}
+
+/* 4. CAN travel_mm(uint32) 랩어라운드: 송신측 (uint32_t) 절삭 후에도 수신측 차분은 실제 이동량과 같다. */
+static void Test_CanTravelWrap(void)
+{
+    uint64_t travel_ticks = (uint64_t)(4294967296.0 / (ODOM_WHEEL_CIRC_UM / 1000.0) * TICKS_PER_REV) - 200000;
+    uint32_t prev = (uint32_t)Odometry_TicksToMm((int64_t)travel_ticks);
+    int64_t prev_true = Odometry_TicksToMm((int64_t)travel_ticks);
+    int bad = 0, wrapped = 0;
+
+    for (int i = 0; i < 1000; i++) // 한 번에 약 1m씩, 도중에 2^32 mm 통과
+    {
+        travel_ticks += 3338;
+        int64_t true_mm = Odometry_TicksToMm((int64_t)travel_ticks);
+        uint32_t sent = (uint32_t)true_mm; // MotorEncoder_GetTravelMm
+        uint32_t delta = sent - prev;      // 수신측 차분
+
+        if (sent < prev) wrapped = 1;
+        if ((int64_t)delta != true_mm - prev_true) bad++;
+        prev = sent;
+        prev_true = true_mm;
+    }
+    HT_CHECK(wrapped, "travel_mm did not wrap");
+    HT_CHECK(bad == 0, "travel_mm delta wrong across wrap (%d)", bad);
+}
+
+int main(void)
+{
+    Test_RandomWalk();
+    Test_LongRun();
+    Test_Conversions();
+    Test_CanTravelWrap();
+    return HT_RESULT();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file test_rpm_calc.c
+ * @brief 엔코더 엣지 타임스탬프 기반 M/T RPM 추정(rpm_calc)의 정확도를 합성 엔코더 신호로 측정한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 일정 속도로 도는 4체배 엔코더를 1µs 간격으로 흉내 내고, A상 상승 엣지마다 카운트와
+ * 72MHz 타임스탬프(±2µs 지터)를 캡처해 10ms마다 RpmCalc_Update를 호출한다.
+ * 카운트(16비트)와 타임스탬프(32비트)가 시험 중에 랩어라운드하도록 시작값을 둔다.
+ * 비교용으로 10ms 창의 카운트 차이로 구하는 기존 방식의 오차도 함께 출력한다.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "rpm_calc.h"
+
+#define CLK_HZ        72000000U
+#define TICKS_PER_REV (RPM_TICKS_PER_REV_X10 / 10.0)
+#define UPDATE_S      0.01   // 센서 태스크 갱신 주기
+#define STEP_S        1e-6
+#define RUN_S         3.0
+#define SETTLE_S      1.0    // 이 시간 이후의 추정값만 평가
+#define CYCLE_OFFSET  (0xFFFFFFFFU - 72000000U) // 시작 1초 뒤 타임스탬프 랩어라운드
+#define COUNT_OFFSET  32000  // 시작 직후 int16 카운트 랩어라운드 (정방향)
+
+typedef struct
+{
+    double mean_err, max_err, window_max_err;
+    int32_t final_rpm_x10;
+    double stop_ms; // 정지 후 0이 될 때까지 걸린 시간 (ms). 마지막 엣지 기준 타임아웃 + 갱신 주기 이내
+} RunResult_t;
+
+/* 속도 rpm으로 RUN_S 동안 돌린 뒤 정지시켜 정지 판단 시간까지 잰다. */
+static RunResult_t Run(double rpm, uint32_t seed)
+{
+    RunResult_t res = {0};
+    RpmCalc_t st;
+    double tps = rpm / 60.0 * TICKS_PER_REV;
+    double pos = COUNT_OFFSET;
+    uint32_t seq = 0, edge_cycles = 0;
+    int16_t edge_count = 0, prev_window_count = (int16_t)COUNT_OFFSET;
+    int last_a = 0, n = 0;
+    double err_sum = 0.0, next_update = UPDATE_S, stop_t = -1.0;
+
+    srand(seed);
+    RpmCalc_Init(&st, CLK_HZ);
+
+    for (double t = 0.0; t < RUN_S + 1.0; t += STEP_S)
+    {
+        if (t < RUN_S) pos += tps * STEP_S; // RUN_S 이후 정지
+
+        long cnt = (long)floor(pos);
+        int a = (((cnt % 4) + 4) % 4) >= 2; // 4체배 카운트 2, 3에서 A상 High
+        uint32_t now = CYCLE_OFFSET + (uint32_t)(t * CLK_HZ);
+
+        if (a && !last_a)
+        {
+            seq++;
+            edge_count = (int16_t)cnt;
+            edge_cycles = now + (uint32_t)(rand() % 144); // 캡처 지연 0~2µs
+        }
+        last_a = a;
+
+        if (t < next_update) continue;
+        next_update += UPDATE_S;
+
+        int32_t r = RpmCalc_Update(&st, seq, edge_count, edge_cycles, now);
+        int16_t window_count = (int16_t)cnt;
+        double window_rpm = (int16_t)(window_count - prev_window_count) / TICKS_PER_REV * 60.0 / UPDATE_S;
+        prev_window_count = window_count;
+
+        if (t > SETTLE_S && t < RUN_S)
+        {
+            double e = fabs(r / 10.0 - rpm);
+            double we = fabs(window_rpm - rpm);
+            err_sum += e;
+            n++;
+            if (e > res.max_err) res.max_err = e;
+            if (we > res.window_max_err) res.window_max_err = we;
+            res.final_rpm_x10 = r;
+        }
+        if (t >= RUN_S && r == 0 && stop_t < 0.0)
+        {
+            stop_t = t;
+        }
+    }
+    res.mean_err = err_sum / n;
+    res.stop_ms = (stop_t < 0.0) ? -1.0 : (stop_t - RUN_S) * 1000.0;
+    return res;
+}
+
+int main(void)
+{
+    static const double speeds[] = {1.5, 3, 5, 10, 30, 100, 250, -2, -50, -250};
+
+    printf("   rpm   mean|err|  max|err|  10ms window max|err|  stop(ms)\n");
+    for (unsigned k = 0; k < sizeof(speeds) / sizeof(speeds[0]); k++)
+    {
+        RunResult_t r = Run(speeds[k], 1000 + k);
+
+        printf("%6.1f  %8.3f  %8.3f  %18.3f  %8.0f\n", speeds[k], r.mean_err, r.max_err, r.window_max_err, r.stop_ms);
+        HT_CHECK(r.max_err <= 0.1, "%.1f rpm: max error %.3f rpm", speeds[k], r.max_err);
+        HT_CHECK(r.stop_ms >= 0.0 && r.stop_ms <= RPM_ZERO_TIMEOUT_MS + 2 * UPDATE_S * 1000,
+                 "%.1f rpm: stop not detected within %d ms (%.0f)", speeds[k], RPM_ZERO_TIMEOUT_MS, r.stop_ms);
+    }
+
+    // 변환 함수 단독: 부호, 반올림, 0 주기
+    HT_CHECK(RpmCalc_TicksToRpmX10(0, 1000, CLK_HZ) == 0, "zero ticks");
+    HT_CHECK(RpmCalc_TicksToRpmX10(100, 0, CLK_HZ) == 0, "zero cycles");
+    HT_CHECK(RpmCalc_TicksToRpmX10(6816, CLK_HZ * 6U, CLK_HZ) == 1000, "10 rev in 6 s: %ld",
+             (long)RpmCalc_TicksToRpmX10(6816, CLK_HZ * 6U, CLK_HZ));
+    HT_CHECK(RpmCalc_TicksToRpmX10(-6816, CLK_HZ * 6U, CLK_HZ) == -1000, "reverse sign");
+    HT_CHECK(RpmCalc_TicksToRpmX10(1, CLK_HZ * 2U, CLK_HZ) == 0, "rounding below 0.05 rpm");
+    // 16비트 카운트 최대 변화량을 10ms에: 분자가 32비트를 넘어도 정확해야 한다.
+    double big = 32767 / TICKS_PER_REV * 60.0 / 0.01 * 10.0;
+    HT_CHECK(fabs(RpmCalc_TicksToRpmX10(32767, CLK_HZ / 100U, CLK_HZ) - big) <= 0.5, "large ticks: %ld vs %.1f",
+             (long)RpmCalc_TicksToRpmX10(32767, CLK_HZ / 100U, CLK_HZ), big);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,283 @@
+/**
+ * @file test_speed_pid.c
+ * @brief 중앙 ECU 속도 제어 루프(speed_pid)를 DC 모터 플랜트 모델과 센서 ECU 송신 정책으로 폐루프 시뮬레이션한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 펌웨어와 같은 경로를 1ms 주기로 흉내 낸다.
+ * - 중앙 ECU: 1ms마다 SpeedPid_LoopStep으로 듀티를 계산해 플랜트에 인가한다. (MotorTask)
+ * - 플랜트: 데드존(회전 시작 듀티)과 이득, 시정수를 갖는 1차 DC 모터. 부하/배터리 전압에 따라 피드포워드 모델과 다르다.
+ * - 센서 ECU: 10ms마다 직전 10ms 평균 RPM(±0.1 RPM 노이즈)을 정수로 반올림하고,
+ *   CanPublish_Evaluate(can_publish.c)가 송신하기로 한 샘플만 다음 1ms 주기에 중앙 ECU에 도착한다.
+ *   따라서 측정 간격은 변화 중 20ms, 정속 중 50ms(하트비트)로 불규칙하다.
+ * 계단 목표(0 → 100 → 200 → 120 RPM)마다 오버슈트와 ±5% 정착 시간, 정상 상태 오차를 재고,
+ * 피드포워드만 쓰는 개루프의 정상 상태 오차를 비교로 출력한다.
+ * 이전 게인(KP 2000, KI 8000, 적분 대역 없음)은 같은 시뮬레이션에서 오버슈트 최대 24%, 정착 최대 955ms였다.
+ */
+
+#include <math.h>
+#include "host_test.h"
+#include "speed_pid.h"
+#include "can_publish.h"
+
+#define LOOP_US        1000U  // MotorTask 주기
+#define SENSOR_MS      10U    // 센서 ECU CAN 태스크 주기
+#define STEP_MS        2000U  // 계단 하나를 유지하는 시간
+#define SETTLE_BAND    0.05   // 정착 판정 대역 (목표의 ±5%)
+#define SETTLE_MIN_RPM 3.0    // 정착 대역 최소폭 (송신 데드밴드 2 RPM + 정수 반올림)
+
+#define OVERSHOOT_MAX  0.20   // 허용 오버슈트 (계단 크기 대비). 피드포워드가 20% 센 플랜트에서 첫 측정 전까지 넘어서는 분량
+#define OVERSHOOT_NOMINAL_MAX 0.05 // 피드포워드 모델과 같은 플랜트의 허용 오버슈트
+#define SETTLE_MAX_MS  500U   // 허용 정착 시간
+#define SS_ERR_MAX     2.0    // 허용 정상 상태 평균 오차 (RPM, 계단 마지막 500ms)
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t Rand_Next(void)
+{
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/**
+ * @brief 1차 DC 모터 모델: 정상 상태 RPM = gain × max(0, 듀티 - deadzone), 시정수 tau
+ */
+typedef struct {
+    const char *name;
+    double gain;      // RPM / 듀티
+    double deadzone;  // 회전 시작 듀티
+    double tau_ms;    // 기계적 시정수
+} Plant_t;
+
+static const Plant_t plants[] = {
+    {"nominal",      0.50, 400.0, 150.0}, // 피드포워드 모델과 같음 (MIN_DUTY_ON_ACCEL, MOTOR_MAX_RPM)
+    {"heavy load",   0.45, 480.0, 250.0}, // 마찰 증가 + 관성 증가
+    {"low battery",  0.40, 400.0, 150.0}, // 전압 20% 강하
+    {"high battery", 0.60, 350.0, 100.0}, // 완충, 가벼운 차체
+};
+
+static const uint16_t step_accel_ms[] = {250, 500, 300}; // 목표 100, 200, 120 RPM
+#define STEP_COUNT (sizeof(step_accel_ms) / sizeof(step_accel_ms[0]))
+
+typedef struct {
+    double overshoot;    // 계단 크기 대비 최대 초과 비율
+    uint32_t settle_ms;  // 마지막으로 대역을 벗어난 시각 + 1주기 (계단 시작 기준)
+    double ss_err;       // 마지막 500ms 평균 |오차|
+} StepResult_t;
+
+typedef struct {
+    StepResult_t step[STEP_COUNT];
+    uint32_t meas_count;
+    uint32_t meas_dt_min_ms, meas_dt_max_ms;
+    double meas_dt_mean_ms;
+} SimResult_t;
+
+/* 속도 제어(closed=true) 또는 피드포워드만(closed=false)으로 계단 목표를 차례로 시뮬레이션한다. */
+static SimResult_t Simulate(const Plant_t *plant, bool closed)
+{
+    SimResult_t res = {0};
+    SpeedPidLoop_t loop;
+    CanPublish_t pub;
+    CanDb_SensorStatus_t msg = {0};
+    double rpm = 0.0, window_sum = 0.0, prev_target = 0.0;
+    int32_t duty_m = 0;
+    uint32_t window_n = 0, sensor_phase = Rand_Next() % SENSOR_MS;
+    bool pending = false;
+    uint16_t pending_rpm = 0;
+    uint32_t last_meas_ms = 0, dt_sum = 0;
+
+    SpeedPid_LoopInit(&loop);
+    CanPublish_Init(&pub);
+    msg.front_valid = 1;
+    msg.rear_valid = 1;
+    res.meas_dt_min_ms = UINT32_MAX;
+
+    for (unsigned s = 0; s < STEP_COUNT; s++)
+    {
+        StepResult_t *st = &res.step[s];
+        uint16_t accel_ms = step_accel_ms[s];
+        double target = SpeedPid_TargetFromAccel(accel_ms) / 1000.0;
+        double step = target - prev_target;
+        double band = fmax(target * SETTLE_BAND, SETTLE_MIN_RPM);
+        double err_sum = 0.0;
+        uint32_t err_n = 0;
+
+        for (uint32_t k = 0; k < STEP_MS; k++)
+        {
+            uint32_t now_ms = s * STEP_MS + k;
+
+            // 중앙 ECU: 직전 주기에 송신된 측정값이 이번 주기에 메일박스에서 꺼내진다.
+            if (closed)
+            {
+                duty_m = SpeedPid_LoopStep(&loop, duty_m, accel_ms, 0, false, pending, pending_rpm,
+                                           (now_ms == 0) ? 0 : LOOP_US, now_ms * 1000U);
+            }
+            else
+            {
+                duty_m = SpeedPid_FeedForward((int32_t)target);
+            }
+            if (pending)
+            {
+                uint32_t dt = now_ms - last_meas_ms;
+                if (res.meas_count > 0)
+                {
+                    if (dt < res.meas_dt_min_ms) res.meas_dt_min_ms = dt;
+                    if (dt > res.meas_dt_max_ms) res.meas_dt_max_ms = dt;
+                    dt_sum += dt;
+                }
+                res.meas_count++;
+                last_meas_ms = now_ms;
+                pending = false;
+            }
+
+            // 플랜트: 1ms 동안 듀티 고정, 1차 지연의 정확한 이산화
+            double duty = duty_m / (double)DUTY_SCALE;
+            double rpm_ss = plant->gain * fmax(0.0, duty - plant->deadzone);
+            rpm += (rpm_ss - rpm) * (1.0 - exp(-1.0 / plant->tau_ms));
+            window_sum += rpm;
+            window_n++;
+
+            // 센서 ECU: 10ms 평균 RPM을 0.1 RPM 단위로 추정하고, 송신 정책을 거쳐 다음 주기에 도착한다.
+            if (now_ms % SENSOR_MS == sensor_phase)
+            {
+                double noise = ((double)(Rand_Next() % 201) - 100.0) / 1000.0;
+                int32_t rpm_x10 = (int32_t)lround((window_sum / window_n + noise) * 10.0);
+                window_sum = 0.0;
+                window_n = 0;
+
+                msg.motor_rpm = (int16_t)((rpm_x10 + ((rpm_x10 >= 0) ? 5 : -5)) / 10);
+                if (CanPublish_Evaluate(&pub, &msg, now_ms) != CAN_PUB_NONE)
+                {
+                    pending = true;
+                    pending_rpm = (uint16_t)((msg.motor_rpm < 0) ? -msg.motor_rpm : msg.motor_rpm);
+                }
+            }
+
+            // 평가 (실제 회전 속도 기준)
+            double over = (step >= 0.0) ? (rpm - target) / step : (target - rpm) / -step;
+            if (over > st->overshoot) st->overshoot = over;
+            if (fabs(rpm - target) > band) st->settle_ms = k + 1;
+            if (k >= STEP_MS - 500U)
+            {
+                err_sum += fabs(rpm - target);
+                err_n++;
+            }
+        }
+        st->ss_err = err_sum / err_n;
+        prev_target = target;
+    }
+
+    if (res.meas_count > 1)
+    {
+        res.meas_dt_mean_ms = (double)dt_sum / (res.meas_count - 1);
+    }
+    return res;
+}
+
+static void Test_Plant(const Plant_t *plant)
+{
+    SimResult_t pid = Simulate(plant, true);
+    SimResult_t ff = Simulate(plant, false);
+
+    printf("%-12s  meas interval %u..%u ms (mean %.1f, %u frames)\n", plant->name,
+           pid.meas_dt_min_ms, pid.meas_dt_max_ms, pid.meas_dt_mean_ms, pid.meas_count);
+    for (unsigned s = 0; s < STEP_COUNT; s++)
+    {
+        int32_t target = SpeedPid_TargetFromAccel(step_accel_ms[s]) / 1000;
+        const StepResult_t *st = &pid.step[s];
+
+        printf("  -> %3d rpm  PID: overshoot %5.1f%%  settle %4u ms  ss err %5.2f rpm | feed-forward only: ss err %6.2f rpm\n",
+               target, st->overshoot * 100.0, st->settle_ms, st->ss_err, ff.step[s].ss_err);
+        HT_CHECK(st->overshoot <= ((plant == &plants[0]) ? OVERSHOOT_NOMINAL_MAX : OVERSHOOT_MAX),
+                 "%s -> %d rpm: overshoot %.1f%%", plant->name, target, st->overshoot * 100.0);
+        HT_CHECK(st->settle_ms <= SETTLE_MAX_MS, "%s -> %d rpm: settling %u ms", plant->name, target, st->settle_ms);
+        HT_CHECK(st->ss_err <= SS_ERR_MAX, "%s -> %d rpm: steady-state error %.2f rpm", plant->name, target, st->ss_err);
+    }
+
+    // 측정 간격은 송신 정책이 정한다: 최소 간격(20ms) 이상, 회전 중 하트비트(50ms) + 센서 주기 이하
+    HT_CHECK(pid.meas_dt_min_ms >= CAN_PUB_MIN_INTERVAL_MS, "%s: measurement interval %u ms", plant->name, pid.meas_dt_min_ms);
+    HT_CHECK(pid.meas_dt_max_ms <= CAN_PUB_ACTIVE_HEARTBEAT_MS + SENSOR_MS, "%s: measurement gap %u ms",
+             plant->name, pid.meas_dt_max_ms);
+}
+
+/* 목표가 플랜트 최대 속도보다 높아 출력이 포화된 뒤 목표를 낮춰도, 적분 와인드업 없이 정착 시간 안에 따라간다. */
+static void Test_Saturation(void)
+{
+    const Plant_t *plant = &plants[2]; // low battery: 최대 240 RPM
+    SpeedPidLoop_t loop;
+    double rpm = 0.0;
+    int32_t duty_m = 0;
+    uint32_t settle_ms = 0;
+
+    SpeedPid_LoopInit(&loop);
+    for (uint32_t now_ms = 0; now_ms < 4000; now_ms++)
+    {
+        uint16_t accel_ms = (now_ms < 2000) ? 750 : 400; // 300 RPM(도달 불가) → 160 RPM
+        bool meas = (now_ms % CAN_PUB_MIN_INTERVAL_MS) == 0U;
+
+        duty_m = SpeedPid_LoopStep(&loop, duty_m, accel_ms, 0, false, meas, (uint16_t)lround(rpm),
+                                   LOOP_US, now_ms * 1000U);
+        if (now_ms == 1999)
+        {
+            HT_CHECK(duty_m == MAX_DUTY * DUTY_SCALE, "saturated duty %d", duty_m);
+            HT_CHECK(loop.pid.integral_m == 0, "integral wound up to %d while saturated", loop.pid.integral_m);
+        }
+        rpm += (plant->gain * fmax(0.0, duty_m / (double)DUTY_SCALE - plant->deadzone) - rpm) * (1.0 - exp(-1.0 / plant->tau_ms));
+        if (now_ms >= 2000 && fabs(rpm - 160.0) > 160.0 * SETTLE_BAND)
+        {
+            settle_ms = now_ms + 1 - 2000;
+        }
+    }
+    printf("saturation 300 -> 160 rpm (max 240): settle %u ms, rpm %.1f\n", settle_ms, rpm);
+    HT_CHECK(settle_ms <= SETTLE_MAX_MS, "after saturation: settling %u ms", settle_ms);
+    HT_CHECK(fabs(rpm - 160.0) <= SS_ERR_MAX, "after saturation: %.1f rpm", rpm);
+}
+
+/* 측정이 SPEED_RPM_TIMEOUT_MS 이상 끊기면 피드포워드로 구동하고, 브레이크/차단은 적분을 비운다. */
+static void Test_Fallbacks(void)
+{
+    SpeedPidLoop_t loop;
+    int32_t duty_m = 0;
+    uint32_t now_us = 0;
+
+    SpeedPid_LoopInit(&loop);
+    for (int k = 0; k < 200; k++, now_us += LOOP_US)
+    {
+        duty_m = SpeedPid_LoopStep(&loop, duty_m, 500, 0, false, (k % 20) == 0, 200 - SPEED_I_BAND_RPM / 2, LOOP_US, now_us);
+    }
+    HT_CHECK(loop.pid.integral_m > 0, "integral should grow below target");
+
+    // 오차가 SPEED_I_BAND_RPM보다 크면 적분을 멈춘다.
+    int32_t integral_m = loop.pid.integral_m;
+    duty_m = SpeedPid_LoopStep(&loop, duty_m, 500, 0, false, true, 200 - SPEED_I_BAND_RPM - 1, LOOP_US, now_us);
+    now_us += LOOP_US;
+    HT_CHECK(loop.pid.integral_m == integral_m, "integral changed outside the band: %d -> %d", integral_m, loop.pid.integral_m);
+
+    // 측정 끊김: SPEED_RPM_TIMEOUT_MS까지는 마지막 듀티 유지, 이후 피드포워드
+    for (uint32_t k = 0; k <= SPEED_RPM_TIMEOUT_MS + 1U; k++, now_us += LOOP_US)
+    {
+        duty_m = SpeedPid_LoopStep(&loop, duty_m, 500, 0, false, false, 0, LOOP_US, now_us);
+    }
+    HT_CHECK(duty_m == SpeedPid_FeedForward(200), "stale measurement: duty %d, feed-forward %d", duty_m, SpeedPid_FeedForward(200));
+    HT_CHECK(loop.pid.integral_m == 0, "stale measurement: integral %d", loop.pid.integral_m);
+
+    // 차단: 듀티 0, 목표 0
+    duty_m = SpeedPid_LoopStep(&loop, duty_m, 500, 0, true, true, 150, LOOP_US, now_us);
+    HT_CHECK(duty_m == 0 && loop.target_rpm_m == 0, "blocked: duty %d target %d", duty_m, loop.target_rpm_m);
+
+    // 브레이크: 개루프와 같은 램프
+    duty_m = 800000;
+    duty_m = SpeedPid_LoopStep(&loop, duty_m, 0, 100, false, true, 150, LOOP_US, now_us + LOOP_US);
+    HT_CHECK(duty_m == DcMotor_RampStep(800000, 0, 100, LOOP_US), "brake ramp %d", duty_m);
+}
+
+int main(void)
+{
+    for (unsigned p = 0; p < sizeof(plants) / sizeof(plants[0]); p++)
+    {
+        Test_Plant(&plants[p]);
+    }
+    Test_Saturation();
+    Test_Fallbacks();
+
+    return HT_RESULT();
+}
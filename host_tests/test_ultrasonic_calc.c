@@ -0,0 +1,74 @@
+/**
+ * @file test_ultrasonic_calc.c
+ * @brief 초음파 에코 → 거리 정수 변환(ultrasonic_calc)을 double 기준식과 비교한다.
+ * @author YeonsuJ
+ * @date 2026-10-17
+ * @note 기온 -40.0 ~ 60.0°C(0.1°C 간격) × 펄스 폭 0 ~ 65535µs 전 범위를 모두 계산한다.
+ * - 음속: |c_x10 - 10 × (331.3 + 0.606·T)| ≤ 0.5 (0.1 m/s 반올림)
+ * - 거리: 정수 음속 기준 반올림이 정확하고, 기준식과의 차이가 반올림 0.5mm + 음속 반올림 전파분 이내
+ * - 폭/기온에 대해 단조 증가, 32비트 중간값과 16비트 결과가 넘치지 않는지
+ */
+
+#include <math.h>
+#include "host_test.h"
+#include "ultrasonic_calc.h"
+
+#define TEMP_MIN_X10  (-400)
+#define TEMP_MAX_X10  600
+#define HC_SR04_MAX_US 23200 // 4m 왕복
+
+int main(void)
+{
+    double speed_err = 0.0, dist_err = 0.0, dist_err_4m = 0.0;
+    long bad_round = 0, bad_bound = 0, bad_mono = 0;
+    uint16_t prev_c = 0;
+
+    for (int t = TEMP_MIN_X10; t <= TEMP_MAX_X10; t++)
+    {
+        double c_ref = 331.3 + 0.606 * (t / 10.0); // m/s
+        uint16_t c_x10 = UltrasonicCalc_SoundSpeedX10((int16_t)t);
+        double e = fabs(c_x10 - c_ref * 10.0);
+
+        if (e > speed_err) speed_err = e;
+        if (t > TEMP_MIN_X10 && c_x10 < prev_c) bad_mono++;
+        prev_c = c_x10;
+
+        uint16_t prev_mm = 0;
+        for (uint32_t w = 0; w <= 0xFFFFu; w++)
+        {
+            uint16_t mm = UltrasonicCalc_EchoToMm((uint16_t)w, (int16_t)t);
+            double exact = (double)w * c_x10 / 20000.0;   // 정수 음속 기준 참값
+            double ref = (double)w * c_ref / 2000.0;        // 기준식 (mm)
+            double d = fabs(mm - ref);
+
+            // 반올림: |mm - exact| ≤ 0.5 (동률은 올림)
+            if (fabs(mm - exact) > 0.5 || (exact - floor(exact) == 0.5 && mm != (uint32_t)exact + 1)) bad_round++;
+            // 기준식 오차: 반올림 0.5mm + 음속 반올림(≤ 0.05 m/s)의 전파분
+            if (d > 0.5 + w * 0.05 / 2000.0 + 1e-9) bad_bound++;
+            if (d > dist_err) dist_err = d;
+            if (w <= HC_SR04_MAX_US && d > dist_err_4m) dist_err_4m = d;
+            if (mm < prev_mm) bad_mono++;
+            prev_mm = mm;
+        }
+    }
+
+    printf("sound speed max |err| %.3f x0.1 m/s, distance max |err| %.3f mm (<= 4 m: %.3f mm)\n",
+           speed_err, dist_err, dist_err_4m);
+    HT_CHECK(speed_err <= 0.5 + 1e-9, "sound speed error %.3f > 0.5 (x0.1 m/s)", speed_err);
+    HT_CHECK(bad_round == 0, "%ld distances not rounded from integer speed", bad_round);
+    HT_CHECK(bad_bound == 0, "%ld distances outside reference bound", bad_bound);
+    HT_CHECK(bad_mono == 0, "%ld non-monotonic results", bad_mono);
+    HT_CHECK(dist_err_4m <= 1.1, "distance error within 4 m %.3f mm > 1.1 mm", dist_err_4m);
+
+    // 최대 입력(65535µs, 60°C)에서 32비트 중간값과 16비트 결과
+    uint16_t c_max = UltrasonicCalc_SoundSpeedX10(TEMP_MAX_X10);
+    uint16_t mm_max = UltrasonicCalc_EchoToMm(0xFFFFu, TEMP_MAX_X10);
+    HT_CHECK((uint64_t)0xFFFFu * c_max + 10000U <= UINT32_MAX, "intermediate overflows 32 bits");
+    HT_CHECK(mm_max == (uint16_t)llround(65535.0 * c_max / 20000.0), "max input %u mm", mm_max);
+
+    // 20.0°C, 5800µs ≈ 1 m (343.4 m/s)
+    HT_CHECK(UltrasonicCalc_SoundSpeedX10(200) == 3434, "c(20C) = %u", UltrasonicCalc_SoundSpeedX10(200));
+    HT_CHECK(UltrasonicCalc_EchoToMm(5800, 200) == 996, "5800us @20C = %u mm", UltrasonicCalc_EchoToMm(5800, 200));
+
+    return HT_RESULT();
+}